@@ -2698,24 +2698,24 @@ void QtSLiMWindow::displayProfileResults(void)
 		}
 		
 		
-		int64_t regime_tallies[3];
+		int64_t regime_tallies[4];
 		int64_t regime_tallies_total = static_cast<int>(sim->profile_nonneutral_regime_history_.size());
 		
-		for (int regime = 0; regime < 3; ++regime)
+		for (int regime = 0; regime < 4; ++regime)
 			regime_tallies[regime] = 0;
 		
 		for (int32_t regime : sim->profile_nonneutral_regime_history_)
-			if ((regime >= 1) && (regime <= 3))
+			if ((regime >= 1) && (regime <= 4))
 				regime_tallies[regime - 1]++;
 			else
 				regime_tallies_total--;
 		
 		tc.insertText(" \n", optima13_d);
 		
-		for (int regime = 0; regime < 3; ++regime)
+		for (int regime = 0; regime < 4; ++regime)
 		{
 			tc.insertText(QString("%1%").arg((regime_tallies[regime] / static_cast<double>(regime_tallies_total)) * 100.0, 6, 'f', 2), menlo11_d);
-			tc.insertText(QString(" of generations : regime %1 (%2)\n").arg(regime + 1).arg(regime == 0 ? "no fitness callbacks" : (regime == 1 ? "constant neutral fitness callbacks only" : "unpredictable fitness callbacks present")), optima13_d);
+			tc.insertText(QString(" of generations : regime %1 (%2)\n").arg(regime + 1).arg(regime == 0 ? "no fitness callbacks" : (regime == 1 ? "constant neutral fitness callbacks only" : (regime == 2 ? "unpredictable fitness callbacks present" : "well-behaved fitness callbacks only"))), optima13_d);
 		}
 		
 		
@@ -1934,24 +1934,24 @@
 		}
 		
 		
-		int64_t regime_tallies[3];
+		int64_t regime_tallies[4];
 		int64_t regime_tallies_total = (int)sim->profile_nonneutral_regime_history_.size();
 		
-		for (int regime = 0; regime < 3; ++regime)
+		for (int regime = 0; regime < 4; ++regime)
 			regime_tallies[regime] = 0;
 		
 		for (int32_t regime : sim->profile_nonneutral_regime_history_)
-			if ((regime >= 1) && (regime <= 3))
+			if ((regime >= 1) && (regime <= 4))
 				regime_tallies[regime - 1]++;
 			else
 				regime_tallies_total--;
 		
 		[content eidosAppendString:@"\n" attributes:optima13_d];
 		
-		for (int regime = 0; regime < 3; ++regime)
+		for (int regime = 0; regime < 4; ++regime)
 		{
 			[content eidosAppendString:[NSString stringWithFormat:@"%6.2f%%", (regime_tallies[regime] / (double)regime_tallies_total) * 100.0] attributes:menlo11_d];
-			[content eidosAppendString:[NSString stringWithFormat:@" of generations : regime %d (%@)\n", regime + 1, (regime == 0 ? @"no fitness callbacks" : (regime == 1 ? @"constant neutral fitness callbacks only" : @"unpredictable fitness callbacks present"))] attributes:optima13_d];
+			[content eidosAppendString:[NSString stringWithFormat:@" of generations : regime %d (%@)\n", regime + 1, (regime == 0 ? @"no fitness callbacks" : (regime == 1 ? @"constant neutral fitness callbacks only" : (regime == 2 ? @"unpredictable fitness callbacks present" : @"well-behaved fitness callbacks only")))] attributes:optima13_d];
 		}
 		
 		
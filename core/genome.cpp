@@ -27,6 +27,7 @@
 #include "subpopulation.h"
 
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -1306,6 +1307,69 @@ EidosValue_SP Genome::ExecuteMethod_sumOfMutationsOfType(EidosGlobalStringID p_m
 	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(selcoeff_sum));
 }
 
+int64_t Genome::UnsharedMutationCount(Genome *p_genome1, Genome *p_genome2, bool p_windowed, slim_position_t p_start, slim_position_t p_end, bool p_infinite_sites)
+{
+	// Walk the two genomes run by run; a null genome has no runs, and so contributes no mutations.  Within a run we
+	// merge by position, and at each position count the mutations present in one genome but not the other.
+	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	int mutrun_count = std::max(p_genome1->mutrun_count_, p_genome2->mutrun_count_);
+	slim_position_t mutrun_length = (p_genome1->IsNull() ? p_genome2->mutrun_length_ : p_genome1->mutrun_length_);
+	int64_t unshared_count = 0;
+	
+	for (int run_index = 0; run_index < mutrun_count; ++run_index)
+	{
+		if (p_windowed && ((run_index * mutrun_length > p_end) || ((run_index + 1) * mutrun_length - 1 < p_start)))
+			continue;
+		
+		MutationRun *mutrun1 = (run_index < p_genome1->mutrun_count_) ? p_genome1->mutruns_[run_index].get() : nullptr;
+		MutationRun *mutrun2 = (run_index < p_genome2->mutrun_count_) ? p_genome2->mutruns_[run_index].get() : nullptr;
+		
+		if (mutrun1 == mutrun2)
+			continue;	// a shared run has no unshared mutations
+		
+		const MutationIndex *genome1_iter = mutrun1 ? mutrun1->begin_pointer_const() : nullptr;
+		const MutationIndex *genome1_max = mutrun1 ? mutrun1->end_pointer_const() : nullptr;
+		const MutationIndex *genome2_iter = mutrun2 ? mutrun2->begin_pointer_const() : nullptr;
+		const MutationIndex *genome2_max = mutrun2 ? mutrun2->end_pointer_const() : nullptr;
+		
+		while ((genome1_iter != genome1_max) || (genome2_iter != genome2_max))
+		{
+			slim_position_t position1 = (genome1_iter != genome1_max) ? (mut_block_ptr + *genome1_iter)->position_ : std::numeric_limits<slim_position_t>::max();
+			slim_position_t position2 = (genome2_iter != genome2_max) ? (mut_block_ptr + *genome2_iter)->position_ : std::numeric_limits<slim_position_t>::max();
+			slim_position_t position = std::min(position1, position2);
+			const MutationIndex *genome1_position_end = genome1_iter;
+			const MutationIndex *genome2_position_end = genome2_iter;
+			
+			while ((genome1_position_end != genome1_max) && ((mut_block_ptr + *genome1_position_end)->position_ == position))
+				genome1_position_end++;
+			while ((genome2_position_end != genome2_max) && ((mut_block_ptr + *genome2_position_end)->position_ == position))
+				genome2_position_end++;
+			
+			if (!p_windowed || ((position >= p_start) && (position <= p_end)))
+			{
+				int64_t unshared_at_position = 0;
+				
+				for (const MutationIndex *scan = genome1_iter; scan != genome1_position_end; ++scan)
+					if (std::find(genome2_iter, genome2_position_end, *scan) == genome2_position_end)
+						unshared_at_position++;
+				for (const MutationIndex *scan = genome2_iter; scan != genome2_position_end; ++scan)
+					if (std::find(genome1_iter, genome1_position_end, *scan) == genome1_position_end)
+						unshared_at_position++;
+				
+				if (p_infinite_sites)
+					unshared_count += unshared_at_position;
+				else if (unshared_at_position)
+					unshared_count++;
+			}
+			
+			genome1_iter = genome1_position_end;
+			genome2_iter = genome2_position_end;
+		}
+	}
+	
+	return unshared_count;
+}
+
 // print the sample represented by genomes, using SLiM's own format
 void Genome::PrintGenomes_SLiM(std::ostream &p_out, std::vector<Genome *> &p_genomes, slim_objectid_t p_source_subpop_id)
 {
@@ -373,6 +373,10 @@ public:
 	// print the sample represented by genomes, using "vcf" format
 	static void PrintGenomes_VCF(std::ostream &p_out, std::vector<Genome *> &p_genomes, bool p_output_multiallelics, bool p_simplify_nucs, bool p_output_nonnucs, bool p_nucleotide_based, NucleotideArray *p_ancestral_seq);
 	
+	// count the mutations present in one genome but not the other, optionally within [p_start, p_end]; with p_infinite_sites
+	// false, positions with any such mutations are counted instead.  This is the back end for calcPairHeterozygosity().
+	static int64_t UnsharedMutationCount(Genome *p_genome1, Genome *p_genome2, bool p_windowed, slim_position_t p_start, slim_position_t p_end, bool p_infinite_sites);
+	
 	// Memory usage tallying, for outputUsage()
 	size_t MemoryUsageForMutrunBuffers(void);
 	
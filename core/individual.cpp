@@ -1270,6 +1270,55 @@ EidosValue_SP Individual::ExecuteMethod_relatedness(EidosGlobalStringID p_method
 	return gStaticEidosValueNULL;
 }
 
+double Individual::SumOfMutationsOfType(MutationType *p_mutation_type)
+{
+	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	Genome *genome1 = genome1_;
+	Genome *genome2 = genome2_;
+	double selcoeff_sum = 0.0;
+	
+	if (!genome1->IsNull())
+	{
+		int mutrun_count = genome1->mutrun_count_;
+		
+		for (int run_index = 0; run_index < mutrun_count; ++run_index)
+		{
+			MutationRun *mutrun = genome1->mutruns_[run_index].get();
+			int genome1_count = mutrun->size();
+			const MutationIndex *genome1_ptr = mutrun->begin_pointer_const();
+			
+			for (int mut_index = 0; mut_index < genome1_count; ++mut_index)
+			{
+				Mutation *mut_ptr = mut_block_ptr + genome1_ptr[mut_index];
+				
+				if (mut_ptr->mutation_type_ptr_ == p_mutation_type)
+					selcoeff_sum += mut_ptr->selection_coeff_;
+			}
+		}
+	}
+	if (!genome2->IsNull())
+	{
+		int mutrun_count = genome2->mutrun_count_;
+		
+		for (int run_index = 0; run_index < mutrun_count; ++run_index)
+		{
+			MutationRun *mutrun = genome2->mutruns_[run_index].get();
+			int genome2_count = mutrun->size();
+			const MutationIndex *genome2_ptr = mutrun->begin_pointer_const();
+			
+			for (int mut_index = 0; mut_index < genome2_count; ++mut_index)
+			{
+				Mutation *mut_ptr = mut_block_ptr + genome2_ptr[mut_index];
+				
+				if (mut_ptr->mutation_type_ptr_ == p_mutation_type)
+					selcoeff_sum += mut_ptr->selection_coeff_;
+			}
+		}
+	}
+	
+	return selcoeff_sum;
+}
+
 //	*********************	- (integer$)sumOfMutationsOfType(io<MutationType>$ mutType)
 //
 EidosValue_SP Individual::ExecuteMethod_Accelerated_sumOfMutationsOfType(EidosObject **p_elements, size_t p_elements_size, EidosGlobalStringID p_method_id, const std::vector<EidosValue_SP> &p_arguments, EidosInterpreter &p_interpreter)
@@ -1284,56 +1333,13 @@ EidosValue_SP Individual::ExecuteMethod_Accelerated_sumOfMutationsOfType(EidosOb
 	MutationType *mutation_type_ptr = SLiM_ExtractMutationTypeFromEidosValue_io(mutType_value, 0, sim, "sumOfMutationsOfType()");
 	
 	// Count the number of mutations of the given type
-	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
 	EidosValue_Float_vector *float_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(p_elements_size);
 	
 	for (size_t element_index = 0; element_index < p_elements_size; ++element_index)
 	{
 		Individual *element = (Individual *)(p_elements[element_index]);
-		Genome *genome1 = element->genome1_;
-		Genome *genome2 = element->genome2_;
-		double selcoeff_sum = 0.0;
-		
-		if (!genome1->IsNull())
-		{
-			int mutrun_count = genome1->mutrun_count_;
-			
-			for (int run_index = 0; run_index < mutrun_count; ++run_index)
-			{
-				MutationRun *mutrun = genome1->mutruns_[run_index].get();
-				int genome1_count = mutrun->size();
-				const MutationIndex *genome1_ptr = mutrun->begin_pointer_const();
-				
-				for (int mut_index = 0; mut_index < genome1_count; ++mut_index)
-				{
-					Mutation *mut_ptr = mut_block_ptr + genome1_ptr[mut_index];
-					
-					if (mut_ptr->mutation_type_ptr_ == mutation_type_ptr)
-						selcoeff_sum += mut_ptr->selection_coeff_;
-				}
-			}
-		}
-		if (!genome2->IsNull())
-		{
-			int mutrun_count = genome2->mutrun_count_;
-			
-			for (int run_index = 0; run_index < mutrun_count; ++run_index)
-			{
-				MutationRun *mutrun = genome2->mutruns_[run_index].get();
-				int genome2_count = mutrun->size();
-				const MutationIndex *genome2_ptr = mutrun->begin_pointer_const();
-				
-				for (int mut_index = 0; mut_index < genome2_count; ++mut_index)
-				{
-					Mutation *mut_ptr = mut_block_ptr + genome2_ptr[mut_index];
-					
-					if (mut_ptr->mutation_type_ptr_ == mutation_type_ptr)
-						selcoeff_sum += mut_ptr->selection_coeff_;
-				}
-			}
-		}
 		
-		float_result->set_float_no_check(selcoeff_sum, element_index);
+		float_result->set_float_no_check(element->SumOfMutationsOfType(mutation_type_ptr), element_index);
 	}
 	
 	return EidosValue_SP(float_result);
@@ -188,6 +188,9 @@ public:
 		// just for parallel design, no parentage to revoke
 	}
 	
+	// The sum of the selection coefficients of the mutations of the given type in both genomes; used by sumOfMutationsOfType() and calcVA()
+	double SumOfMutationsOfType(MutationType *p_mutation_type);
+	
 	// Relatedness using pedigree data.  Most clients will use RelatednessToIndividual(); _Relatedness() is internal API made public for unit testing.
 	double RelatednessToIndividual(Individual &p_ind);
 	static double _Relatedness(slim_pedigreeid_t A, slim_pedigreeid_t A_P1, slim_pedigreeid_t A_P2, slim_pedigreeid_t A_G1, slim_pedigreeid_t A_G2, slim_pedigreeid_t A_G3, slim_pedigreeid_t A_G4,
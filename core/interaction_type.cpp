@@ -29,6 +29,7 @@
 #include <utility>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 
 // stream output for enumerations
@@ -123,6 +124,7 @@ void InteractionType::EvaluateSubpopulation(Subpopulation *p_subpop, bool p_imme
 		}
 		
 		subpop_data->kd_root_ = nullptr;
+		subpop_data->FreeCellGrid();
 		
 		subpop_data->evaluation_interaction_callbacks_.clear();
 	}
@@ -479,6 +481,9 @@ void InteractionType::Invalidate(void)
 		if (data.dist_str_)
 			data.dist_str_->Reset();
 		
+		if (data.streamed_row_)
+			data.streamed_row_->Reset();
+		
 		if (data.kd_nodes_)
 		{
 			free(data.kd_nodes_);
@@ -486,6 +491,7 @@ void InteractionType::Invalidate(void)
 		}
 		
 		data.kd_root_ = nullptr;
+		data.FreeCellGrid();
 		
 		data.evaluation_interaction_callbacks_.clear();
 	}
@@ -503,16 +509,16 @@ void InteractionType::CalculateAllDistances(Subpopulation *p_subpop)
 		
 		if (spatiality_ > 0)
 		{
-			// Here we use the k-d tree to find all interacting pairs, and calculate their distances.
-			// This does not use reciprocality at all, but I don't think there's a good way to do so, so that's OK.
-			EnsureKDTreePresent(subpop_data);
-			
+			// Here we use the k-d tree or the cell grid to find all interacting pairs, and calculate their distances.
+			// When the interaction is fully reciprocal (exerters and receivers are the same), the sparse array is
+			// symmetric; it then keeps only one entry per interacting pair, and ignores the mirror-image entries we add.
 			slim_popsize_t subpop_size = p_subpop->parent_subpop_size_;
+			bool symmetric = (reciprocal_ && (receiver_sex_ == exerter_sex_));
 			
 			if (subpop_data.dist_str_)
-				subpop_data.dist_str_->Reset(subpop_size, subpop_size);
+				subpop_data.dist_str_->Reset(subpop_size, subpop_size, symmetric);
 			else
-				subpop_data.dist_str_ = new SparseArray(subpop_size, subpop_size);
+				subpop_data.dist_str_ = new SparseArray(subpop_size, subpop_size, symmetric);
 			
 			double *position_data = subpop_data.positions_;
 			int start_row = 0, after_end_row = subpop_size, row;
@@ -526,8 +532,44 @@ void InteractionType::CalculateAllDistances(Subpopulation *p_subpop)
 			else
 				EIDOS_TERMINATION << "ERROR (InteractionType::CalculateAllDistances): (internal error) unrecognized value for receiver_sex_." << EidosTerminate();
 			
+			int start_exerter = 0, after_end_exerter = subpop_size;
+			
 			if (exerter_sex_ == IndividualSex::kUnspecified)
+				;
+			else if (exerter_sex_ == IndividualSex::kMale)
+				start_exerter = subpop_data.first_male_index_;
+			else if (exerter_sex_ == IndividualSex::kFemale)
+				after_end_exerter = subpop_data.first_male_index_;
+			else
+				EIDOS_TERMINATION << "ERROR (InteractionType::CalculateAllDistances): (internal error) unrecognized value for exerter_sex_." << EidosTerminate();
+			
+			if (ShouldUseCellGrid(after_end_exerter - start_exerter))
+			{
+				// The cell grid contains only the exerters of the chosen sex, so it needs no sex test.  For a symmetric sparse array,
+				// only exerters with a higher index than the receiver are stored, so the others are skipped before their distance
+				// is calculated; the k-d tree cannot skip them by index, so with it they are discarded by AddEntryDistance().
+				EnsureCellGridPresent(subpop_data, start_exerter, after_end_exerter);
+				
+				switch (spatiality_)
+				{
+					case 1:
+						for (row = start_row; row < after_end_row; row++)
+							BuildSA_Grid_1(subpop_data, position_data + row * SLIM_MAX_DIMENSIONALITY, row, subpop_data.dist_str_, symmetric ? row + 1 : 0);
+						break;
+					case 2:
+						for (row = start_row; row < after_end_row; row++)
+							BuildSA_Grid_2(subpop_data, position_data + row * SLIM_MAX_DIMENSIONALITY, row, subpop_data.dist_str_, symmetric ? row + 1 : 0);
+						break;
+					case 3:
+						for (row = start_row; row < after_end_row; row++)
+							BuildSA_Grid_3(subpop_data, position_data + row * SLIM_MAX_DIMENSIONALITY, row, subpop_data.dist_str_, symmetric ? row + 1 : 0);
+						break;
+				}
+			}
+			else if (exerter_sex_ == IndividualSex::kUnspecified)
 			{
+				EnsureKDTreePresent(subpop_data);
+				
 				// Without a specified exerter sex, we can add each exerter with no sex test
 				switch (spatiality_)
 				{
@@ -547,16 +589,9 @@ void InteractionType::CalculateAllDistances(Subpopulation *p_subpop)
 			}
 			else
 			{
-				// With a specified exerter sex, we use a special version of BuildSA_X() that tests for that by range
-				int start_exerter = 0, after_end_exerter = subpop_size;
-				
-				if (exerter_sex_ == IndividualSex::kMale)
-					start_exerter = subpop_data.first_male_index_;
-				else if (exerter_sex_ == IndividualSex::kFemale)
-					after_end_exerter = subpop_data.first_male_index_;
-				else
-					EIDOS_TERMINATION << "ERROR (InteractionType::CalculateAllDistances): (internal error) unrecognized value for exerter_sex_." << EidosTerminate();
+				EnsureKDTreePresent(subpop_data);
 				
+				// With a specified exerter sex, we use a special version of BuildSA_X() that tests for that by range
 				switch (spatiality_)
 				{
 					case 1:
@@ -609,7 +644,7 @@ void InteractionType::CalculateAllStrengths(Subpopulation *p_subpop)
 			if (callbacks.size() == 0)
 			{
 				// No callbacks; strength calculations come from the interaction function only
-				// We do not use reciprocity here, as searching for the mirrored entry would probably take longer than just calculating twice
+				// For a symmetric sparse array this visits only the stored entries, so each reciprocal pair is calculated once
 				for (uint32_t row = 0; row < (uint32_t)subpop_size; ++row)
 				{
 					uint32_t row_nnz, *row_columns;
@@ -618,69 +653,7 @@ void InteractionType::CalculateAllStrengths(Subpopulation *p_subpop)
 					
 					dist_str.InteractionsForRow(row, &row_nnz, &row_columns, &row_distances, &row_strengths);
 					
-					// CalculateStrengthNoCallbacks() is basically inlined here, moved outside the loop; see that function for comments
-					switch (if_type_)
-					{
-						case IFType::kFixed:
-						{
-							for (uint32_t col_iter = 0; col_iter < row_nnz; ++col_iter)
-								row_strengths[col_iter] = (sa_strength_t)if_param1_;
-							break;
-						}
-						case IFType::kLinear:
-						{
-							for (uint32_t col_iter = 0; col_iter < row_nnz; ++col_iter)
-							{
-								sa_distance_t distance = row_distances[col_iter];
-								
-								row_strengths[col_iter] = (sa_strength_t)(if_param1_ * (1.0 - distance / max_distance_));
-							}
-							break;
-						}
-						case IFType::kExponential:
-						{
-							for (uint32_t col_iter = 0; col_iter < row_nnz; ++col_iter)
-							{
-								sa_distance_t distance = row_distances[col_iter];
-								
-								row_strengths[col_iter] = (sa_strength_t)(if_param1_ * exp(-if_param2_ * distance));
-							}
-							break;
-						}
-						case IFType::kNormal:
-						{
-							for (uint32_t col_iter = 0; col_iter < row_nnz; ++col_iter)
-							{
-								sa_distance_t distance = row_distances[col_iter];
-								
-								row_strengths[col_iter] = (sa_strength_t)(if_param1_ * exp(-(distance * distance) / (2.0 * if_param2_ * if_param2_)));
-							}
-							break;
-						}
-						case IFType::kCauchy:
-						{
-							for (uint32_t col_iter = 0; col_iter < row_nnz; ++col_iter)
-							{
-								sa_distance_t distance = row_distances[col_iter];
-								double temp = distance / if_param2_;
-								
-								row_strengths[col_iter] = (sa_strength_t)(if_param1_ / (1.0 + temp * temp));
-							}
-							break;
-						}
-						default:
-						{
-							// should never be hit, but this is the base case
-							for (uint32_t col_iter = 0; col_iter < row_nnz; ++col_iter)
-							{
-								sa_distance_t distance = row_distances[col_iter];
-								
-								row_strengths[col_iter] = (sa_strength_t)CalculateStrengthNoCallbacks(distance);
-							}
-							
-							EIDOS_TERMINATION << "ERROR (InteractionType::CalculateAllStrengths): (internal error) unimplemented IFType case." << EidosTerminate();
-						}
-					}
+					CalculateRowStrengthsNoCallbacks(row_distances, row_strengths, row_nnz);
 				}
 			}
 			else
@@ -723,9 +696,8 @@ void InteractionType::CalculateAllStrengths(Subpopulation *p_subpop)
 				}
 				else if (reciprocal_ && (receiver_sex_ == exerter_sex_))
 				{
-					// Fully reciprocal; exerters and receivers are the same.  We calculate when row <= col, and when
-					// row < col we find the mirror entry and place the calculated value there too.  When row > col,
-					// we assume that the strength will be (or has been) filled in by the mirror entry.
+					// Fully reciprocal; exerters and receivers are the same.  The sparse array is symmetric, and stores
+					// only the entries with row < col; each of those is calculated once, and serves for its mirror entry.
 					for (uint32_t row = 0; row < (uint32_t)subpop_size; ++row)
 					{
 						uint32_t row_nnz, *row_columns;
@@ -737,17 +709,10 @@ void InteractionType::CalculateAllStrengths(Subpopulation *p_subpop)
 						for (uint32_t col_iter = 0; col_iter < row_nnz; ++col_iter)
 						{
 							uint32_t col = row_columns[col_iter];
+							sa_distance_t distance = row_distances[col_iter];
+							sa_strength_t strength = (sa_strength_t)CalculateStrengthWithCallbacks(distance, subpop_individuals[row], subpop_individuals[col], p_subpop, callbacks);
 							
-							if (row <= col)
-							{
-								sa_distance_t distance = row_distances[col_iter];
-								sa_strength_t strength = (sa_strength_t)CalculateStrengthWithCallbacks(distance, subpop_individuals[row], subpop_individuals[col], p_subpop, callbacks);
-								
-								row_strengths[col_iter] = strength;
-								
-								if (row < col)
-									dist_str.PatchStrength(col, row, strength);
-							}
+							row_strengths[col_iter] = strength;
 						}
 					}
 				}
@@ -809,6 +774,200 @@ void InteractionType::CalculateAllStrengths(Subpopulation *p_subpop)
 	}
 }
 
+void InteractionType::CalculateRowStrengthsNoCallbacks(const sa_distance_t * __restrict__ p_distances, sa_strength_t * __restrict__ p_strengths, uint32_t p_count)
+{
+	// This evaluates the interaction function over a whole row of distances at once.  The parameters are hoisted into locals and
+	// the buffers do not alias, so the loops without exp() vectorize; exp() itself stays scalar, since vectorized variants are
+	// not bit-identical to libm.  If a kernel table is in use, every type that has one is interpolated instead; see
+	// CacheKernelTable().
+	if (kernel_table_.size())
+	{
+		const double *table = kernel_table_.data();
+		const double scale = kernel_table_scale_;
+		const int last_interval = (int)kernel_table_.size() - 2;
+		
+		for (uint32_t col_iter = 0; col_iter < p_count; ++col_iter)
+		{
+			double position = p_distances[col_iter] * scale;
+			int interval = std::min((int)position, last_interval);
+			double low = table[interval];
+			
+			p_strengths[col_iter] = (sa_strength_t)(low + (position - interval) * (table[interval + 1] - low));
+		}
+		return;
+	}
+	
+	// CalculateStrengthNoCallbacks() is basically inlined here, moved outside the loop; see that function for comments
+	const double fmax = if_param1_;
+	
+	switch (if_type_)
+	{
+		case IFType::kFixed:
+		{
+			for (uint32_t col_iter = 0; col_iter < p_count; ++col_iter)
+				p_strengths[col_iter] = (sa_strength_t)fmax;
+			break;
+		}
+		case IFType::kLinear:
+		{
+			const double max_distance = max_distance_;
+			
+			for (uint32_t col_iter = 0; col_iter < p_count; ++col_iter)
+			{
+				sa_distance_t distance = p_distances[col_iter];
+				
+				p_strengths[col_iter] = (sa_strength_t)(fmax * (1.0 - distance / max_distance));
+			}
+			break;
+		}
+		case IFType::kExponential:
+		{
+			const double lambda = if_param2_;
+			
+			for (uint32_t col_iter = 0; col_iter < p_count; ++col_iter)
+			{
+				sa_distance_t distance = p_distances[col_iter];
+				
+				p_strengths[col_iter] = (sa_strength_t)(fmax * exp(-lambda * distance));
+			}
+			break;
+		}
+		case IFType::kNormal:
+		{
+			const double two_sigma_sq = 2.0 * if_param2_ * if_param2_;
+			
+			for (uint32_t col_iter = 0; col_iter < p_count; ++col_iter)
+			{
+				sa_distance_t distance = p_distances[col_iter];
+				
+				p_strengths[col_iter] = (sa_strength_t)(fmax * exp(-(distance * distance) / two_sigma_sq));
+			}
+			break;
+		}
+		case IFType::kCauchy:
+		{
+			const double scale = if_param2_;
+			
+			for (uint32_t col_iter = 0; col_iter < p_count; ++col_iter)
+			{
+				sa_distance_t distance = p_distances[col_iter];
+				double temp = distance / scale;
+				
+				p_strengths[col_iter] = (sa_strength_t)(fmax / (1.0 + temp * temp));
+			}
+			break;
+		}
+		default:
+		{
+			// should never be hit, but this is the base case
+			for (uint32_t col_iter = 0; col_iter < p_count; ++col_iter)
+			{
+				sa_distance_t distance = p_distances[col_iter];
+				
+				p_strengths[col_iter] = (sa_strength_t)CalculateStrengthNoCallbacks(distance);
+			}
+			
+			EIDOS_TERMINATION << "ERROR (InteractionType::CalculateRowStrengthsNoCallbacks): (internal error) unimplemented IFType case." << EidosTerminate();
+		}
+	}
+}
+
+bool InteractionType::ShouldStreamInteractions(InteractionsData &p_subpop_data)
+{
+	// Streaming is used only when the sparse array has not already been built, since then it is cheaper to use it, and only
+	// without interaction() callbacks, which must be called only once per interacting pair (and, for reciprocal interactions,
+	// must yield the same strength in both directions); a streamed row is recalculated each time it is requested.  Fully
+	// reciprocal interactions are not streamed: their sparse array is symmetric, and so calculates each pair only once, whereas
+	// a streamed row would calculate each pair from both sides.  Building the symmetric array also keeps the results of later
+	// queries independent of whether some earlier query built it.
+	if (reciprocal_ && (receiver_sex_ == exerter_sex_))
+		return false;
+	
+	return ((spatiality_ > 0) && !p_subpop_data.distances_calculated_ && (p_subpop_data.evaluation_interaction_callbacks_.size() == 0));
+}
+
+SparseArray *InteractionType::StreamInteractionsForRow(Subpopulation *p_subpop, InteractionsData &p_subpop_data, slim_popsize_t p_row)
+{
+	// This calculates the distances and strengths for a single receiver, exactly as CalculateAllDistances() and
+	// CalculateAllStrengths() would calculate that row of the sparse array, into a sparse array that holds only that row.
+	// The returned sparse array is valid, for p_row only, until the next call; the row is never symmetric, so it is complete.
+	if (!p_subpop_data.evaluated_)
+		EIDOS_TERMINATION << "ERROR (InteractionType::StreamInteractionsForRow): interaction has not yet been evaluated." << EidosTerminate();
+	
+	slim_popsize_t subpop_size = p_subpop->parent_subpop_size_;
+	
+	if (!p_subpop_data.streamed_row_)
+		p_subpop_data.streamed_row_ = new SparseArray(subpop_size, subpop_size);
+	else if (p_subpop_data.streamed_row_->RowCount() != (uint32_t)subpop_size)
+		p_subpop_data.streamed_row_->Reset(subpop_size, subpop_size);
+	
+	SparseArray *streamed_row = p_subpop_data.streamed_row_;
+	bool is_receiver = true;
+	
+	if (receiver_sex_ == IndividualSex::kMale)
+		is_receiver = (p_row >= p_subpop_data.first_male_index_);
+	else if (receiver_sex_ == IndividualSex::kFemale)
+		is_receiver = (p_row < p_subpop_data.first_male_index_);
+	
+	streamed_row->BeginStreamedRow(p_row);
+	
+	if (is_receiver)
+	{
+		double *position_data = p_subpop_data.positions_ + p_row * SLIM_MAX_DIMENSIONALITY;
+		int start_exerter = 0, after_end_exerter = subpop_size;
+		
+		if (exerter_sex_ == IndividualSex::kMale)
+			start_exerter = p_subpop_data.first_male_index_;
+		else if (exerter_sex_ == IndividualSex::kFemale)
+			after_end_exerter = p_subpop_data.first_male_index_;
+		
+		if (ShouldUseCellGrid(after_end_exerter - start_exerter))
+		{
+			EnsureCellGridPresent(p_subpop_data, start_exerter, after_end_exerter);
+			
+			switch (spatiality_)
+			{
+				case 1: BuildSA_Grid_1(p_subpop_data, position_data, p_row, streamed_row, 0); break;
+				case 2: BuildSA_Grid_2(p_subpop_data, position_data, p_row, streamed_row, 0); break;
+				case 3: BuildSA_Grid_3(p_subpop_data, position_data, p_row, streamed_row, 0); break;
+			}
+		}
+		else if (exerter_sex_ == IndividualSex::kUnspecified)
+		{
+			EnsureKDTreePresent(p_subpop_data);
+			
+			switch (spatiality_)
+			{
+				case 1: BuildSA_1(p_subpop_data.kd_root_, position_data, p_row, streamed_row); break;
+				case 2: BuildSA_2(p_subpop_data.kd_root_, position_data, p_row, streamed_row, 0); break;
+				case 3: BuildSA_3(p_subpop_data.kd_root_, position_data, p_row, streamed_row, 0); break;
+			}
+		}
+		else
+		{
+			EnsureKDTreePresent(p_subpop_data);
+			
+			switch (spatiality_)
+			{
+				case 1: BuildSA_SS_1(p_subpop_data.kd_root_, position_data, p_row, streamed_row, start_exerter, after_end_exerter); break;
+				case 2: BuildSA_SS_2(p_subpop_data.kd_root_, position_data, p_row, streamed_row, start_exerter, after_end_exerter, 0); break;
+				case 3: BuildSA_SS_3(p_subpop_data.kd_root_, position_data, p_row, streamed_row, start_exerter, after_end_exerter, 0); break;
+			}
+		}
+	}
+	
+	streamed_row->FinishStreamedRow();
+	
+	uint32_t row_nnz, *row_columns;
+	sa_distance_t *row_distances;
+	sa_strength_t *row_strengths;
+	
+	streamed_row->InteractionsForRow(p_row, &row_nnz, &row_columns, &row_distances, &row_strengths);
+	CalculateRowStrengthsNoCallbacks(row_distances, row_strengths, row_nnz);
+	
+	return streamed_row;
+}
+
 double InteractionType::CalculateDistance(double *p_position1, double *p_position2)
 {
 #ifndef __clang_analyzer__
@@ -953,7 +1112,16 @@ double InteractionType::CalculateStrengthNoCallbacks(double p_distance)
 	// logic in CalculateAllDistances().  (If CalculateAllDistances() is not involved, then
 	// ruling out the self-interaction case is indeed the caller's responsibility.)
 	
-	// MAINTAIN IN PARALLEL: InteractionType::CalculateAllStrengths()
+	// MAINTAIN IN PARALLEL: InteractionType::CalculateRowStrengthsNoCallbacks()
+	if (kernel_table_.size())
+	{
+		double position = p_distance * kernel_table_scale_;
+		int interval = std::min((int)position, (int)kernel_table_.size() - 2);
+		double low = kernel_table_[interval];
+		
+		return low + (position - interval) * (kernel_table_[interval + 1] - low);
+	}
+	
 	switch (if_type_)
 	{
 		case IFType::kFixed:
@@ -973,6 +1141,67 @@ double InteractionType::CalculateStrengthNoCallbacks(double p_distance)
 	EIDOS_TERMINATION << "ERROR (InteractionType::CalculateStrengthNoCallbacks): (internal error) unexpected if_type_ value." << EidosTerminate();
 }
 
+// the largest kernel table we will build, in intervals; a tolerance that would require more than this is met by exact evaluation
+#define SLIM_KERNEL_TABLE_MAX_INTERVALS		(1024 * 1024)
+
+void InteractionType::CacheKernelTable(void)
+{
+	// If kernel_tolerance_ is set, we tabulate the interaction function at equally spaced distances over [0, max_distance_], and
+	// CalculateStrengthNoCallbacks() and CalculateRowStrengthsNoCallbacks() then interpolate linearly in the table instead of
+	// evaluating the function.  The error of linear interpolation between points h apart is at most M * h^2 / 8, where M is
+	// the maximum of |f''| over the interval; we choose h so that this bound is within kernel_tolerance_.  Types "f" and "l"
+	// are linear, and thus cheap and exact, so they are never tabulated.  This must be called whenever the interaction
+	// function, max_distance_, or kernel_tolerance_ changes.
+	kernel_table_.clear();
+	kernel_table_scale_ = 0.0;
+	
+	if ((kernel_tolerance_ <= 0.0) || (spatiality_ == 0) || !std::isfinite(max_distance_) || (max_distance_ <= 0.0))
+		return;
+	
+	double fmax = std::fabs(if_param1_);
+	double max_second_derivative;
+	
+	switch (if_type_)
+	{
+		case IFType::kExponential:
+			// f'' = fmax * λ^2 * exp(−λd), which is largest at d = 0 for λ >= 0, or at d = dmax for λ < 0
+			max_second_derivative = fmax * if_param2_ * if_param2_ * std::max(1.0, exp(-if_param2_ * max_distance_));
+			break;
+		case IFType::kNormal:
+			// f'' = fmax * (d^2/σ^4 − 1/σ^2) * exp(−d^2/2σ^2), which is largest in magnitude at d = 0; σ == 0 cannot be tabulated
+			if (if_param2_ <= 0.0)
+				return;
+			max_second_derivative = fmax / (if_param2_ * if_param2_);
+			break;
+		case IFType::kCauchy:
+			// f'' = fmax * (6u^2 − 2) / (λ^2 * (1 + u^2)^3) with u = d/λ, which is largest in magnitude at d = 0
+			max_second_derivative = 2.0 * fmax / (if_param2_ * if_param2_);
+			break;
+		default:
+			return;
+	}
+	
+	double intervals = 1.0;
+	
+	if (max_second_derivative > 0.0)
+		intervals = std::max(1.0, ceil(max_distance_ * sqrt(max_second_derivative / (8.0 * kernel_tolerance_))));
+	
+	if (!(intervals <= SLIM_KERNEL_TABLE_MAX_INTERVALS))
+		return;
+	
+	// The table is filled while kernel_table_ is still empty, so these are exact evaluations; the last entry is duplicated so
+	// that a distance of exactly max_distance_ (or a float distance that rounded up slightly past it) interpolates safely
+	int interval_count = (int)intervals;
+	std::vector<double> table(interval_count + 2);
+	
+	for (int interval = 0; interval <= interval_count; ++interval)
+		table[interval] = CalculateStrengthNoCallbacks(max_distance_ * interval / interval_count);
+	table[interval_count + 1] = table[interval_count];
+	
+	kernel_table_.swap(table);
+	kernel_table_scale_ = interval_count / max_distance_;
+}
+
 double InteractionType::CalculateStrengthWithCallbacks(double p_distance, Individual *p_receiver, Individual *p_exerter, Subpopulation *p_subpop, std::vector<SLiMEidosBlock*> &p_interaction_callbacks)
 {
 	// CAUTION: This method should only be called when p_distance <= max_distance_ (or is NAN).
@@ -1492,7 +1721,17 @@ size_t InteractionType::MemoryUsageForKDTrees(void)
 	for (auto &iter : data_)
 	{
 		const InteractionsData &data = iter.second;
-		usage += sizeof(SLiM_kdNode) * data.individual_count_;
+		
+		if (data.kd_nodes_)
+			usage += sizeof(SLiM_kdNode) * data.kd_node_count_;
+		
+		if (data.grid_cell_count_)
+		{
+			slim_popsize_t grid_entry_count = data.grid_cell_offsets_[data.grid_cell_count_];
+			
+			usage += sizeof(uint32_t) * (data.grid_cell_count_ + 1);
+			usage += (sizeof(uint32_t) + sizeof(double) * spatiality_) * grid_entry_count;
+		}
 	}
 	
 	return usage;
@@ -1518,9 +1757,12 @@ size_t InteractionType::MemoryUsageForSparseArrays(void)
 	for (auto &iter : data_)
 	{
 		SparseArray *array = iter.second.dist_str_;
+		SparseArray *streamed_row = iter.second.streamed_row_;
 		
 		if (array)
-			usage += iter.second.dist_str_->MemoryUsage();
+			usage += array->MemoryUsage();
+		if (streamed_row)
+			usage += streamed_row->MemoryUsage();
 	}
 	
 	return usage;
@@ -1738,6 +1980,26 @@ SLiM_kdNode *InteractionType::MakeKDTree3_p2(SLiM_kdNode *t, int len)
 	return n;
 }
 
+// returns true if a periodic replicate of a position, displaced by p_offsets, is within p_margin of the bounds; dimensions
+// with a zero offset are not checked, since positions are guaranteed to be within the bounds of periodic dimensions
+static inline __attribute__((always_inline)) bool PeriodicReplicateInRange(const double *p_position, const double *p_offsets, const double *p_bounds, double p_margin)
+{
+	for (int dim = 0; dim < SLIM_MAX_DIMENSIONALITY; ++dim)
+	{
+		double offset = p_offsets[dim];
+		
+		if (offset != 0.0)
+		{
+			double coord = p_position[dim] + offset;
+			
+			if ((coord < -p_margin) || (coord > p_bounds[dim] + p_margin))
+				return false;
+		}
+	}
+	
+	return true;
+}
+
 void InteractionType::EnsureKDTreePresent(InteractionsData &p_subpop_data)
 {
 	if (!p_subpop_data.evaluated_)
@@ -1763,7 +2025,43 @@ void InteractionType::EnsureKDTreePresent(InteractionsData &p_subpop_data)
 		else if (periodic_dimensions == 3)
 			periodicity_multiplier = 27;
 		
-		count *= periodicity_multiplier;
+		// Determine the offsets for each replicate of the individual position data; each periodic dimension consumes one
+		// base-3 digit of the replicate number, selecting a displacement of -1, 0, or +1 times the bounds in that dimension
+		double replicate_offsets[27 * SLIM_MAX_DIMENSIONALITY];
+		double bounds[SLIM_MAX_DIMENSIONALITY] = {p_subpop_data.bounds_x1_, p_subpop_data.bounds_y1_, p_subpop_data.bounds_z1_};
+		
+		for (int replicate = 0; replicate < periodicity_multiplier; ++replicate)
+		{
+			double *offsets = replicate_offsets + replicate * SLIM_MAX_DIMENSIONALITY;
+			int replication_dim = replicate;
+			
+			offsets[0] = 0;
+			offsets[1] = 0;
+			offsets[2] = 0;
+			
+			if (periodic_x_)	{ offsets[0] = bounds[0] * ((replication_dim % 3) - 1);		replication_dim /= 3; }
+			if (periodic_y_)	{ offsets[1] = bounds[1] * ((replication_dim % 3) - 1);		replication_dim /= 3; }
+			if (periodic_z_)	{ offsets[2] = bounds[2] * ((replication_dim % 3) - 1); }
+		}
+		
+		// Only a replicate that lies within max_distance_ of the periodic bounds can ever be found by a query, since all of
+		// our queries are limited to max_distance_ and all focal points lie within the bounds; the rest are never created.
+		// This keeps the size of the tree close to individual_count_, rather than 3x, 9x, or 27x that, which makes both
+		// construction and searching considerably faster.  We count first, so that the allocation is exact.
+		if (periodic_dimensions)
+		{
+			count = 0;
+			
+			for (int replicate = 0; replicate < periodicity_multiplier; ++replicate)
+			{
+				double *offsets = replicate_offsets + replicate * SLIM_MAX_DIMENSIONALITY;
+				
+				for (int i = 0; i < individual_count; ++i)
+					if (PeriodicReplicateInRange(p_subpop_data.positions_ + i * SLIM_MAX_DIMENSIONALITY, offsets, bounds, max_distance_))
+						count++;
+			}
+		}
+		
 		p_subpop_data.kd_node_count_ = count;
 		
 		// Now allocate the chosen number of nodes
@@ -1775,81 +2073,24 @@ void InteractionType::EnsureKDTreePresent(InteractionsData &p_subpop_data)
 		if (periodic_dimensions)
 		{
 			// This is the periodic case; we replicate the individual position data and add an offset to each replicate
+			SLiM_kdNode *node = nodes;
+			
 			for (int replicate = 0; replicate < periodicity_multiplier; ++replicate)
-			{
-				SLiM_kdNode *replicate_nodes = nodes + replicate * individual_count;
-				double x_offset = 0, y_offset = 0, z_offset = 0;
-				
-				// Determine the correct offsets for this replicate of the individual position data;
-				// maybe there is a smarter way to do this, but whatever
-				int replication_dim_1 = (replicate % 3) - 1;
-				int replication_dim_2 = ((replicate / 3) % 3) - 1;
-				int replication_dim_3 = (replicate / 9) - 1;
-				
-				if (periodic_x_)
-				{
-					x_offset = p_subpop_data.bounds_x1_ * replication_dim_1;
-					
-					if (periodic_y_)
-					{
-						y_offset = p_subpop_data.bounds_y1_ * replication_dim_2;
-						
-						if (periodic_z_)
-							z_offset = p_subpop_data.bounds_z1_ * replication_dim_3;
-					}
-					else if (periodic_z_)
-					{
-						z_offset = p_subpop_data.bounds_z1_ * replication_dim_2;
-					}
-				}
-				else if (periodic_y_)
-				{
-					y_offset = p_subpop_data.bounds_y1_ * replication_dim_1;
-					
-					if (periodic_z_)
-						z_offset = p_subpop_data.bounds_z1_ * replication_dim_2;
-				}
-				else if (periodic_z_)
-				{
-					z_offset = p_subpop_data.bounds_z1_ * replication_dim_1;
-				}
-				
-				// Now that we have our offsets, copy the data for the replicate
-				switch (spatiality_)
-				{
-					case 1:
-						for (int i = 0; i < individual_count; ++i)
-						{
-							SLiM_kdNode *node = replicate_nodes + i;
-							double *position_data = p_subpop_data.positions_ + i * SLIM_MAX_DIMENSIONALITY;
-							
-							node->x[0] = position_data[0] + x_offset;
-							node->individual_index_ = i;
-						}
-						break;
-					case 2:
-						for (int i = 0; i < individual_count; ++i)
-						{
-							SLiM_kdNode *node = replicate_nodes + i;
-							double *position_data = p_subpop_data.positions_ + i * SLIM_MAX_DIMENSIONALITY;
-							
-							node->x[0] = position_data[0] + x_offset;
-							node->x[1] = position_data[1] + y_offset;
-							node->individual_index_ = i;
-						}
-						break;
-					case 3:
-						for (int i = 0; i < individual_count; ++i)
-						{
-							SLiM_kdNode *node = replicate_nodes + i;
-							double *position_data = p_subpop_data.positions_ + i * SLIM_MAX_DIMENSIONALITY;
-							
-							node->x[0] = position_data[0] + x_offset;
-							node->x[1] = position_data[1] + y_offset;
-							node->x[2] = position_data[2] + z_offset;
-							node->individual_index_ = i;
-						}
-						break;
+			{
+				double *offsets = replicate_offsets + replicate * SLIM_MAX_DIMENSIONALITY;
+				
+				for (int i = 0; i < individual_count; ++i)
+				{
+					double *position_data = p_subpop_data.positions_ + i * SLIM_MAX_DIMENSIONALITY;
+					
+					if (!PeriodicReplicateInRange(position_data, offsets, bounds, max_distance_))
+						continue;
+					
+					for (int dim = 0; dim < spatiality_; ++dim)
+						node->x[dim] = position_data[dim] + offsets[dim];
+					
+					node->individual_index_ = i;
+					node++;
 				}
 			}
 		}
@@ -2375,6 +2616,334 @@ void InteractionType::BuildSA_SS_3(SLiM_kdNode *root, double *nd, slim_popsize_t
 }
 
 
+#pragma mark -
+#pragma mark cell grid sparse array building
+#pragma mark -
+
+// the grid cells are made slightly wider than max_distance_, so that floating-point rounding in the calculation of cell
+// coordinates can never place two points that are within max_distance_ of each other in non-adjacent cells
+#define SLIM_CELL_GRID_SIZE_MARGIN	(1.0 + 1e-6)
+
+bool InteractionType::ShouldUseCellGrid(int p_exerter_count)
+{
+	// the grid requires a finite, non-zero maximum distance to size its cells; below the threshold the k-d tree is fine
+	return (std::isfinite(max_distance_) && (max_distance_ > 0.0) && (p_exerter_count >= SLIM_CELL_GRID_MIN_EXERTERS));
+}
+
+// get the grid coordinate of a point along one dimension, clamped into the grid; points outside the grid (receivers that
+// lie beyond the bounding box of the exerters) are placed in the nearest edge cell, which is still correct since every
+// exerter within max_distance_ of such a point is then in that edge cell or the cell adjacent to it
+static inline __attribute__((always_inline)) int GridCellCoordinate(double p_coordinate, double p_origin, double p_cell_size, int p_dim_cells)
+{
+	double cell = floor((p_coordinate - p_origin) / p_cell_size);
+	
+	if (!(cell > 0.0))
+		return 0;
+	if (cell >= p_dim_cells)
+		return p_dim_cells - 1;
+	return (int)cell;
+}
+
+// resolve a neighboring grid coordinate along one dimension; off the ends of the grid, a periodic dimension wraps around, with
+// a shift of the bounds to place the wrapped exerters next to the receiver, whereas a non-periodic dimension has no neighbor
+static inline __attribute__((always_inline)) bool GridNeighborCoordinate(int p_coordinate, int p_dim_cells, bool p_periodic, double p_bound, int *p_neighbor_coordinate, double *p_shift)
+{
+	if (p_coordinate < 0)
+	{
+		if (!p_periodic)
+			return false;
+		
+		*p_neighbor_coordinate = p_coordinate + p_dim_cells;
+		*p_shift = -p_bound;
+	}
+	else if (p_coordinate >= p_dim_cells)
+	{
+		if (!p_periodic)
+			return false;
+		
+		*p_neighbor_coordinate = p_coordinate - p_dim_cells;
+		*p_shift = p_bound;
+	}
+	else
+	{
+		*p_neighbor_coordinate = p_coordinate;
+		*p_shift = 0.0;
+	}
+	
+	return true;
+}
+
+void InteractionType::EnsureCellGridPresent(InteractionsData &p_subpop_data, int start_exerter, int after_end_exerter)
+{
+	if (!p_subpop_data.evaluated_)
+		EIDOS_TERMINATION << "ERROR (InteractionType::EnsureCellGridPresent): (internal error) the interaction has not been evaluated." << EidosTerminate();
+	
+	if (p_subpop_data.grid_cell_count_)
+		return;
+	
+	int exerter_count = after_end_exerter - start_exerter;
+	bool periodic[SLIM_MAX_DIMENSIONALITY] = {periodic_x_, periodic_y_, periodic_z_};
+	double bounds[SLIM_MAX_DIMENSIONALITY] = {p_subpop_data.bounds_x1_, p_subpop_data.bounds_y1_, p_subpop_data.bounds_z1_};
+	double min_cell_size = max_distance_ * SLIM_CELL_GRID_SIZE_MARGIN;
+	double dim_cells[SLIM_MAX_DIMENSIONALITY];
+	double extent[SLIM_MAX_DIMENSIONALITY];
+	double total_cells = 1.0;
+	
+	// Lay out the grid: periodic dimensions are tiled exactly by the cells, from zero to the bound, whereas non-periodic
+	// dimensions are covered from the lowest exerter coordinate to the highest
+	for (int dim = 0; dim < spatiality_; ++dim)
+	{
+		if (periodic[dim])
+		{
+			p_subpop_data.grid_origin_[dim] = 0.0;
+			extent[dim] = bounds[dim];
+			dim_cells[dim] = std::max(1.0, floor(extent[dim] / min_cell_size));
+		}
+		else
+		{
+			double min_coord = std::numeric_limits<double>::infinity(), max_coord = -std::numeric_limits<double>::infinity();
+			
+			for (int i = start_exerter; i < after_end_exerter; ++i)
+			{
+				double coord = p_subpop_data.positions_[i * SLIM_MAX_DIMENSIONALITY + dim];
+				
+				min_coord = std::min(min_coord, coord);
+				max_coord = std::max(max_coord, coord);
+			}
+			
+			if (exerter_count == 0)
+				min_coord = max_coord = 0.0;
+			
+			p_subpop_data.grid_origin_[dim] = min_coord;
+			extent[dim] = max_coord - min_coord;
+			dim_cells[dim] = floor(extent[dim] / min_cell_size) + 1.0;
+		}
+		
+		total_cells *= dim_cells[dim];
+	}
+	
+	// If the maximum distance is very small relative to the extent, the grid would be mostly empty cells; we limit the number
+	// of cells to twice the number of exerters by coarsening all dimensions equally, which keeps the grid O(N) in size
+	double max_cells = std::max(2.0 * exerter_count, 1.0);
+	
+	if (total_cells > max_cells)
+	{
+		double coarsening = pow(total_cells / max_cells, 1.0 / spatiality_);
+		
+		for (int dim = 0; dim < spatiality_; ++dim)
+			dim_cells[dim] = std::max(1.0, floor(dim_cells[dim] / coarsening));
+	}
+	
+	int64_t cell_count = 1;
+	
+	for (int dim = 0; dim < spatiality_; ++dim)
+	{
+		int cells = (int)dim_cells[dim];
+		
+		p_subpop_data.grid_dim_cells_[dim] = cells;
+		p_subpop_data.grid_cell_size_[dim] = (periodic[dim] ? extent[dim] / cells : std::max(min_cell_size, extent[dim] / cells));
+		cell_count *= cells;
+	}
+	
+	// Allocate the grid; we keep a temporary buffer of the cell of each exerter, to avoid calculating it twice
+	uint32_t *cell_offsets = (uint32_t *)calloc(cell_count + 1, sizeof(uint32_t));
+	uint32_t *individuals = (uint32_t *)malloc(std::max(exerter_count, 1) * sizeof(uint32_t));
+	double *positions = (double *)malloc(std::max(exerter_count, 1) * spatiality_ * sizeof(double));
+	uint32_t *exerter_cells = (uint32_t *)malloc(std::max(exerter_count, 1) * sizeof(uint32_t));
+	
+	if (!cell_offsets || !individuals || !positions || !exerter_cells)
+		EIDOS_TERMINATION << "ERROR (InteractionType::EnsureCellGridPresent): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
+	
+	// Count the exerters in each cell, one position above their cell, so that a prefix sum gives the start of each cell
+	for (int i = start_exerter; i < after_end_exerter; ++i)
+	{
+		double *position_data = p_subpop_data.positions_ + i * SLIM_MAX_DIMENSIONALITY;
+		int64_t cell = 0, stride = 1;
+		
+		for (int dim = 0; dim < spatiality_; ++dim)
+		{
+			cell += stride * GridCellCoordinate(position_data[dim], p_subpop_data.grid_origin_[dim], p_subpop_data.grid_cell_size_[dim], p_subpop_data.grid_dim_cells_[dim]);
+			stride *= p_subpop_data.grid_dim_cells_[dim];
+		}
+		
+		exerter_cells[i - start_exerter] = (uint32_t)cell;
+		cell_offsets[cell + 1]++;
+	}
+	
+	for (int64_t cell = 0; cell < cell_count; ++cell)
+		cell_offsets[cell + 1] += cell_offsets[cell];
+	
+	// Scatter the exerters into their cells, in order of individual index; this advances each cell's offset to the start of
+	// the next cell, so afterwards we shift the offsets back up by one cell to restore them
+	for (int i = start_exerter; i < after_end_exerter; ++i)
+	{
+		double *position_data = p_subpop_data.positions_ + i * SLIM_MAX_DIMENSIONALITY;
+		uint32_t entry = cell_offsets[exerter_cells[i - start_exerter]]++;
+		
+		individuals[entry] = (uint32_t)i;
+		
+		for (int dim = 0; dim < spatiality_; ++dim)
+			positions[entry * spatiality_ + dim] = position_data[dim];
+	}
+	
+	for (int64_t cell = cell_count; cell > 0; --cell)
+		cell_offsets[cell] = cell_offsets[cell - 1];
+	cell_offsets[0] = 0;
+	
+	free(exerter_cells);
+	
+	p_subpop_data.grid_cell_count_ = cell_count;
+	p_subpop_data.grid_cell_offsets_ = cell_offsets;
+	p_subpop_data.grid_individuals_ = individuals;
+	p_subpop_data.grid_positions_ = positions;
+}
+
+// Distances are calculated exactly as the k-d tree code calculates them, with periodic shifts added to the exerter coordinate
+// before subtracting the receiver coordinate, so that the sparse array is bit-for-bit identical whichever method built it
+
+// Returns the first entry in a cell whose individual index is at least p_first_exerter; the individuals in each cell are in
+// ascending order of index, since EnsureCellGridPresent() scatters them into their cells in that order
+static inline uint32_t FirstGridEntry(const uint32_t *p_individuals, uint32_t p_cell_start, uint32_t p_cell_end, uint32_t p_first_exerter)
+{
+	if (p_first_exerter == 0)
+		return p_cell_start;
+	
+	return (uint32_t)(std::lower_bound(p_individuals + p_cell_start, p_individuals + p_cell_end, p_first_exerter) - p_individuals);
+}
+
+// add neighbors to the sparse array in 1D, using the cell grid
+void InteractionType::BuildSA_Grid_1(InteractionsData &p_subpop_data, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, uint32_t p_first_exerter)
+{
+	const uint32_t *cell_offsets = p_subpop_data.grid_cell_offsets_;
+	const uint32_t *individuals = p_subpop_data.grid_individuals_;
+	const double *positions = p_subpop_data.grid_positions_;
+	int cx = GridCellCoordinate(nd[0], p_subpop_data.grid_origin_[0], p_subpop_data.grid_cell_size_[0], p_subpop_data.grid_dim_cells_[0]);
+	
+	for (int ox = cx - 1; ox <= cx + 1; ++ox)
+	{
+		int gx;
+		double shift_x;
+		
+		if (!GridNeighborCoordinate(ox, p_subpop_data.grid_dim_cells_[0], periodic_x_, p_subpop_data.bounds_x1_, &gx, &shift_x))
+			continue;
+		
+		for (uint32_t entry = FirstGridEntry(individuals, cell_offsets[gx], cell_offsets[gx + 1], p_first_exerter), entry_end = cell_offsets[gx + 1]; entry < entry_end; ++entry)
+		{
+			double t = (positions[entry] + shift_x) - nd[0];
+			double d = t * t;
+			
+			if ((d <= max_distance_sq_) && (individuals[entry] != (uint32_t)p_focal_individual_index))
+				p_sparse_array->AddEntryDistance(p_focal_individual_index, individuals[entry], (sa_distance_t)sqrt(d));
+		}
+	}
+}
+
+// add neighbors to the sparse array in 2D, using the cell grid
+void InteractionType::BuildSA_Grid_2(InteractionsData &p_subpop_data, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, uint32_t p_first_exerter)
+{
+	const uint32_t *cell_offsets = p_subpop_data.grid_cell_offsets_;
+	const uint32_t *individuals = p_subpop_data.grid_individuals_;
+	const double *positions = p_subpop_data.grid_positions_;
+	const int *dim_cells = p_subpop_data.grid_dim_cells_;
+	int cx = GridCellCoordinate(nd[0], p_subpop_data.grid_origin_[0], p_subpop_data.grid_cell_size_[0], dim_cells[0]);
+	int cy = GridCellCoordinate(nd[1], p_subpop_data.grid_origin_[1], p_subpop_data.grid_cell_size_[1], dim_cells[1]);
+	
+	for (int oy = cy - 1; oy <= cy + 1; ++oy)
+	{
+		int gy;
+		double shift_y;
+		
+		if (!GridNeighborCoordinate(oy, dim_cells[1], periodic_y_, p_subpop_data.bounds_y1_, &gy, &shift_y))
+			continue;
+		
+		for (int ox = cx - 1; ox <= cx + 1; ++ox)
+		{
+			int gx;
+			double shift_x;
+			
+			if (!GridNeighborCoordinate(ox, dim_cells[0], periodic_x_, p_subpop_data.bounds_x1_, &gx, &shift_x))
+				continue;
+			
+			int64_t cell = gx + (int64_t)dim_cells[0] * gy;
+			
+			for (uint32_t entry = FirstGridEntry(individuals, cell_offsets[cell], cell_offsets[cell + 1], p_first_exerter), entry_end = cell_offsets[cell + 1]; entry < entry_end; ++entry)
+			{
+				const double *position = positions + entry * 2;
+				double t, d;
+				
+				t = (position[0] + shift_x) - nd[0];
+				d = t * t;
+				
+				t = (position[1] + shift_y) - nd[1];
+				d += t * t;
+				
+				if ((d <= max_distance_sq_) && (individuals[entry] != (uint32_t)p_focal_individual_index))
+					p_sparse_array->AddEntryDistance(p_focal_individual_index, individuals[entry], (sa_distance_t)sqrt(d));
+			}
+		}
+	}
+}
+
+// add neighbors to the sparse array in 3D, using the cell grid
+void InteractionType::BuildSA_Grid_3(InteractionsData &p_subpop_data, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, uint32_t p_first_exerter)
+{
+	const uint32_t *cell_offsets = p_subpop_data.grid_cell_offsets_;
+	const uint32_t *individuals = p_subpop_data.grid_individuals_;
+	const double *positions = p_subpop_data.grid_positions_;
+	const int *dim_cells = p_subpop_data.grid_dim_cells_;
+	int cx = GridCellCoordinate(nd[0], p_subpop_data.grid_origin_[0], p_subpop_data.grid_cell_size_[0], dim_cells[0]);
+	int cy = GridCellCoordinate(nd[1], p_subpop_data.grid_origin_[1], p_subpop_data.grid_cell_size_[1], dim_cells[1]);
+	int cz = GridCellCoordinate(nd[2], p_subpop_data.grid_origin_[2], p_subpop_data.grid_cell_size_[2], dim_cells[2]);
+	
+	for (int oz = cz - 1; oz <= cz + 1; ++oz)
+	{
+		int gz;
+		double shift_z;
+		
+		if (!GridNeighborCoordinate(oz, dim_cells[2], periodic_z_, p_subpop_data.bounds_z1_, &gz, &shift_z))
+			continue;
+		
+		for (int oy = cy - 1; oy <= cy + 1; ++oy)
+		{
+			int gy;
+			double shift_y;
+			
+			if (!GridNeighborCoordinate(oy, dim_cells[1], periodic_y_, p_subpop_data.bounds_y1_, &gy, &shift_y))
+				continue;
+			
+			for (int ox = cx - 1; ox <= cx + 1; ++ox)
+			{
+				int gx;
+				double shift_x;
+				
+				if (!GridNeighborCoordinate(ox, dim_cells[0], periodic_x_, p_subpop_data.bounds_x1_, &gx, &shift_x))
+					continue;
+				
+				int64_t cell = gx + (int64_t)dim_cells[0] * (gy + (int64_t)dim_cells[1] * gz);
+				
+				for (uint32_t entry = FirstGridEntry(individuals, cell_offsets[cell], cell_offsets[cell + 1], p_first_exerter), entry_end = cell_offsets[cell + 1]; entry < entry_end; ++entry)
+				{
+					const double *position = positions + entry * 3;
+					double t, d;
+					
+					t = (position[0] + shift_x) - nd[0];
+					d = t * t;
+					
+					t = (position[1] + shift_y) - nd[1];
+					d += t * t;
+					
+					t = (position[2] + shift_z) - nd[2];
+					d += t * t;
+					
+					if ((d <= max_distance_sq_) && (individuals[entry] != (uint32_t)p_focal_individual_index))
+						p_sparse_array->AddEntryDistance(p_focal_individual_index, individuals[entry], (sa_distance_t)sqrt(d));
+				}
+			}
+		}
+	}
+}
+
+
 #pragma mark -
 #pragma mark k-d tree neighbor searches
 #pragma mark -
@@ -3003,6 +3572,8 @@ EidosValue_SP InteractionType::GetProperty(EidosGlobalStringID p_property_id)
 			// variables
 		case gID_maxDistance:
 			return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(max_distance_));
+		case gID_kernelTolerance:
+			return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(kernel_tolerance_));
 		case gID_tag:						// ACCELERATED
 		{
 			slim_usertag_t tag_value = tag_value_;
@@ -3075,6 +3646,28 @@ void InteractionType::SetProperty(EidosGlobalStringID p_property_id, const Eidos
 			// changing max_distance_ invalidates the cached clipped_integral_ buffer; we don't deallocate it, just invalidate it
 			clipped_integral_valid_ = false;
 			
+			CacheKernelTable();
+			
+			return;
+		}
+			
+		case gID_kernelTolerance:
+		{
+			if (AnyEvaluated())
+				EIDOS_TERMINATION << "ERROR (InteractionType::SetProperty): kernelTolerance cannot be changed while the interaction is being evaluated; call unevaluate() first, or set kernelTolerance prior to evaluation of the interaction." << EidosTerminate();
+			
+			double kernel_tolerance = p_value.FloatAtIndex(0, nullptr);
+			
+			if (!(kernel_tolerance >= 0.0) || std::isinf(kernel_tolerance))
+				EIDOS_TERMINATION << "ERROR (InteractionType::SetProperty): the kernel tolerance must be finite and greater than or equal to zero." << EidosTerminate();
+			
+			kernel_tolerance_ = kernel_tolerance;
+			
+			// the clipped integrals are computed from the interaction function, so they are invalidated too
+			clipped_integral_valid_ = false;
+			
+			CacheKernelTable();
+			
 			return;
 		}
 			
@@ -3620,16 +4213,25 @@ EidosValue_SP InteractionType::ExecuteMethod_drawByStrength(EidosGlobalStringID
 	}
 	else
 	{
-		CalculateAllStrengths(subpop);
+		// Get the sparse array data; if the sparse array has not been built, we stream just the row we need
+		SparseArray *sa;
+		
+		if (ShouldStreamInteractions(subpop_data))
+		{
+			sa = StreamInteractionsForRow(subpop, subpop_data, ind_index);
+		}
+		else
+		{
+			CalculateAllStrengths(subpop);
+			sa = subpop_data.dist_str_;
+		}
 		
-		// Get the sparse array data
-		SparseArray &sa = *subpop_data.dist_str_;
 		uint32_t row_nnz;
 		const uint32_t *row_columns;
 		const sa_strength_t *strengths;
 		std::vector<double> double_strengths;	// needed by DrawByWeights() for gsl_ran_discrete_preproc()
 		
-		strengths = sa.StrengthsForRow(ind_index, &row_nnz, &row_columns);
+		strengths = sa->StrengthsForRow(ind_index, &row_nnz, &row_columns);
 		
 		// Total the interaction strengths, and gather a vector of strengths as doubles
 		double total_interaction_strength = 0.0;
@@ -3729,10 +4331,7 @@ EidosValue_SP InteractionType::ExecuteMethod_interactingNeighborCount(EidosGloba
 		
 		InteractionsData &subpop_data = subpop_data_iter->second;
 		SparseArray &sa = *subpop_data.dist_str_;
-		uint32_t row_nnz;
-		const uint32_t *row_columns;
-		
-		sa.DistancesForRow(ind_index, &row_nnz, &row_columns);
+		uint32_t row_nnz = sa.InteractionCountForRow(ind_index);
 		
 		return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Int_singleton(row_nnz));
 	}
@@ -3779,10 +4378,7 @@ EidosValue_SP InteractionType::ExecuteMethod_interactingNeighborCount(EidosGloba
 					sa = subpop_data_iter->second.dist_str_;
 				}
 				
-				uint32_t row_nnz;
-				const uint32_t *row_columns;
-				
-				sa->DistancesForRow(ind_index, &row_nnz, &row_columns);
+				uint32_t row_nnz = sa->InteractionCountForRow(ind_index);
 				
 				result_vec->set_int_no_check(row_nnz, focal_ind_index);
 			}
@@ -3826,8 +4422,11 @@ EidosValue_SP InteractionType::ExecuteMethod_localPopulationDensity(EidosGlobalS
 	if (callbacks.size())
 		EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_localPopulationDensity): localPopulationDensity() requires that no interaction() callbacks are active, since they cannot be incorporated into the calculation of the clipped integral of the interaction function." << EidosTerminate();
 	
-	// calculate all strengths, on the presumption that this method is almost always used across many/most individuals eventually
-	CalculateAllStrengths(subpop);
+	// stream each row as we need it if the sparse array has not been built; see ExecuteMethod_totalOfNeighborStrengths()
+	bool streaming = ShouldStreamInteractions(subpop_data);
+	
+	if (!streaming)
+		CalculateAllStrengths(subpop);
 	
 	double strength_for_zero_distance = CalculateStrengthNoCallbacks(0.0);	// probably always if_param1_, but let's not hard-code that...
 	
@@ -3838,18 +4437,18 @@ EidosValue_SP InteractionType::ExecuteMethod_localPopulationDensity(EidosGlobalS
 	if (count == 1)
 	{
 		// Just one value, so we can return a singleton and skip some work
-		SparseArray &sa = *subpop_data.dist_str_;
 		slim_popsize_t ind_index_in_subpop = first_ind->index_;
 		
 		if (ind_index_in_subpop < 0)
 			EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_localPopulationDensity): interactions can only be calculated for individuals that are visible in a subpopulation (i.e., not new juveniles)." << EidosTerminate();
 		
 		// Get the sparse array data
+		SparseArray *sa = (streaming ? StreamInteractionsForRow(subpop, subpop_data, ind_index_in_subpop) : subpop_data.dist_str_);
 		uint32_t row_nnz;
 		const uint32_t *row_columns;
 		const sa_strength_t *strengths;
 		
-		strengths = sa.StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
+		strengths = sa->StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
 		
 		// Total the interaction strengths
 		double total_strength = 0.0;
@@ -3869,7 +4468,16 @@ EidosValue_SP InteractionType::ExecuteMethod_localPopulationDensity(EidosGlobalS
 	{
 		// Loop over the requested individuals and get the totals
 		EidosValue_Float_vector *result_vec = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(count);
-		SparseArray &sa = *subpop_data.dist_str_;
+		
+		// Rows of a symmetric sparse array have to be reconstructed, which is slow, so when many are requested we total all of
+		// the rows in a single pass instead; the totals are identical either way.  The threshold is a rough break-even point.
+		std::vector<double> row_totals;
+		
+		if (!streaming && subpop_data.dist_str_->IsSymmetric() && (count >= subpop->parent_subpop_size_ / 16))
+		{
+			row_totals.resize(subpop_data.dist_str_->RowCount());
+			subpop_data.dist_str_->StrengthTotalsForRows(row_totals.data());
+		}
 		
 		for (int ind_index = 0; ind_index < count; ++ind_index)
 		{
@@ -3883,18 +4491,26 @@ EidosValue_SP InteractionType::ExecuteMethod_localPopulationDensity(EidosGlobalS
 			if (ind_index_in_subpop < 0)
 				EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_localPopulationDensity): interactions can only be calculated for individuals that are visible in a subpopulation (i.e., not new juveniles)." << EidosTerminate();
 			
-			// Get the sparse array data
-			uint32_t row_nnz;
-			const uint32_t *row_columns;
-			const sa_strength_t *strengths;
-			
-			strengths = sa.StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
-			
 			// Total the interaction strengths
 			double total_strength = 0.0;
 			
-			for (uint32_t col_index = 0; col_index < row_nnz; ++col_index)
-				total_strength += strengths[col_index];
+			if (row_totals.size())
+			{
+				total_strength = row_totals[ind_index_in_subpop];
+			}
+			else
+			{
+				// Get the sparse array data
+				SparseArray *sa = (streaming ? StreamInteractionsForRow(subpop, subpop_data, ind_index_in_subpop) : subpop_data.dist_str_);
+				uint32_t row_nnz;
+				const uint32_t *row_columns;
+				const sa_strength_t *strengths;
+				
+				strengths = sa->StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
+				
+				for (uint32_t col_index = 0; col_index < row_nnz; ++col_index)
+					total_strength += strengths[col_index];
+			}
 			
 			// Add the interaction strength for the focal individual to the focal point, since it counts for density
 			total_strength += strength_for_zero_distance;
@@ -3941,16 +4557,14 @@ EidosValue_SP InteractionType::ExecuteMethod_interactionDistance(EidosGlobalStri
 	
 	InteractionsData &subpop_data = subpop_data_iter->second;
 	SparseArray &sa = *subpop_data.dist_str_;
-	uint32_t row_nnz;
-	const uint32_t *row_columns;
-	const sa_distance_t *distances;
-	
-	distances = sa.DistancesForRow(receiver_index, &row_nnz, &row_columns);
 	
 	if (exerters_value->Type() == EidosValueType::kValueNULL)
 	{
 		// NULL means return distances from individuals1 (which must be singleton) to all individuals in the subpopulation
 		// Make a vector big enough, initialize it to INFINITY, and fill in values from the sparse array
+		uint32_t row_nnz;
+		const uint32_t *row_columns;
+		const sa_distance_t *distances = sa.DistancesForRow(receiver_index, &row_nnz, &row_columns);
 		EidosValue_Float_vector *result_vec = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(subpop1_size);
 		double *result_ptr = result_vec->data();
 		
@@ -3965,7 +4579,7 @@ EidosValue_SP InteractionType::ExecuteMethod_interactionDistance(EidosGlobalStri
 	else
 	{
 		// Otherwise, individuals1 is singleton, and individuals2 is any length, so we loop over individuals2
-		// Each individual in individuals2 requires a linear search through the row, unfortunately
+		// Each individual in individuals2 requires a search through the row, which is sorted by column
 		EidosValue_Float_vector *result_vec = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(exerter_count);
 		
 		for (int exerter_index = 0; exerter_index < exerter_count; ++exerter_index)
@@ -3980,14 +4594,7 @@ EidosValue_SP InteractionType::ExecuteMethod_interactionDistance(EidosGlobalStri
 			if (exerter_index_in_subpop < 0)
 				EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_interactionDistance): interactions can only be calculated for individuals that are visible in a subpopulation (i.e., not new juveniles)." << EidosTerminate();
 			
-			double distance = INFINITY;
-			
-			for (uint32_t col_index = 0; col_index < row_nnz; ++col_index)
-				if ((slim_popsize_t)row_columns[col_index] == exerter_index_in_subpop)
-				{
-					distance = distances[col_index];
-					break;
-				}
+			double distance = sa.Distance(receiver_index, exerter_index_in_subpop);
 			
 			result_vec->set_float_no_check(distance, exerter_index);
 		}
@@ -4180,6 +4787,15 @@ EidosValue_SP InteractionType::ExecuteMethod_nearestNeighborsOfPoint(EidosGlobal
 	for (int point_index = 0; point_index < spatiality_; ++point_index)
 		point_array[point_index] = point_value->FloatAtIndex(point_index, nullptr);
 	
+	// If we're using periodic boundaries, the point supplied has to be within bounds in the periodic dimensions; the k-d tree
+	// only replicates individuals out to max_distance_ beyond the periodic bounds, so it cannot answer queries from outside them
+	InteractionsData &subpop_data = subpop_data_iter->second;
+	
+	if ((periodic_x_ && ((point_array[0] < 0.0) || (point_array[0] > subpop_data.bounds_x1_))) ||
+		(periodic_y_ && ((point_array[1] < 0.0) || (point_array[1] > subpop_data.bounds_y1_))) ||
+		(periodic_z_ && ((point_array[2] < 0.0) || (point_array[2] > subpop_data.bounds_z1_))))
+		EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_nearestNeighborsOfPoint): nearestNeighborsOfPoint() requires that coordinates for periodic spatial dimensions fall inside spatial bounaries; use pointPeriodic() to ensure this if necessary." << EidosTerminate();
+	
 	// Check the count
 	int64_t count = count_value->IntAtIndex(0, nullptr);
 	
@@ -4193,8 +4809,6 @@ EidosValue_SP InteractionType::ExecuteMethod_nearestNeighborsOfPoint(EidosGlobal
 		return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Object_vector(gSLiM_Individual_Class));
 	
 	// Find the neighbors
-	InteractionsData &subpop_data = subpop_data_iter->second;
-	
 	EnsureKDTreePresent(subpop_data);
 	
 	EidosValue_Object_vector *result_vec = (new (gEidosValuePool->AllocateChunk()) EidosValue_Object_vector(gSLiM_Individual_Class))->reserve((int)count);
@@ -4303,6 +4917,8 @@ EidosValue_SP InteractionType::ExecuteMethod_setInteractionFunction(EidosGlobalS
 	// changing the interaction function invalidates the cached clipped_integral_ buffer; we don't deallocate it, just invalidate it
 	clipped_integral_valid_ = false;
 	
+	CacheKernelTable();
+	
 	return gStaticEidosValueVOID;
 }
 
@@ -4338,16 +4954,14 @@ EidosValue_SP InteractionType::ExecuteMethod_strength(EidosGlobalStringID p_meth
 		CalculateAllStrengths(subpop1);
 		
 		SparseArray &sa = *subpop_data.dist_str_;
-		uint32_t row_nnz;
-		const uint32_t *row_columns;
-		const sa_strength_t *strengths;
-		
-		strengths = sa.StrengthsForRow(receiver_index, &row_nnz, &row_columns);
 		
 		if (exerters_value->Type() == EidosValueType::kValueNULL)
 		{
 			// NULL means return strengths to individuals1 (which must be singleton) from all individuals in the subpopulation
 			// Make a vector big enough, initialize it to 0, and fill in values from the sparse array
+			uint32_t row_nnz;
+			const uint32_t *row_columns;
+			const sa_strength_t *strengths = sa.StrengthsForRow(receiver_index, &row_nnz, &row_columns);
 			EidosValue_Float_vector *result_vec = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(subpop1_size);
 			double *result_ptr = result_vec->data();
 			
@@ -4361,7 +4975,7 @@ EidosValue_SP InteractionType::ExecuteMethod_strength(EidosGlobalStringID p_meth
 		else
 		{
 			// Otherwise, individuals1 is singleton, and exerters_value is any length, so we loop over exerters_value
-			// Each individual in exerters_value requires a linear search through the row, unfortunately
+			// Each individual in exerters_value requires a search through the row, which is sorted by column
 			EidosValue_Float_vector *result_vec = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(exerter_count);
 			
 			for (int exerter_index = 0; exerter_index < exerter_count; ++exerter_index)
@@ -4376,14 +4990,7 @@ EidosValue_SP InteractionType::ExecuteMethod_strength(EidosGlobalStringID p_meth
 				if (exerter_index_in_subpop < 0)
 					EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_strength): interactions can only be calculated for individuals that are visible in a subpopulation (i.e., not new juveniles)." << EidosTerminate();
 				
-				double strength = 0;
-				
-				for (uint32_t col_index = 0; col_index < row_nnz; ++col_index)
-					if ((slim_popsize_t)row_columns[col_index] == exerter_index_in_subpop)
-					{
-						strength = strengths[col_index];
-						break;
-					}
+				double strength = sa.Strength(receiver_index, exerter_index_in_subpop);
 				
 				result_vec->set_float_no_check(strength, exerter_index);
 			}
@@ -4509,23 +5116,28 @@ EidosValue_SP InteractionType::ExecuteMethod_totalOfNeighborStrengths(EidosGloba
 	
 	InteractionsData &subpop_data = subpop_data_iter->second;
 	
-	CalculateAllStrengths(subpop);
+	// If the sparse array has not been built, we stream each row as we need it instead of building it; see
+	// StreamInteractionsForRow().  Each row is used once here, so this saves the memory of the whole sparse array.
+	bool streaming = ShouldStreamInteractions(subpop_data);
+	
+	if (!streaming)
+		CalculateAllStrengths(subpop);
 	
 	if (count == 1)
 	{
 		// Just one value, so we can return a singleton and skip some work
-		SparseArray &sa = *subpop_data.dist_str_;
 		slim_popsize_t ind_index_in_subpop = first_ind->index_;
 		
 		if (ind_index_in_subpop < 0)
 			EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_totalOfNeighborStrengths): interactions can only be calculated for individuals that are visible in a subpopulation (i.e., not new juveniles)." << EidosTerminate();
 		
 		// Get the sparse array data
+		SparseArray *sa = (streaming ? StreamInteractionsForRow(subpop, subpop_data, ind_index_in_subpop) : subpop_data.dist_str_);
 		uint32_t row_nnz;
 		const uint32_t *row_columns;
 		const sa_strength_t *strengths;
 		
-		strengths = sa.StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
+		strengths = sa->StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
 		
 		// Total the interaction strengths
 		double total_strength = 0.0;
@@ -4539,7 +5151,16 @@ EidosValue_SP InteractionType::ExecuteMethod_totalOfNeighborStrengths(EidosGloba
 	{
 		// Loop over the requested individuals and get the totals
 		EidosValue_Float_vector *result_vec = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(count);
-		SparseArray &sa = *subpop_data.dist_str_;
+		
+		// Rows of a symmetric sparse array have to be reconstructed, which is slow, so when many are requested we total all of
+		// the rows in a single pass instead; the totals are identical either way.  The threshold is a rough break-even point.
+		std::vector<double> row_totals;
+		
+		if (!streaming && subpop_data.dist_str_->IsSymmetric() && (count >= subpop->parent_subpop_size_ / 16))
+		{
+			row_totals.resize(subpop_data.dist_str_->RowCount());
+			subpop_data.dist_str_->StrengthTotalsForRows(row_totals.data());
+		}
 		
 		for (int ind_index = 0; ind_index < count; ++ind_index)
 		{
@@ -4553,18 +5174,26 @@ EidosValue_SP InteractionType::ExecuteMethod_totalOfNeighborStrengths(EidosGloba
 			if (ind_index_in_subpop < 0)
 				EIDOS_TERMINATION << "ERROR (InteractionType::ExecuteMethod_totalOfNeighborStrengths): interactions can only be calculated for individuals that are visible in a subpopulation (i.e., not new juveniles)." << EidosTerminate();
 			
-			// Get the sparse array data
-			uint32_t row_nnz;
-			const uint32_t *row_columns;
-			const sa_strength_t *strengths;
-			
-			strengths = sa.StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
-			
 			// Total the interaction strengths
 			double total_strength = 0.0;
 			
-			for (uint32_t col_index = 0; col_index < row_nnz; ++col_index)
-				total_strength += strengths[col_index];
+			if (row_totals.size())
+			{
+				total_strength = row_totals[ind_index_in_subpop];
+			}
+			else
+			{
+				// Get the sparse array data
+				SparseArray *sa = (streaming ? StreamInteractionsForRow(subpop, subpop_data, ind_index_in_subpop) : subpop_data.dist_str_);
+				uint32_t row_nnz;
+				const uint32_t *row_columns;
+				const sa_strength_t *strengths;
+				
+				strengths = sa->StrengthsForRow(ind_index_in_subpop, &row_nnz, &row_columns);
+				
+				for (uint32_t col_index = 0; col_index < row_nnz; ++col_index)
+					total_strength += strengths[col_index];
+			}
 			
 			result_vec->set_float_no_check(total_strength, ind_index);
 		}
@@ -4608,6 +5237,7 @@ const std::vector<EidosPropertySignature_CSP> *InteractionType_Class::Properties
 		properties->emplace_back((EidosPropertySignature *)(new EidosPropertySignature(gStr_sexSegregation,	true,	kEidosValueMaskString | kEidosValueMaskSingleton)));
 		properties->emplace_back((EidosPropertySignature *)(new EidosPropertySignature(gStr_spatiality,		true,	kEidosValueMaskString | kEidosValueMaskSingleton)));
 		properties->emplace_back((EidosPropertySignature *)(new EidosPropertySignature(gStr_maxDistance,	false,	kEidosValueMaskFloat | kEidosValueMaskSingleton)));
+		properties->emplace_back((EidosPropertySignature *)(new EidosPropertySignature(gStr_kernelTolerance,	false,	kEidosValueMaskFloat | kEidosValueMaskSingleton)));
 		properties->emplace_back((EidosPropertySignature *)(new EidosPropertySignature(gStr_tag,			false,	kEidosValueMaskInt | kEidosValueMaskSingleton))->DeclareAcceleratedGet(InteractionType::GetProperty_Accelerated_tag));
 		
 		std::sort(properties->begin(), properties->end(), CompareEidosPropertySignatures);
@@ -4663,8 +5293,16 @@ _InteractionsData::_InteractionsData(_InteractionsData&& p_source)
 	kd_node_count_ = p_source.kd_node_count_;
 	positions_ = p_source.positions_;
 	dist_str_ = p_source.dist_str_;
+	streamed_row_ = p_source.streamed_row_;
 	kd_nodes_ = p_source.kd_nodes_;
 	kd_root_ = p_source.kd_root_;
+	grid_cell_count_ = p_source.grid_cell_count_;
+	std::copy(p_source.grid_dim_cells_, p_source.grid_dim_cells_ + SLIM_MAX_DIMENSIONALITY, grid_dim_cells_);
+	std::copy(p_source.grid_origin_, p_source.grid_origin_ + SLIM_MAX_DIMENSIONALITY, grid_origin_);
+	std::copy(p_source.grid_cell_size_, p_source.grid_cell_size_ + SLIM_MAX_DIMENSIONALITY, grid_cell_size_);
+	grid_cell_offsets_ = p_source.grid_cell_offsets_;
+	grid_individuals_ = p_source.grid_individuals_;
+	grid_positions_ = p_source.grid_positions_;
 	
 	p_source.evaluated_ = false;
 	p_source.evaluation_interaction_callbacks_.clear();
@@ -4673,8 +5311,13 @@ _InteractionsData::_InteractionsData(_InteractionsData&& p_source)
 	p_source.kd_node_count_ = 0;
 	p_source.positions_ = nullptr;
 	p_source.dist_str_ = nullptr;
+	p_source.streamed_row_ = nullptr;
 	p_source.kd_nodes_ = nullptr;
 	p_source.kd_root_ = nullptr;
+	p_source.grid_cell_count_ = 0;
+	p_source.grid_cell_offsets_ = nullptr;
+	p_source.grid_individuals_ = nullptr;
+	p_source.grid_positions_ = nullptr;
 }
 
 _InteractionsData& _InteractionsData::operator=(_InteractionsData&& p_source)
@@ -4685,8 +5328,11 @@ _InteractionsData& _InteractionsData::operator=(_InteractionsData&& p_source)
 			free(positions_);
 		if (dist_str_)
 			delete dist_str_;
+		if (streamed_row_)
+			delete streamed_row_;
 		if (kd_nodes_)
 			free(kd_nodes_);
+		FreeCellGrid();
 		
 		evaluated_ = p_source.evaluated_;
 		evaluation_interaction_callbacks_.swap(p_source.evaluation_interaction_callbacks_);
@@ -4695,8 +5341,16 @@ _InteractionsData& _InteractionsData::operator=(_InteractionsData&& p_source)
 		kd_node_count_ = p_source.kd_node_count_;
 		positions_ = p_source.positions_;
 		dist_str_ = p_source.dist_str_;
+		streamed_row_ = p_source.streamed_row_;
 		kd_nodes_ = p_source.kd_nodes_;
 		kd_root_ = p_source.kd_root_;
+		grid_cell_count_ = p_source.grid_cell_count_;
+		std::copy(p_source.grid_dim_cells_, p_source.grid_dim_cells_ + SLIM_MAX_DIMENSIONALITY, grid_dim_cells_);
+		std::copy(p_source.grid_origin_, p_source.grid_origin_ + SLIM_MAX_DIMENSIONALITY, grid_origin_);
+		std::copy(p_source.grid_cell_size_, p_source.grid_cell_size_ + SLIM_MAX_DIMENSIONALITY, grid_cell_size_);
+		grid_cell_offsets_ = p_source.grid_cell_offsets_;
+		grid_individuals_ = p_source.grid_individuals_;
+		grid_positions_ = p_source.grid_positions_;
 		
 		p_source.evaluated_ = false;
 		p_source.evaluation_interaction_callbacks_.clear();
@@ -4705,8 +5359,13 @@ _InteractionsData& _InteractionsData::operator=(_InteractionsData&& p_source)
 		p_source.kd_node_count_ = 0;
 		p_source.positions_ = nullptr;
 		p_source.dist_str_ = nullptr;
+		p_source.streamed_row_ = nullptr;
 		p_source.kd_nodes_ = nullptr;
 		p_source.kd_root_ = nullptr;
+		p_source.grid_cell_count_ = 0;
+		p_source.grid_cell_offsets_ = nullptr;
+		p_source.grid_individuals_ = nullptr;
+		p_source.grid_positions_ = nullptr;
 	}
 	
 	return *this;
@@ -4734,6 +5393,12 @@ _InteractionsData::~_InteractionsData(void)
 		dist_str_ = nullptr;
 	}
 	
+	if (streamed_row_)
+	{
+		delete streamed_row_;
+		streamed_row_ = nullptr;
+	}
+	
 	if (kd_nodes_)
 	{
 		free(kd_nodes_);
@@ -4742,10 +5407,35 @@ _InteractionsData::~_InteractionsData(void)
 	
 	kd_root_ = nullptr;
 	
+	FreeCellGrid();
+	
 	// Unnecessary since it's about to be destroyed anyway
 	//evaluation_interaction_callbacks_.clear();
 }
 
+void _InteractionsData::FreeCellGrid(void)
+{
+	if (grid_cell_offsets_)
+	{
+		free(grid_cell_offsets_);
+		grid_cell_offsets_ = nullptr;
+	}
+	
+	if (grid_individuals_)
+	{
+		free(grid_individuals_);
+		grid_individuals_ = nullptr;
+	}
+	
+	if (grid_positions_)
+	{
+		free(grid_positions_);
+		grid_positions_ = nullptr;
+	}
+	
+	grid_cell_count_ = 0;
+}
+
 
 
 
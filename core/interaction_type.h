@@ -77,6 +77,15 @@ struct _SLiM_kdNode
 };
 typedef struct _SLiM_kdNode SLiM_kdNode;
 
+// As an alternative to the k-d tree, the interacting pairs for the sparse array can be found with a uniform grid of cells (a
+// "cell list") laid over the exerters.  Every cell is at least max_distance_ wide in every dimension, so all of the exerters
+// within the interaction distance of a receiver lie in the receiver's own cell or in an adjacent cell.  Building the grid is
+// O(N), with a counting sort, and scanning a cell is a linear pass through memory, so for large, fairly uniformly distributed
+// populations with a small maximum distance relative to their extent, the grid is considerably faster than the k-d tree.
+// The grid is used when the number of exerters is at least SLIM_CELL_GRID_MIN_EXERTERS; it is never used for neighbor
+// searches, which use the k-d tree, and since the sparse array sorts its rows the results are identical either way.
+#define SLIM_CELL_GRID_MIN_EXERTERS		256
+
 struct _InteractionsData
 {
 	// This flag is true when the interaction has been evaluated.  What that means in practice is that allocated blocks below
@@ -94,15 +103,24 @@ struct _InteractionsData
 	
 	slim_popsize_t individual_count_ = 0;	// the number of individuals managed; this will be equal to the size of the corresponding subpopulation
 	slim_popsize_t first_male_index_ = 0;	// from the subpopulation's value; needed for sex-segregation handling
-	slim_popsize_t kd_node_count_ = 0;		// the number of entries in the k-d tree; may be a multiple of individual_count_ due to periodicity
+	slim_popsize_t kd_node_count_ = 0;		// the number of entries in the k-d tree; with periodicity, individual_count_ plus the replicates within max_distance_ of the bounds
 	
-	double bounds_x1_, bounds_y1_, bounds_z1_;	// copied from the Subpopulation; the zero-bound in each dimension is guaranteed to be zero *if* the dimension is periodic
+	double bounds_x1_ = 0.0, bounds_y1_ = 0.0, bounds_z1_ = 0.0;	// copied from the Subpopulation; the zero-bound in each dimension is guaranteed to be zero *if* the dimension is periodic
 	
 	double *positions_ = nullptr;			// individual_count_ * SLIM_MAX_DIMENSIONALITY entries, holding coordinate positions
 	SparseArray *dist_str_ = nullptr;		// a sparse array of interaction distances/strengths between individuals, individual_count_ x individual_count_
-	SLiM_kdNode *kd_nodes_ = nullptr;		// individual_count_ entries, holding the nodes of the k-d tree
+	SparseArray *streamed_row_ = nullptr;	// a sparse array holding a single streamed row; see InteractionType::StreamInteractionsForRow()
+	SLiM_kdNode *kd_nodes_ = nullptr;		// kd_node_count_ entries, holding the nodes of the k-d tree
 	SLiM_kdNode *kd_root_ = nullptr;		// the root of the k-d tree
 	
+	int64_t grid_cell_count_ = 0;								// the total number of cells in the cell grid; zero if it has not been built
+	int grid_dim_cells_[SLIM_MAX_DIMENSIONALITY];				// the number of grid cells along each dimension
+	double grid_origin_[SLIM_MAX_DIMENSIONALITY];				// the coordinate of the low edge of the grid in each dimension
+	double grid_cell_size_[SLIM_MAX_DIMENSIONALITY];			// the width of a grid cell in each dimension; never less than max_distance_
+	uint32_t *grid_cell_offsets_ = nullptr;		// grid_cell_count_ + 1 entries; the entries for cell c are at [offsets[c], offsets[c + 1])
+	uint32_t *grid_individuals_ = nullptr;		// the individual index of each exerter, grouped by cell, ascending within each cell
+	double *grid_positions_ = nullptr;			// the coordinates of each exerter, in the same order, with spatiality_ values per entry
+	
 	_InteractionsData(const _InteractionsData&) = delete;					// no copying
 	_InteractionsData& operator=(const _InteractionsData&) = delete;		// no copying
 	_InteractionsData(_InteractionsData&&);									// move constructor, for std::map compatibility
@@ -111,6 +129,8 @@ struct _InteractionsData
 	
 	_InteractionsData(slim_popsize_t p_individual_count, slim_popsize_t p_first_male_index);
 	~_InteractionsData(void);
+	
+	void FreeCellGrid(void);
 };
 typedef struct _InteractionsData InteractionsData;
 
@@ -145,6 +165,10 @@ private:
 	IFType if_type_;							// the interaction function (IF) to use
 	double if_param1_, if_param2_;				// the parameters for that IF (not all of which may be used)
 	
+	double kernel_tolerance_ = 0.0;				// if > 0, the IF is interpolated from kernel_table_, with an error of at most this
+	std::vector<double> kernel_table_;			// the IF at equally spaced distances over [0, max_distance_], plus one padding entry; empty if unused
+	double kernel_table_scale_ = 0.0;			// the number of table intervals per unit distance
+	
 	bool periodic_x_ = false;					// true if this spatial coordinate is periodic, from SLiMSim
 	bool periodic_y_ = false;					// these are in terms of the InteractionType's spatiality, not the simulation's dimensionality!
 	bool periodic_z_ = false;
@@ -153,10 +177,19 @@ private:
 	
 	void CalculateAllDistances(Subpopulation *p_subpop);
 	void CalculateAllStrengths(Subpopulation *p_subpop);
+	void CalculateRowStrengthsNoCallbacks(const sa_distance_t * __restrict__ p_distances, sa_strength_t * __restrict__ p_strengths, uint32_t p_count);
+	
+	// Streaming evaluation: methods that reduce each receiver's row to a result, such as totalOfNeighborStrengths() and
+	// drawByStrength(), can calculate the rows they need one at a time, discarding each after use, rather than building the
+	// whole sparse array.  Memory usage is then bounded by the size of the largest row, rather than by the number of pairs.
+	// This is not done for fully reciprocal interactions, whose symmetric sparse array calculates each pair only once.
+	bool ShouldStreamInteractions(InteractionsData &p_subpop_data);
+	SparseArray *StreamInteractionsForRow(Subpopulation *p_subpop, InteractionsData &p_subpop_data, slim_popsize_t p_row);
 	
 	double CalculateDistance(double *p_position1, double *p_position2);
 	double CalculateDistanceWithPeriodicity(double *p_position1, double *p_position2, InteractionsData &p_subpop_data);
 	
+	void CacheKernelTable(void);
 	double CalculateStrengthNoCallbacks(double p_distance);
 	double CalculateStrengthWithCallbacks(double p_distance, Individual *p_receiver, Individual *p_exerter, Subpopulation *p_subpop, std::vector<SLiMEidosBlock*> &p_interaction_callbacks);
 	
@@ -171,6 +204,9 @@ private:
 	SLiM_kdNode *MakeKDTree3_p2(SLiM_kdNode *t, int len);
 	void EnsureKDTreePresent(InteractionsData &p_subpop_data);
 	
+	bool ShouldUseCellGrid(int p_exerter_count);
+	void EnsureCellGridPresent(InteractionsData &p_subpop_data, int start_exerter, int after_end_exerter);
+	
 	int CheckKDTree1_p0(SLiM_kdNode *t);
 	void CheckKDTree1_p0_r(SLiM_kdNode *t, double split, bool isLeftSubtree);
 	int CheckKDTree2_p0(SLiM_kdNode *t);
@@ -190,6 +226,9 @@ private:
 	void BuildSA_SS_1(SLiM_kdNode *root, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, int start_exerter, int after_end_exerter);
 	void BuildSA_SS_2(SLiM_kdNode *root, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, int start_exerter, int after_end_exerter, int p_phase);
 	void BuildSA_SS_3(SLiM_kdNode *root, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, int start_exerter, int after_end_exerter, int p_phase);
+	void BuildSA_Grid_1(InteractionsData &p_subpop_data, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, uint32_t p_first_exerter);
+	void BuildSA_Grid_2(InteractionsData &p_subpop_data, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, uint32_t p_first_exerter);
+	void BuildSA_Grid_3(InteractionsData &p_subpop_data, double *nd, slim_popsize_t p_focal_individual_index, SparseArray *p_sparse_array, uint32_t p_first_exerter);
 	
 	void FindNeighbors1_1(SLiM_kdNode *root, double *nd, slim_popsize_t p_focal_individual_index, SLiM_kdNode **best, double *best_dist);
 	void FindNeighbors1_2(SLiM_kdNode *root, double *nd, slim_popsize_t p_focal_individual_index, SLiM_kdNode **best, double *best_dist, int p_phase);
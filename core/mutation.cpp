@@ -27,6 +27,15 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <limits>
+
+#if defined(__APPLE__) || defined(__unix__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define SLIM_MUTATION_BLOCK_RESERVE	1
+#else
+#define SLIM_MUTATION_BLOCK_RESERVE	0
+#endif
 
 
 // All Mutation objects get allocated out of a single shared block, for speed; see SLiM_WarmUp()
@@ -36,19 +45,86 @@ MutationIndex gSLiM_Mutation_FreeIndex = -1;
 MutationIndex gSLiM_Mutation_Block_LastUsedIndex = -1;
 
 slim_refcount_t *gSLiM_Mutation_Refcounts = nullptr;
+MutationFitnessCache *gSLiM_Mutation_FitnessCaches = nullptr;
+static_assert(sizeof(MutationFitnessCache) == 24, "MutationFitnessCache has changed size; the comment on its declaration needs to be updated");
 
 #define SLIM_MUTATION_BLOCK_INITIAL_SIZE	16384		// makes for about a 1 MB block; not unreasonable
+#define SLIM_MUTATION_BLOCK_MAXIMUM_SIZE	(std::numeric_limits<MutationIndex>::max())
 
 extern std::vector<EidosValue_Object *> gEidosValue_Object_Mutation_Registry;	// this is in Eidos; see SLiM_IncreaseMutationBlockCapacity()
 
+#if SLIM_MUTATION_BLOCK_RESERVE
+// Where possible, the mutation block and its parallel buffers are not malloced; instead, address space for their
+// maximum possible size is reserved up front with mmap(), and pages are made usable with mprotect() as the block
+// grows.  The block therefore never moves, so growing it never copies Mutation objects, never transiently needs
+// memory for both the old and new blocks, and never requires the pointer patching in SLiM_IncreaseMutationBlockCapacity().
+// Reserving address space costs no memory; it can fail, however (on 32-bit platforms, or under a ulimit on virtual
+// memory), in which case we fall back to malloc/realloc as before.
+static bool gSLiM_Mutation_Block_Reserved = false;
+
+static void *SLiM_ReserveAddressSpace(size_t p_bytes)
+{
+	void *result = mmap(nullptr, p_bytes, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+	
+	return (result == MAP_FAILED) ? nullptr : result;
+}
+
+static bool SLiM_CommitAddressSpace(void *p_base, size_t p_bytes)
+{
+	static size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+	size_t commit_bytes = ((p_bytes + page_size - 1) / page_size) * page_size;
+	
+	return (mprotect(p_base, commit_bytes, PROT_READ | PROT_WRITE) == 0);
+}
+
+static bool SLiM_ReserveMutationBlock(void)
+{
+	if (sizeof(void *) < 8)
+		return false;
+	
+	size_t max_capacity = (size_t)SLIM_MUTATION_BLOCK_MAXIMUM_SIZE;
+	size_t block_bytes = max_capacity * sizeof(Mutation);
+	size_t refcount_bytes = max_capacity * sizeof(slim_refcount_t);
+	size_t cache_bytes = max_capacity * sizeof(MutationFitnessCache);
+	void *block = SLiM_ReserveAddressSpace(block_bytes);
+	void *refcounts = SLiM_ReserveAddressSpace(refcount_bytes);
+	void *caches = SLiM_ReserveAddressSpace(cache_bytes);
+	
+	if (block && refcounts && caches &&
+		SLiM_CommitAddressSpace(block, gSLiM_Mutation_Block_Capacity * sizeof(Mutation)) &&
+		SLiM_CommitAddressSpace(refcounts, gSLiM_Mutation_Block_Capacity * sizeof(slim_refcount_t)) &&
+		SLiM_CommitAddressSpace(caches, gSLiM_Mutation_Block_Capacity * sizeof(MutationFitnessCache)))
+	{
+		gSLiM_Mutation_Block = (Mutation *)block;
+		gSLiM_Mutation_Refcounts = (slim_refcount_t *)refcounts;
+		gSLiM_Mutation_FitnessCaches = (MutationFitnessCache *)caches;
+		return true;
+	}
+	
+	if (block) munmap(block, block_bytes);
+	if (refcounts) munmap(refcounts, refcount_bytes);
+	if (caches) munmap(caches, cache_bytes);
+	return false;
+}
+#endif
+
 void SLiM_CreateMutationBlock(void)
 {
 	// first allocate the block; no need to zero the memory
 	gSLiM_Mutation_Block_Capacity = SLIM_MUTATION_BLOCK_INITIAL_SIZE;
-	gSLiM_Mutation_Block = (Mutation *)malloc(gSLiM_Mutation_Block_Capacity * sizeof(Mutation));
-	gSLiM_Mutation_Refcounts = (slim_refcount_t *)malloc(gSLiM_Mutation_Block_Capacity * sizeof(slim_refcount_t));
 	
-	if (!gSLiM_Mutation_Block || !gSLiM_Mutation_Refcounts)
+#if SLIM_MUTATION_BLOCK_RESERVE
+	gSLiM_Mutation_Block_Reserved = SLiM_ReserveMutationBlock();
+	
+	if (!gSLiM_Mutation_Block_Reserved)
+#endif
+	{
+		gSLiM_Mutation_Block = (Mutation *)malloc(gSLiM_Mutation_Block_Capacity * sizeof(Mutation));
+		gSLiM_Mutation_Refcounts = (slim_refcount_t *)malloc(gSLiM_Mutation_Block_Capacity * sizeof(slim_refcount_t));
+		gSLiM_Mutation_FitnessCaches = (MutationFitnessCache *)malloc(gSLiM_Mutation_Block_Capacity * sizeof(MutationFitnessCache));
+	}
+	
+	if (!gSLiM_Mutation_Block || !gSLiM_Mutation_Refcounts || !gSLiM_Mutation_FitnessCaches)
 		EIDOS_TERMINATION << "ERROR (SLiM_CreateMutationBlock): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
 	
 	//std::cout << "Allocating initial mutation block, " << SLIM_MUTATION_BLOCK_INITIAL_SIZE * sizeof(Mutation) << " bytes (sizeof(Mutation) == " << sizeof(Mutation) << ")" << std::endl;
@@ -68,7 +144,38 @@ void SLiM_IncreaseMutationBlockCapacity(void)
 	if (!gSLiM_Mutation_Block)
 		EIDOS_TERMINATION << "ERROR (SLiM_IncreaseMutationBlockCapacity): (internal error) called before SLiM_CreateMutationBlock()." << EidosTerminate();
 	
-	// We need to expand the size of our Mutation block.  This has the consequence of invalidating
+	// MutationIndex is 32-bit (see mutation.h), so the block cannot grow past INT32_MAX entries; rather than overflowing
+	// gSLiM_Mutation_Block_Capacity, we cap the last doubling at that limit, and then give a clear error if it is reached.
+	if (gSLiM_Mutation_Block_Capacity == SLIM_MUTATION_BLOCK_MAXIMUM_SIZE)
+		EIDOS_TERMINATION << "ERROR (SLiM_IncreaseMutationBlockCapacity): the maximum number of mutations that can exist simultaneously (" << SLIM_MUTATION_BLOCK_MAXIMUM_SIZE << ") has been reached." << EidosTerminate(nullptr);
+	
+	MutationIndex old_block_capacity = gSLiM_Mutation_Block_Capacity;
+	
+	if (gSLiM_Mutation_Block_Capacity > SLIM_MUTATION_BLOCK_MAXIMUM_SIZE / 2)
+		gSLiM_Mutation_Block_Capacity = SLIM_MUTATION_BLOCK_MAXIMUM_SIZE;
+	else
+		gSLiM_Mutation_Block_Capacity *= 2;
+	
+#if SLIM_MUTATION_BLOCK_RESERVE
+	if (gSLiM_Mutation_Block_Reserved)
+	{
+		// The block is in reserved address space, so it just needs more of its pages made usable; it does not move
+		if (!SLiM_CommitAddressSpace(gSLiM_Mutation_Block, gSLiM_Mutation_Block_Capacity * sizeof(Mutation)) ||
+			!SLiM_CommitAddressSpace(gSLiM_Mutation_Refcounts, gSLiM_Mutation_Block_Capacity * sizeof(slim_refcount_t)) ||
+			!SLiM_CommitAddressSpace(gSLiM_Mutation_FitnessCaches, gSLiM_Mutation_Block_Capacity * sizeof(MutationFitnessCache)))
+			EIDOS_TERMINATION << "ERROR (SLiM_IncreaseMutationBlockCapacity): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
+		
+		for (MutationIndex i = old_block_capacity; i < gSLiM_Mutation_Block_Capacity - 1; ++i)
+			*(MutationIndex *)(gSLiM_Mutation_Block + i) = i + 1;
+		
+		*(MutationIndex *)(gSLiM_Mutation_Block + gSLiM_Mutation_Block_Capacity - 1) = gSLiM_Mutation_FreeIndex;
+		
+		gSLiM_Mutation_FreeIndex = old_block_capacity;
+		return;
+	}
+#endif
+	
+	// Otherwise, we need to realloc our Mutation block.  This has the consequence of invalidating
 	// every Mutation * in the program.  In general that is fine; we are careful to only keep
 	// pointers to Mutation temporarily, and for long-term reference we use MutationIndex.  The
 	// exception to this is EidosValue_Object; the user can put references to mutations into
@@ -85,13 +192,12 @@ void SLiM_IncreaseMutationBlockCapacity(void)
 	// Mutation is non-trivially copyable according to C++.  But it is safe, so I cast to void*
 	// in the hopes that that will make the warning go away.
 	std::uintptr_t old_mutation_block = reinterpret_cast<std::uintptr_t>(gSLiM_Mutation_Block);
-	MutationIndex old_block_capacity = gSLiM_Mutation_Block_Capacity;
 	
-	gSLiM_Mutation_Block_Capacity *= 2;
 	gSLiM_Mutation_Block = (Mutation *)realloc((void*)gSLiM_Mutation_Block, gSLiM_Mutation_Block_Capacity * sizeof(Mutation));
 	gSLiM_Mutation_Refcounts = (slim_refcount_t *)realloc(gSLiM_Mutation_Refcounts, gSLiM_Mutation_Block_Capacity * sizeof(slim_refcount_t));
+	gSLiM_Mutation_FitnessCaches = (MutationFitnessCache *)realloc(gSLiM_Mutation_FitnessCaches, gSLiM_Mutation_Block_Capacity * sizeof(MutationFitnessCache));
 	
-	if (!gSLiM_Mutation_Block || !gSLiM_Mutation_Refcounts)
+	if (!gSLiM_Mutation_Block || !gSLiM_Mutation_Refcounts || !gSLiM_Mutation_FitnessCaches)
 		EIDOS_TERMINATION << "ERROR (SLiM_IncreaseMutationBlockCapacity): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
 	
 	std::uintptr_t new_mutation_block = reinterpret_cast<std::uintptr_t>(gSLiM_Mutation_Block);
@@ -171,7 +277,8 @@ void SLiM_ZeroRefcountBlock(__attribute__((unused)) MutationRun &p_mutation_regi
 
 size_t SLiM_MemoryUsageForMutationBlock(void)
 {
-	return gSLiM_Mutation_Block_Capacity * sizeof(Mutation);
+	// the fitness cache buffer is counted here, since its values are logically part of each Mutation
+	return gSLiM_Mutation_Block_Capacity * (sizeof(Mutation) + sizeof(MutationFitnessCache));
 }
 
 size_t SLiM_MemoryUsageForMutationRefcounts(void)
@@ -194,9 +301,7 @@ mutation_type_ptr_(p_mutation_type_ptr), position_(p_position), selection_coeff_
 	tag_value_ = SLIM_TAG_UNSET_VALUE;
 	
 	// cache values used by the fitness calculation code for speed; see header
-	cached_one_plus_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + selection_coeff_);
-	cached_one_plus_dom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->dominance_coeff_ * selection_coeff_);
-	cached_one_plus_haploiddom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->haploid_dominance_coeff_ * selection_coeff_);
+	CacheFitnessValues();
 	
 	// zero out our refcount, which is now kept in a separate buffer
 	gSLiM_Mutation_Refcounts[BlockIndex()] = 0;
@@ -222,9 +327,6 @@ mutation_type_ptr_(p_mutation_type_ptr), position_(p_position), selection_coeff_
 		char *ptr_scratch_ = (char *)&(this->scratch_);
 		char *ptr_mutation_id_ = (char *)&(this->mutation_id_);
 		char *ptr_tag_value_ = (char *)&(this->tag_value_);
-		char *ptr_cached_one_plus_sel_ = (char *)&(this->cached_one_plus_sel_);
-		char *ptr_cached_one_plus_dom_sel_ = (char *)&(this->cached_one_plus_dom_sel_);
-		char *ptr_cached_one_plus_haploiddom_sel_ = (char *)&(this->cached_one_plus_haploiddom_sel_);
 		
 		std::cout << "Class Mutation memory layout (sizeof(Mutation) == " << sizeof(Mutation) << ") :" << std::endl << std::endl;
 		std::cout << "   " << (ptr_mutation_type_ptr_ - ptr_base) << " (" << sizeof(MutationType *) << " bytes): MutationType *mutation_type_ptr_" << std::endl;
@@ -237,9 +339,6 @@ mutation_type_ptr_(p_mutation_type_ptr), position_(p_position), selection_coeff_
 		std::cout << "   " << (ptr_scratch_ - ptr_base) << " (" << sizeof(int8_t) << " bytes): const int8_t scratch_" << std::endl;
 		std::cout << "   " << (ptr_mutation_id_ - ptr_base) << " (" << sizeof(slim_mutationid_t) << " bytes): const slim_mutationid_t mutation_id_" << std::endl;
 		std::cout << "   " << (ptr_tag_value_ - ptr_base) << " (" << sizeof(slim_usertag_t) << " bytes): slim_usertag_t tag_value_" << std::endl;
-		std::cout << "   " << (ptr_cached_one_plus_sel_ - ptr_base) << " (" << sizeof(slim_selcoeff_t) << " bytes): slim_selcoeff_t cached_one_plus_sel_" << std::endl;
-		std::cout << "   " << (ptr_cached_one_plus_dom_sel_ - ptr_base) << " (" << sizeof(slim_selcoeff_t) << " bytes): slim_selcoeff_t cached_one_plus_dom_sel_" << std::endl;
-		std::cout << "   " << (ptr_cached_one_plus_haploiddom_sel_ - ptr_base) << " (" << sizeof(slim_selcoeff_t) << " bytes): slim_selcoeff_t cached_one_plus_haploiddom_sel_" << std::endl;
 		std::cout << std::endl;
 		
 		been_here = true;
@@ -254,9 +353,7 @@ mutation_type_ptr_(p_mutation_type_ptr), position_(p_position), selection_coeff_
 	tag_value_ = SLIM_TAG_UNSET_VALUE;
 	
 	// cache values used by the fitness calculation code for speed; see header
-	cached_one_plus_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + selection_coeff_);
-	cached_one_plus_dom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->dominance_coeff_ * selection_coeff_);
-	cached_one_plus_haploiddom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->haploid_dominance_coeff_ * selection_coeff_);
+	CacheFitnessValues();
 	
 	// zero out our refcount, which is now kept in a separate buffer
 	gSLiM_Mutation_Refcounts[BlockIndex()] = 0;
@@ -270,6 +367,17 @@ mutation_type_ptr_(p_mutation_type_ptr), position_(p_position), selection_coeff_
 		gSLiM_next_mutation_id = mutation_id_ + 1;
 }
 
+void Mutation::CacheFitnessValues(void)
+{
+	MutationFitnessCache *cache = FitnessCache();
+	
+	cache->position_ = position_;
+	cache->selection_coeff_ = selection_coeff_;
+	cache->cached_one_plus_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + selection_coeff_);
+	cache->cached_one_plus_dom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->dominance_coeff_ * selection_coeff_);
+	cache->cached_one_plus_haploiddom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->haploid_dominance_coeff_ * selection_coeff_);
+}
+
 void Mutation::SelfDelete(void)
 {
 	// This is called when our retain count reaches zero
@@ -684,9 +792,7 @@ EidosValue_SP Mutation::ExecuteMethod_setSelectionCoeff(EidosGlobalStringID p_me
 	}
 	
 	// cache values used by the fitness calculation code for speed; see header
-	cached_one_plus_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + selection_coeff_);
-	cached_one_plus_dom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->dominance_coeff_ * selection_coeff_);
-	cached_one_plus_haploiddom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->haploid_dominance_coeff_ * selection_coeff_);
+	CacheFitnessValues();
 	
 	return gStaticEidosValueVOID;
 }
@@ -712,9 +818,7 @@ EidosValue_SP Mutation::ExecuteMethod_setMutationType(EidosGlobalStringID p_meth
 		mutation_type_ptr_->all_pure_neutral_DFE_ = false;
 	
 	// cache values used by the fitness calculation code for speed; see header
-	cached_one_plus_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + selection_coeff_);
-	cached_one_plus_dom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->dominance_coeff_ * selection_coeff_);
-	cached_one_plus_haploiddom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + mutation_type_ptr_->haploid_dominance_coeff_ * selection_coeff_);
+	CacheFitnessValues();
 	
 	return gStaticEidosValueVOID;
 }
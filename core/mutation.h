@@ -49,12 +49,35 @@ extern slim_mutationid_t gSLiM_next_mutation_id;
 // safeguards in the code to check for running out of indices, so doing that is quite dangerous at present.  A way to make
 // simulations switch from 16-bit to 32-bit at runtime, to get that speedup when possible, would be nice but in practice is very
 // difficult to code since MutationRun's internal buffer of MutationIndex is accessible and used directly by many clients.
+// Conversely, going to 64-bit would lift the limit of INT32_MAX simultaneously live mutations, but would double the size of
+// every mutation run and slow down every merge and tally loop, to benefit only models far larger than any seen in practice;
+// SLiM_IncreaseMutationBlockCapacity() gives a clear error if the limit is reached, rather than overflowing.
 typedef int32_t MutationIndex;
 
 // forward declaration of Mutation block allocation; see bottom of header
 class Mutation;
 extern Mutation *gSLiM_Mutation_Block;
 
+// The values read by the core fitness loops and by the nonneutral caching code are kept in an auxiliary buffer, parallel to
+// gSLiM_Mutation_Block, so that those loops never need to touch the (much larger) Mutation objects themselves.  Each record is
+// 24 bytes (an 8-byte position and four 4-byte floats), so a 64-byte cache line holds about 2.7 records, and some records
+// straddle two lines; that is still far denser than the Mutation objects, each of which spans more than one line.  The
+// cached fitness effects are those of the mutation when it is homozygous, heterozygous, or in a haploid genome, respectively.
+// They are clamped to a minimum of 0.0, so that multiplying by them cannot cause the fitness of the individual to go below
+// 0.0, avoiding slow tests in the core fitness loop.  These values use slim_selcoeff_t for speed; roundoff should not be a
+// concern, since such differences would be inconsequential.  The position and selection coefficient here mirror those in
+// Mutation, which remain authoritative; they are kept in sync by Mutation::CacheFitnessValues() and
+// Population::ValidateMutationFitnessCaches().
+typedef struct {
+	slim_position_t position_;							// a copy of Mutation::position_, for merging genomes
+	slim_selcoeff_t selection_coeff_;					// a copy of Mutation::selection_coeff_, for neutrality checks
+	slim_selcoeff_t cached_one_plus_sel_;				// a cached value for (1 + selection_coeff_), clamped to 0.0 minimum
+	slim_selcoeff_t cached_one_plus_dom_sel_;			// a cached value for (1 + dominance_coeff * selection_coeff_), clamped to 0.0 minimum
+	slim_selcoeff_t cached_one_plus_haploiddom_sel_;	// a cached value for (1 + haploid_dominance_coeff * selection_coeff_), clamped to 0.0 minimum
+} MutationFitnessCache;
+
+extern MutationFitnessCache *gSLiM_Mutation_FitnessCaches;
+
 
 typedef enum {
 	kNewMutation = 0,			// the state after new Mutation()
@@ -90,14 +113,7 @@ public:
 	mutable slim_refcount_t gui_scratch_reference_count_;	// an additional refcount used for temporary tallies by SLiMgui, valid only when explicitly updated
 #endif
 	
-	// We cache values used in the fitness calculation code, for speed.  These are the final fitness effects of this mutation
-	// when it is homozygous or heterozygous, respectively.  These values are clamped to a minimum of 0.0, so that multiplying
-	// by them cannot cause the fitness of the individual to go below 0.0, avoiding slow tests in the core fitness loop.  These
-	// values use slim_selcoeff_t for speed; roundoff should not be a concern, since such differences would be inconsequential.
-	slim_selcoeff_t cached_one_plus_sel_;				// a cached value for (1 + selection_coeff_), clamped to 0.0 minimum
-	slim_selcoeff_t cached_one_plus_dom_sel_;			// a cached value for (1 + dominance_coeff * selection_coeff_), clamped to 0.0 minimum
-	slim_selcoeff_t cached_one_plus_haploiddom_sel_;	// a cached value for (1 + haploid_dominance_coeff * selection_coeff_), clamped to 0.0 minimum
-	// NOTE THERE ARE 4 BYTES FREE IN THE CLASS LAYOUT HERE; see Mutation::Mutation() and Mutation layout.graffle
+	// the values used by the fitness calculation code are cached in gSLiM_Mutation_FitnessCaches, not here; see top of header
 	
 	Mutation(const Mutation&) = delete;					// no copying
 	Mutation& operator=(const Mutation&) = delete;		// no copying
@@ -118,6 +134,9 @@ public:
 	virtual void SelfDelete(void) override;
 	
 	inline __attribute__((always_inline)) MutationIndex BlockIndex(void) const			{ return (MutationIndex)(this - gSLiM_Mutation_Block); }
+	inline __attribute__((always_inline)) MutationFitnessCache *FitnessCache(void) const	{ return gSLiM_Mutation_FitnessCaches + BlockIndex(); }
+	
+	void CacheFitnessValues(void);						// recache our entry in gSLiM_Mutation_FitnessCaches after a change in selection_coeff_ or mutation_type_ptr_
 	
 	//
 	// Eidos support
@@ -197,7 +216,8 @@ extern MutationIndex gSLiM_Mutation_FreeIndex;
 extern MutationIndex gSLiM_Mutation_Block_LastUsedIndex;
 
 extern slim_refcount_t *gSLiM_Mutation_Refcounts;	// an auxiliary buffer, parallel to gSLiM_Mutation_Block, to increase memory cache efficiency
-													// note that I tried keeping the fitness cache values and positions in separate buffers too, not a win
+													// note that I tried keeping the fitness cache values and positions in separate buffers too, not a win;
+													// gSLiM_Mutation_FitnessCaches (see top of header) instead keeps all of them in a single record
 void SLiM_CreateMutationBlock(void);
 void SLiM_IncreaseMutationBlockCapacity(void);
 void SLiM_ZeroRefcountBlock(MutationRun &p_mutation_registry);
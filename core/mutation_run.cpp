@@ -470,14 +470,14 @@ void MutationRun::cache_nonneutral_mutations_REGIME_1()
 	//
 	zero_out_nonneutral_buffer();
 	
-	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 	
 	// loop through mutations and copy the non-neutral ones into our buffer, resizing as needed
 	for (int32_t bufindex = 0; bufindex < mutation_count_; ++bufindex)
 	{
 		MutationIndex mutindex = mutations_[bufindex];
 		
-		if ((mut_block_ptr + mutindex)->selection_coeff_ != 0.0)
+		if ((mut_cache_ptr + mutindex)->selection_coeff_ != 0.0)
 			add_to_nonneutral_buffer(mutindex);
 	}
 }
@@ -523,16 +523,46 @@ void MutationRun::cache_nonneutral_mutations_REGIME_3()
 	zero_out_nonneutral_buffer();
 	
 	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 	
 	// loop through mutations and copy the non-neutral ones into our buffer, resizing as needed
 	for (int32_t bufindex = 0; bufindex < mutation_count_; ++bufindex)
 	{
 		MutationIndex mutindex = mutations_[bufindex];
-		Mutation *mutptr = mut_block_ptr + mutindex;
 		
 		// The result of || is not order-dependent, but the first condition is checked first.
 		// I have reordered this to put the fast test first; or I'm guessing it's the fast test.
-		if ((mutptr->selection_coeff_ != 0.0) || (mutptr->mutation_type_ptr_->subject_to_fitness_callback_))
+		// The fast test reads only the fitness cache; the Mutation itself is touched only if it is neutral.
+		if (((mut_cache_ptr + mutindex)->selection_coeff_ != 0.0) || ((mut_block_ptr + mutindex)->mutation_type_ptr_->subject_to_fitness_callback_))
+			add_to_nonneutral_buffer(mutindex);
+	}
+}
+
+void MutationRun::cache_nonneutral_mutations_REGIME_4()
+{
+	//
+	//	Regime 4 is a mix of regimes 2 and 3: there are constant neutral global callbacks, as in
+	//	regime 2, but also other callbacks, all of which are "well-behaved" – they do not use the
+	//	active property, lambdas (executeLambda(), apply(), etc.), register/reschedule/deregister
+	//	calls, or user-defined functions, so they cannot change which callbacks are active in the
+	//	middle of fitness evaluation.  A mutation is therefore neutral if its type is made neutral
+	//	by an active constant callback, and non-neutral if its type is subject to any other
+	//	callback; otherwise selection_coeff_ is reliable as usual.  Both flags are set up by
+	//	RecalculateFitness().
+	//
+	zero_out_nonneutral_buffer();
+	
+	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
+	
+	// loop through mutations and copy the non-neutral ones into our buffer, resizing as needed
+	for (int32_t bufindex = 0; bufindex < mutation_count_; ++bufindex)
+	{
+		MutationIndex mutindex = mutations_[bufindex];
+		MutationType *muttype = (mut_block_ptr + mutindex)->mutation_type_ptr_;
+		
+		// RecalculateFitness() guarantees that the two flags are never both set for one muttype
+		if (muttype->subject_to_fitness_callback_ || ((!muttype->set_neutral_by_global_active_callback_) && ((mut_cache_ptr + mutindex)->selection_coeff_ != 0.0)))
 			add_to_nonneutral_buffer(mutindex);
 	}
 }
@@ -546,7 +576,7 @@ void MutationRun::check_nonneutral_mutation_cache()
 	if (nonneutral_mutations_count_ > nonneutral_mutation_capacity_)
 		EIDOS_TERMINATION << "ERROR (MutationRun::check_nonneutral_mutation_cache): (internal error) cache size exceeds cache capacity." << EidosTerminate();
 	
-	// Check for correctness in regime 1.  Now that we have three regimes, this isn't really worth maintaining;
+	// Check for correctness in regime 1.  Now that we have four regimes, this isn't really worth maintaining;
 	// it really just replicates the above logic exactly, so it is not a very effective cross-check.
 	
 	/*
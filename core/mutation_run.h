@@ -107,7 +107,7 @@ private:
 	// the mutation run changes, the cache needs to be invalidated.  Second, if the external information that the
 	// cache relies upon changes, the cache needs to be invalidated.  That external information consists of (a) the
 	// selection coefficients of mutations, and (b) the existence and state of fitness() callbacks.  There are
-	// three separate regimes in which these caches are used:
+	// four separate regimes in which these caches are used:
 	//
 	//	1. No fitness callbacks defined.  Here caches depend solely upon mutation selection coefficients, and can
 	//		be carried forward through generations with impunity.  If any mutation's selcoeff is changed between
@@ -127,12 +127,14 @@ private:
 	//		callbacks, with respect to which mutation types are influenced by them, is unchanged.  If a callback
 	//		change is detected by RecalculateFitness(), it sets the global all-invalid flag.
 	//
-	//	(FIXME) One could imagine inserting a regime between 2 and 3 that would allow a mix of constant and
-	//		non-constant callbacks, as long as the non-constant callbacks were "well-behaved" – no use of the
-	//		active property, no executeLambda, etc. – so that SLiM could know that the constant callbacks would
-	//		apply if they were active.  This could be pretty useful for models that have a mix of QTLs (using
-	//		a constant neutral callbacks) and other loci that are governed by fitness callbacks.  This strikes
-	//		me as a pretty edge case, though; mostly models are either QTL models or non-QTL models, I think.
+	//	4. A mix of constant neutral global callbacks and other callbacks, where all of the other callbacks are
+	//		"well-behaved": they do not use the active property, executeLambda(), source(), register/reschedule/
+	//		deregister calls, or user-defined functions, as determined conservatively by the script block's
+	//		identifier scan (may_alter_script_blocks_).  Since no callback can then change which callbacks are
+	//		active during fitness evaluation, the constant callbacks can be trusted as in regime 2, while the
+	//		mutation types governed by the other callbacks are treated as in regime 3.  This is useful for models
+	//		that mix QTLs (using constant neutral callbacks) with other loci governed by fitness callbacks.
+	//		Caches are carried forward only if both sets of mutation type flags are unchanged.
 	//
 	// When models switch between one regime and another, they generally need to recache, since the criteria
 	// for inclusion in the cache differs from regime to regime.  This is handled by RecalculateFitness().
@@ -727,6 +729,7 @@ public:
 	void cache_nonneutral_mutations_REGIME_1();
 	void cache_nonneutral_mutations_REGIME_2();
 	void cache_nonneutral_mutations_REGIME_3();
+	void cache_nonneutral_mutations_REGIME_4();
 	
 	void check_nonneutral_mutation_cache();
 	
@@ -743,6 +746,7 @@ public:
 				case 1: cache_nonneutral_mutations_REGIME_1(); break;
 				case 2: cache_nonneutral_mutations_REGIME_2(); break;
 				case 3: cache_nonneutral_mutations_REGIME_3(); break;
+				case 4: cache_nonneutral_mutations_REGIME_4(); break;
 			}
 			
 #if defined(SLIMGUI) && (SLIMPROFILING == 1)
@@ -23,6 +23,7 @@
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <functional>
 #include <cmath>
 #include <utility>
 #include <unordered_map>
@@ -2354,6 +2355,28 @@ bool Population::ApplyRecombinationCallbacks(slim_popsize_t p_parent_index, Geno
 	return breakpoints_changed;
 }
 
+// Find the first mutation in [p_iter, p_iter_max) with a position >= p_position; the range must be sorted by position, as mutation
+// runs always are.  This lets the crossover code below copy whole spans of parental mutations with emplace_back_bulk(), instead of
+// testing and copying mutations one at a time.  Short spans are scanned linearly; longer spans are bisected, which touches far fewer
+// Mutation objects in gSLiM_Mutation_Block, since each position lookup is likely to be a cache miss in models with many mutations.
+static inline __attribute__((always_inline)) const MutationIndex *FirstMutationAtOrAfterPosition(const MutationIndex *p_iter, const MutationIndex *p_iter_max, slim_position_t p_position, const MutationFitnessCache *p_mut_cache_ptr)
+{
+	while (p_iter_max - p_iter > 16)
+	{
+		const MutationIndex *mid = p_iter + ((p_iter_max - p_iter) >> 1);
+		
+		if ((p_mut_cache_ptr + *mid)->position_ < p_position)
+			p_iter = mid + 1;
+		else
+			p_iter_max = mid;
+	}
+	
+	while ((p_iter != p_iter_max) && ((p_mut_cache_ptr + *p_iter)->position_ < p_position))
+		p_iter++;
+	
+	return p_iter;
+}
+
 // generate a child genome from parental genomes, with recombination, gene conversion, and mutation
 void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_child_genome, slim_popsize_t p_parent_index, IndividualSex p_child_sex, IndividualSex p_parent_sex, std::vector<SLiMEidosBlock*> *p_recombination_callbacks, std::vector<SLiMEidosBlock*> *p_mutation_callbacks)
 {
@@ -2649,7 +2672,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 			p_child_genome.check_cleared_to_nullptr();
 #endif
 			
-			Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+			MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 			Genome *parent_genome = parent_genome_1;
 			slim_position_t mutrun_length = p_child_genome.mutrun_length_;
 			int mutrun_count = p_child_genome.mutrun_count_;
@@ -2690,18 +2713,14 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 					
 					while (true)
 					{
-						// while there are still old mutations in the parent before the current breakpoint...
-						while (parent_iter != parent_iter_max)
+						// add all of the old mutations in the parent before the current breakpoint in one bulk copy; no need to check
+						// for duplicates here since the parental genome is already duplicate-free
+						const MutationIndex *parent_iter_break = FirstMutationAtOrAfterPosition(parent_iter, parent_iter_max, breakpoint, mut_cache_ptr);
+						
+						if (parent_iter_break != parent_iter)
 						{
-							MutationIndex current_mutation = *parent_iter;
-							
-							if ((mut_block_ptr + current_mutation)->position_ >= breakpoint)
-								break;
-							
-							// add the old mutation; no need to check for a duplicate here since the parental genome is already duplicate-free
-							child_mutrun->emplace_back(current_mutation);
-							
-							parent_iter++;
+							child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_break - parent_iter));
+							parent_iter = parent_iter_break;
 						}
 						
 						// we have reached the breakpoint, so swap parents; we want the "current strand" variables to change, so no std::swap()
@@ -2710,8 +2729,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 						parent_iter = parent1_iter;		parent_iter_max = parent1_iter_max;		parent_genome = parent_genome_1;
 						
 						// skip over anything in the new parent that occurs prior to the breakpoint; it was not the active strand
-						while (parent_iter != parent_iter_max && (mut_block_ptr + *parent_iter)->position_ < breakpoint)
-							parent_iter++;
+						parent_iter = FirstMutationAtOrAfterPosition(parent_iter, parent_iter_max, breakpoint, mut_cache_ptr);
 						
 						// we have now handled the current breakpoint, so move on to the next breakpoint; advance the enclosing for loop here
 						break_index++;
@@ -2727,8 +2745,8 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 						// if the next breakpoint is outside this mutation run, then finish the run and break out
 						if (break_mutrun_index > this_mutrun_index)
 						{
-							while (parent_iter != parent_iter_max)
-								child_mutrun->emplace_back(*(parent_iter++));
+							if (parent_iter != parent_iter_max)
+								child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_max - parent_iter));
 							
 							break_index--;	// the outer loop will want to handle the current breakpoint again at the mutation-run level
 							break;
@@ -2804,6 +2822,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 		}
 		
 		Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+		MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 		const MutationIndex *mutation_iter		= mutations_to_add.begin_pointer_const();
 		const MutationIndex *mutation_iter_max	= mutations_to_add.end_pointer_const();
 		
@@ -2812,7 +2831,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 		
 		if (mutation_iter != mutation_iter_max) {
 			mutation_iter_mutation_index = *mutation_iter;
-			mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+			mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 		} else {
 			mutation_iter_mutation_index = -1;
 			mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -2859,7 +2878,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 					while (parent_iter != parent_iter_max)
 					{
 						MutationIndex current_mutation = *parent_iter;
-						slim_position_t current_mutation_pos = (mut_block_ptr + current_mutation)->position_;
+						slim_position_t current_mutation_pos = (mut_cache_ptr + current_mutation)->position_;
 						
 						if (current_mutation_pos > mutation_iter_pos)
 							break;
@@ -2892,7 +2911,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 					
 					if (++mutation_iter != mutation_iter_max) {
 						mutation_iter_mutation_index = *mutation_iter;
-						mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+						mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 					} else {
 						mutation_iter_mutation_index = -1;
 						mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -2903,8 +2922,8 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 				while (mutation_mutrun_index == this_mutrun_index);
 				
 				// finish up any parental mutations that come after the last new mutation in the mutation run
-				while (parent_iter != parent_iter_max)
-					child_mutrun->emplace_back(*(parent_iter++));
+				if (parent_iter != parent_iter_max)
+					child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_max - parent_iter));
 				
 				// We have completed this run
 				++first_uncompleted_mutrun;
@@ -3003,7 +3022,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 							while (parent_iter != parent_iter_max)
 							{
 								MutationIndex current_mutation = *parent_iter;
-								slim_position_t current_mutation_pos = (mut_block_ptr + current_mutation)->position_;
+								slim_position_t current_mutation_pos = (mut_cache_ptr + current_mutation)->position_;
 								
 								if (current_mutation_pos >= breakpoint)
 									break;
@@ -3034,7 +3053,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 									
 									if (++mutation_iter != mutation_iter_max) {
 										mutation_iter_mutation_index = *mutation_iter;
-										mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+										mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 									} else {
 										mutation_iter_mutation_index = -1;
 										mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -3075,7 +3094,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 								
 								if (++mutation_iter != mutation_iter_max) {
 									mutation_iter_mutation_index = *mutation_iter;
-									mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+									mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 								} else {
 									mutation_iter_mutation_index = -1;
 									mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -3095,7 +3114,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 							parent_iter = parent1_iter;		parent_iter_max = parent1_iter_max;		parent_genome = parent_genome_1;
 							
 							// skip over anything in the new parent that occurs prior to the breakpoint; it was not the active strand
-							while (parent_iter != parent_iter_max && (mut_block_ptr + *parent_iter)->position_ < breakpoint)
+							while (parent_iter != parent_iter_max && (mut_cache_ptr + *parent_iter)->position_ < breakpoint)
 								parent_iter++;
 							
 							// we have now handled the current breakpoint, so move on; if we just handled the last breakpoint, then we are done
@@ -3122,18 +3141,14 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 						
 						while (true)
 						{
-							// while there are still old mutations in the parent before the current breakpoint...
-							while (parent_iter != parent_iter_max)
+							// add all of the old mutations in the parent before the current breakpoint in one bulk copy; no need to check
+							// for duplicates here since the parental genome is already duplicate-free
+							const MutationIndex *parent_iter_break = FirstMutationAtOrAfterPosition(parent_iter, parent_iter_max, breakpoint, mut_cache_ptr);
+							
+							if (parent_iter_break != parent_iter)
 							{
-								MutationIndex current_mutation = *parent_iter;
-								
-								if ((mut_block_ptr + current_mutation)->position_ >= breakpoint)
-									break;
-								
-								// add the old mutation; no need to check for a duplicate here since the parental genome is already duplicate-free
-								child_mutrun->emplace_back(current_mutation);
-								
-								parent_iter++;
+								child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_break - parent_iter));
+								parent_iter = parent_iter_break;
 							}
 							
 							// we have reached the breakpoint, so swap parents; we want the "current strand" variables to change, so no std::swap()
@@ -3142,8 +3157,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 							parent_iter = parent1_iter;		parent_iter_max = parent1_iter_max;		parent_genome = parent_genome_1;
 							
 							// skip over anything in the new parent that occurs prior to the breakpoint; it was not the active strand
-							while (parent_iter != parent_iter_max && (mut_block_ptr + *parent_iter)->position_ < breakpoint)
-								parent_iter++;
+							parent_iter = FirstMutationAtOrAfterPosition(parent_iter, parent_iter_max, breakpoint, mut_cache_ptr);
 							
 							// we have now handled the current breakpoint, so move on; if we just handled the last breakpoint, then we are done
 							if (++break_index == break_index_max)
@@ -3156,8 +3170,8 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 							// if the next breakpoint is outside this mutation run, then finish the run and break out
 							if (break_mutrun_index > this_mutrun_index)
 							{
-								while (parent_iter != parent_iter_max)
-									child_mutrun->emplace_back(*(parent_iter++));
+								if (parent_iter != parent_iter_max)
+									child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_max - parent_iter));
 								
 								break;	// the outer loop will want to handle this breakpoint again at the mutation-run level
 							}
@@ -3184,7 +3198,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 						while (parent_iter != parent_iter_max)
 						{
 							MutationIndex current_mutation = *parent_iter;
-							slim_position_t current_mutation_pos = (mut_block_ptr + current_mutation)->position_;
+							slim_position_t current_mutation_pos = (mut_cache_ptr + current_mutation)->position_;
 							
 							if (current_mutation_pos > mutation_iter_pos)
 								break;
@@ -3217,7 +3231,7 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 						
 						if (++mutation_iter != mutation_iter_max) {
 							mutation_iter_mutation_index = *mutation_iter;
-							mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+							mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 						} else {
 							mutation_iter_mutation_index = -1;
 							mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -3228,8 +3242,8 @@ void Population::DoCrossoverMutation(Subpopulation *p_source_subpop, Genome &p_c
 					while (mutation_mutrun_index == this_mutrun_index);
 					
 					// finish up any parental mutations that come after the last new mutation in the mutation run
-					while (parent_iter != parent_iter_max)
-						child_mutrun->emplace_back(*(parent_iter++));
+					if (parent_iter != parent_iter_max)
+						child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_max - parent_iter));
 					
 					// We have completed this run
 					++first_uncompleted_mutrun;
@@ -3669,7 +3683,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 		p_child_genome.check_cleared_to_nullptr();
 #endif
 		
-		Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+		MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 		Genome *parent_genome = p_parent_genome_1;
 		slim_position_t mutrun_length = p_child_genome.mutrun_length_;
 		int mutrun_count = p_child_genome.mutrun_count_;
@@ -3710,18 +3724,14 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 				
 				while (true)
 				{
-					// while there are still old mutations in the parent before the current breakpoint...
-					while (parent_iter != parent_iter_max)
+					// add all of the old mutations in the parent before the current breakpoint in one bulk copy; no need to check
+					// for duplicates here since the parental genome is already duplicate-free
+					const MutationIndex *parent_iter_break = FirstMutationAtOrAfterPosition(parent_iter, parent_iter_max, breakpoint, mut_cache_ptr);
+					
+					if (parent_iter_break != parent_iter)
 					{
-						MutationIndex current_mutation = *parent_iter;
-						
-						if ((mut_block_ptr + current_mutation)->position_ >= breakpoint)
-							break;
-						
-						// add the old mutation; no need to check for a duplicate here since the parental genome is already duplicate-free
-						child_mutrun->emplace_back(current_mutation);
-						
-						parent_iter++;
+						child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_break - parent_iter));
+						parent_iter = parent_iter_break;
 					}
 					
 					// we have reached the breakpoint, so swap parents; we want the "current strand" variables to change, so no std::swap()
@@ -3730,8 +3740,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 					parent_iter = parent1_iter;		parent_iter_max = parent1_iter_max;		parent_genome = p_parent_genome_1;
 					
 					// skip over anything in the new parent that occurs prior to the breakpoint; it was not the active strand
-					while (parent_iter != parent_iter_max && (mut_block_ptr + *parent_iter)->position_ < breakpoint)
-						parent_iter++;
+					parent_iter = FirstMutationAtOrAfterPosition(parent_iter, parent_iter_max, breakpoint, mut_cache_ptr);
 					
 					// we have now handled the current breakpoint, so move on to the next breakpoint; advance the enclosing for loop here
 					break_index++;
@@ -3747,8 +3756,8 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 					// if the next breakpoint is outside this mutation run, then finish the run and break out
 					if (break_mutrun_index > this_mutrun_index)
 					{
-						while (parent_iter != parent_iter_max)
-							child_mutrun->emplace_back(*(parent_iter++));
+						if (parent_iter != parent_iter_max)
+							child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_max - parent_iter));
 						
 						break_index--;	// the outer loop will want to handle the current breakpoint again at the mutation-run level
 						break;
@@ -3823,6 +3832,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 		}
 		
 		Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+		MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 		const MutationIndex *mutation_iter		= mutations_to_add.begin_pointer_const();
 		const MutationIndex *mutation_iter_max	= mutations_to_add.end_pointer_const();
 		
@@ -3831,7 +3841,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 		
 		if (mutation_iter != mutation_iter_max) {
 			mutation_iter_mutation_index = *mutation_iter;
-			mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+			mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 		} else {
 			mutation_iter_mutation_index = -1;
 			mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -3926,7 +3936,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 						while (parent_iter != parent_iter_max)
 						{
 							MutationIndex current_mutation = *parent_iter;
-							slim_position_t current_mutation_pos = (mut_block_ptr + current_mutation)->position_;
+							slim_position_t current_mutation_pos = (mut_cache_ptr + current_mutation)->position_;
 							
 							if (current_mutation_pos >= breakpoint)
 								break;
@@ -3957,7 +3967,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 								
 								if (++mutation_iter != mutation_iter_max) {
 									mutation_iter_mutation_index = *mutation_iter;
-									mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+									mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 								} else {
 									mutation_iter_mutation_index = -1;
 									mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -3998,7 +4008,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 							
 							if (++mutation_iter != mutation_iter_max) {
 								mutation_iter_mutation_index = *mutation_iter;
-								mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+								mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 							} else {
 								mutation_iter_mutation_index = -1;
 								mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -4018,7 +4028,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 						parent_iter = parent1_iter;		parent_iter_max = parent1_iter_max;		parent_genome = p_parent_genome_1;
 						
 						// skip over anything in the new parent that occurs prior to the breakpoint; it was not the active strand
-						while (parent_iter != parent_iter_max && (mut_block_ptr + *parent_iter)->position_ < breakpoint)
+						while (parent_iter != parent_iter_max && (mut_cache_ptr + *parent_iter)->position_ < breakpoint)
 							parent_iter++;
 						
 						// we have now handled the current breakpoint, so move on; if we just handled the last breakpoint, then we are done
@@ -4050,7 +4060,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 						{
 							MutationIndex current_mutation = *parent_iter;
 							
-							if ((mut_block_ptr + current_mutation)->position_ >= breakpoint)
+							if ((mut_cache_ptr + current_mutation)->position_ >= breakpoint)
 								break;
 							
 							// add the old mutation; no need to check for a duplicate here since the parental genome is already duplicate-free
@@ -4065,7 +4075,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 						parent_iter = parent1_iter;		parent_iter_max = parent1_iter_max;		parent_genome = p_parent_genome_1;
 						
 						// skip over anything in the new parent that occurs prior to the breakpoint; it was not the active strand
-						while (parent_iter != parent_iter_max && (mut_block_ptr + *parent_iter)->position_ < breakpoint)
+						while (parent_iter != parent_iter_max && (mut_cache_ptr + *parent_iter)->position_ < breakpoint)
 							parent_iter++;
 						
 						// we have now handled the current breakpoint, so move on; if we just handled the last breakpoint, then we are done
@@ -4079,8 +4089,8 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 						// if the next breakpoint is outside this mutation run, then finish the run and break out
 						if (break_mutrun_index > this_mutrun_index)
 						{
-							while (parent_iter != parent_iter_max)
-								child_mutrun->emplace_back(*(parent_iter++));
+							if (parent_iter != parent_iter_max)
+								child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_max - parent_iter));
 							
 							break;	// the outer loop will want to handle this breakpoint again at the mutation-run level
 						}
@@ -4107,7 +4117,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 					while (parent_iter != parent_iter_max)
 					{
 						MutationIndex current_mutation = *parent_iter;
-						slim_position_t current_mutation_pos = (mut_block_ptr + current_mutation)->position_;
+						slim_position_t current_mutation_pos = (mut_cache_ptr + current_mutation)->position_;
 						
 						if (current_mutation_pos > mutation_iter_pos)
 							break;
@@ -4140,7 +4150,7 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 					
 					if (++mutation_iter != mutation_iter_max) {
 						mutation_iter_mutation_index = *mutation_iter;
-						mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+						mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 					} else {
 						mutation_iter_mutation_index = -1;
 						mutation_iter_pos = SLIM_INF_BASE_POSITION;
@@ -4151,8 +4161,8 @@ void Population::DoRecombinantMutation(Subpopulation *p_mutorigin_subpop, Genome
 				while (mutation_mutrun_index == this_mutrun_index);
 				
 				// finish up any parental mutations that come after the last new mutation in the mutation run
-				while (parent_iter != parent_iter_max)
-					child_mutrun->emplace_back(*(parent_iter++));
+				if (parent_iter != parent_iter_max)
+					child_mutrun->emplace_back_bulk(parent_iter, (int32_t)(parent_iter_max - parent_iter));
 				
 				// We have completed this run
 				++first_uncompleted_mutrun;
@@ -4277,6 +4287,7 @@ void Population::DoClonalMutation(Subpopulation *p_mutorigin_subpop, Genome &p_c
 		
 		// loop over mutation runs and either (1) copy the mutrun pointer from the parent, or (2) make a new mutrun by modifying that of the parent
 		Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+		MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 		
 		int mutrun_count = p_child_genome.mutrun_count_;
 		slim_position_t mutrun_length = p_child_genome.mutrun_length_;
@@ -4284,7 +4295,7 @@ void Population::DoClonalMutation(Subpopulation *p_mutorigin_subpop, Genome &p_c
 		const MutationIndex *mutation_iter		= mutations_to_add.begin_pointer_const();
 		const MutationIndex *mutation_iter_max	= mutations_to_add.end_pointer_const();
 		MutationIndex mutation_iter_mutation_index = *mutation_iter;
-		slim_position_t mutation_iter_pos = (mut_block_ptr + mutation_iter_mutation_index)->position_;
+		slim_position_t mutation_iter_pos = (mut_cache_ptr + mutation_iter_mutation_index)->position_;
 		slim_mutrun_index_t mutation_iter_mutrun_index = (slim_mutrun_index_t)(mutation_iter_pos / mutrun_length);
 		
 		for (int run_index = 0; run_index < mutrun_count; ++run_index)
@@ -4569,6 +4580,7 @@ void Population::AddTallyForMutationTypeAndBinNumber(int p_mutation_type_index,
 void Population::ValidateMutationFitnessCaches(void)
 {
 	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 	int registry_size;
 	const MutationIndex *registry_iter = MutationRegistry(&registry_size);
 	const MutationIndex *registry_iter_end = registry_iter + registry_size;
@@ -4577,13 +4589,15 @@ void Population::ValidateMutationFitnessCaches(void)
 	{
 		MutationIndex mut_index = (*registry_iter++);
 		Mutation *mut = mut_block_ptr + mut_index;
+		MutationFitnessCache *cache = mut_cache_ptr + mut_index;
 		slim_selcoeff_t sel_coeff = mut->selection_coeff_;
 		slim_selcoeff_t dom_coeff = mut->mutation_type_ptr_->dominance_coeff_;
 		slim_selcoeff_t haploid_dom_coeff = mut->mutation_type_ptr_->haploid_dominance_coeff_;
 		
-		mut->cached_one_plus_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + sel_coeff);
-		mut->cached_one_plus_dom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + dom_coeff * sel_coeff);
-		mut->cached_one_plus_haploiddom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + haploid_dom_coeff * sel_coeff);
+		cache->selection_coeff_ = sel_coeff;
+		cache->cached_one_plus_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + sel_coeff);
+		cache->cached_one_plus_dom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + dom_coeff * sel_coeff);
+		cache->cached_one_plus_haploiddom_sel_ = (slim_selcoeff_t)std::max(0.0, 1.0 + haploid_dom_coeff * sel_coeff);
 	}
 }
 
@@ -4632,8 +4646,11 @@ void Population::RecalculateFitness(slim_generation_t p_generation)
 			muttype->previous_subject_to_fitness_callback_ = muttype->subject_to_fitness_callback_;
 		}
 		
-		// Then we assess which muttypes are being made globally neutral by a constant-value fitness callback
+		// Then we assess which muttypes are being made globally neutral by a constant-value fitness callback; we also note
+		// whether all active callbacks are well-behaved, and gather the active callbacks that are not neutral-making
 		bool all_active_callbacks_are_global_neutral_effects = true;
+		bool all_active_callbacks_are_well_behaved = true;
+		std::vector<SLiMEidosBlock*> other_active_callbacks;
 		
 		for (auto muttype_iter : mut_types)
 			(muttype_iter.second)->set_neutral_by_global_active_callback_ = false;
@@ -4665,6 +4682,11 @@ void Population::RecalculateFitness(slim_generation_t p_generation)
 									if (found_muttype)
 										found_muttype->set_neutral_by_global_active_callback_ = true;
 								}
+								else
+								{
+									// this neutralizes every muttype, but only at its point in the callback order; regime 4 must treat it as unpredictable
+									other_active_callbacks.emplace_back(fitness_callback);
+								}
 								
 								// This is a constant neutral effect, so avoid dropping through to the flag set below
 								continue;
@@ -4673,10 +4695,12 @@ void Population::RecalculateFitness(slim_generation_t p_generation)
 					}
 				}
 				
-				// if we reach this point, we have an active callback that is not a
-				// global constant neutral effect, so set our flag and break out
+				// if we reach this point, we have an active callback that is not a global constant neutral effect
 				all_active_callbacks_are_global_neutral_effects = false;
-				break;
+				other_active_callbacks.emplace_back(fitness_callback);
+				
+				if (fitness_callback->may_alter_script_blocks_)
+					all_active_callbacks_are_well_behaved = false;
 			}
 		}
 		
@@ -4687,11 +4711,49 @@ void Population::RecalculateFitness(slim_generation_t p_generation)
 			// When that flag is true, the mut is neutral; when it is false, consult the selection coefficient.
 			current_regime = 2;
 		}
+		else if (all_active_callbacks_are_well_behaved)
+		{
+			// We have active callbacks that are not global constant-effect callbacks, but none of them can change the
+			// state of script blocks, so the callbacks active now will be the callbacks active throughout fitness
+			// evaluation.  A muttype is neutral if it is made neutral by a global constant callback and no other active
+			// callback applies to it; otherwise, if any active callback applies to it, it must be considered non-neutral.
+			// (Global fitness(NULL) callbacks are not allowed, as a matter of policy, to alter non-global callbacks.)
+			current_regime = 4;
+			
+			for (auto muttype_iter : mut_types)
+				(muttype_iter.second)->subject_to_fitness_callback_ = false;
+			
+			for (SLiMEidosBlock *fitness_callback : other_active_callbacks)
+			{
+				slim_objectid_t mutation_type_id = fitness_callback->mutation_type_id_;
+				
+				if (mutation_type_id == -1)
+				{
+					for (auto muttype_iter : mut_types)
+						(muttype_iter.second)->subject_to_fitness_callback_ = true;
+				}
+				else
+				{
+                    MutationType *found_muttype = sim_.MutationTypeWithID(mutation_type_id);
+					
+					if (found_muttype)
+						found_muttype->subject_to_fitness_callback_ = true;
+				}
+			}
+			
+			for (auto muttype_iter : mut_types)
+			{
+				MutationType *muttype = muttype_iter.second;
+				
+				if (muttype->subject_to_fitness_callback_)
+					muttype->set_neutral_by_global_active_callback_ = false;
+			}
+		}
 		else
 		{
-			// We have at least one active callback that is not a global constant-effect callback, so all
-			// bets are off; any mutation of a muttype influenced by a callback must be considered non-neutral,
-			// as governed by the flag set up below
+			// We have at least one active callback that is not a global constant-effect callback, and that might alter
+			// the state of script blocks, so all bets are off; any mutation of a muttype influenced by a callback must
+			// be considered non-neutral, as governed by the flag set up below
 			current_regime = 3;
 			
 			for (auto muttype_iter : mut_types)
@@ -4715,7 +4777,7 @@ void Population::RecalculateFitness(slim_generation_t p_generation)
 	// trigger a recache of nonneutral mutation lists for some regime transitions; see mutation_run.h
 	if (last_regime == 0)
 		sim_.nonneutral_change_counter_++;
-	else if ((current_regime == 1) && ((last_regime == 2) || (last_regime == 3)))
+	else if ((current_regime == 1) && (last_regime != 1))
 		sim_.nonneutral_change_counter_++;
 	else if (current_regime == 2)
 	{
@@ -4763,6 +4825,28 @@ void Population::RecalculateFitness(slim_generation_t p_generation)
 				sim_.nonneutral_change_counter_++;
 		}
 	}
+	else if (current_regime == 4)
+	{
+		if (last_regime != 4)
+			sim_.nonneutral_change_counter_++;
+		else
+		{
+			// Regime 4 depends upon both flags, so both must be unchanged for us to carry over our nonneutral buffers
+			bool callback_state_identical = true;
+			
+			for (auto muttype_iter : mut_types)
+			{
+				MutationType *muttype = muttype_iter.second;
+				
+				if ((muttype->set_neutral_by_global_active_callback_ != muttype->previous_set_neutral_by_global_active_callback_) ||
+					(muttype->subject_to_fitness_callback_ != muttype->previous_subject_to_fitness_callback_))
+					callback_state_identical = false;
+			}
+			
+			if (!callback_state_identical)
+				sim_.nonneutral_change_counter_++;
+		}
+	}
 	
 	// move forward to the regime we just chose; UpdateFitness() can consult this to get the current regime
 	sim_.last_nonneutral_regime_ = current_regime;
@@ -5474,6 +5558,37 @@ void Population::SwapGenerations(void)
 }
 #endif	// SLIM_WF_ONLY
 
+// Tally references to mutations from a vector of mutation run pointers, one entry per genome that references the run.  Runs are
+// usually shared by many genomes, particularly in models dominated by neutral variation, so rather than walking each genome's
+// mutations we sort the run pointers and walk each distinct run once, weighted by its count.  The cost is then proportional to
+// the number of distinct runs, not to the number of genomes times the number of segregating sites.  The vector is sorted in place.
+static void TallyDistinctMutationRuns(std::vector<MutationRun *> &p_runs)
+{
+	std::sort(p_runs.begin(), p_runs.end(), std::less<MutationRun *>());
+	
+	slim_refcount_t *refcount_block_ptr = gSLiM_Mutation_Refcounts;
+	size_t tally_run_count = p_runs.size();
+	size_t tally_index = 0;
+	
+	while (tally_index < tally_run_count)
+	{
+		MutationRun *mutrun = p_runs[tally_index];
+		size_t next_index = tally_index + 1;
+		
+		while ((next_index < tally_run_count) && (p_runs[next_index] == mutrun))
+			next_index++;
+		
+		slim_refcount_t use_count = (slim_refcount_t)(next_index - tally_index);
+		const MutationIndex *genome_iter = mutrun->begin_pointer_const();
+		const MutationIndex *genome_end_iter = mutrun->end_pointer_const();
+		
+		for (; genome_iter != genome_end_iter; ++genome_iter)
+			*(refcount_block_ptr + *genome_iter) += use_count;
+		
+		tally_index = next_index;
+	}
+}
+
 // count the total number of times that each Mutation in the registry is referenced by a population, and return the maximum possible number of references (i.e. fixation)
 // the only tricky thing is that if we're running in the GUI, we also tally up references within the selected subpopulations only
 slim_refcount_t Population::TallyMutationReferences(std::vector<Subpopulation*> *p_subpops_to_tally, bool p_force_recache)
@@ -5510,10 +5625,12 @@ slim_refcount_t Population::TallyMutationReferences(std::vector<Subpopulation*>
 		// first zero out the refcounts in all registered Mutation objects
 		SLiM_ZeroRefcountBlock(mutation_registry_);
 		
-		// then increment the refcounts through all pointers to Mutation in all genomes
-		slim_refcount_t *refcount_block_ptr = gSLiM_Mutation_Refcounts;
+		// then gather the mutation runs referenced by the genomes, and tally each distinct run once; see TallyDistinctMutationRuns()
+		static std::vector<MutationRun *> tally_runs;	// prevent reallocation by using a static
 		slim_refcount_t total_genome_count = 0;
 		
+		tally_runs.clear();
+		
 		for (Subpopulation *subpop : *p_subpops_to_tally)
 		{
 			// Particularly for SLiMgui, we need to be able to tally mutation references after the generations have been swapped, i.e.
@@ -5530,20 +5647,15 @@ slim_refcount_t Population::TallyMutationReferences(std::vector<Subpopulation*>
 					int mutrun_count = genome.mutrun_count_;
 					
 					for (int run_index = 0; run_index < mutrun_count; ++run_index)
-					{
-						MutationRun *mutrun = genome.mutruns_[run_index].get();
-						const MutationIndex *genome_iter = mutrun->begin_pointer_const();
-						const MutationIndex *genome_end_iter = mutrun->end_pointer_const();
-						
-						for (; genome_iter != genome_end_iter; ++genome_iter)
-							++(*(refcount_block_ptr + *genome_iter));
-					}
+						tally_runs.emplace_back(genome.mutruns_[run_index].get());
 					
 					total_genome_count++;	// count only non-null genomes to determine fixation
 				}
 			}
 		}
 		
+		TallyDistinctMutationRuns(tally_runs);
+		
 		// set up the cache info
 		last_tallied_subpops_ = *p_subpops_to_tally;
 		cached_tally_genome_count_ = total_genome_count;
@@ -5829,12 +5941,14 @@ slim_refcount_t Population::TallyMutationReferences(std::vector<Genome*> *p_geno
 	// first zero out the refcounts in all registered Mutation objects
 	SLiM_ZeroRefcountBlock(mutation_registry_);
 	
-	// then increment the refcounts through all pointers to Mutation in all genomes
-	slim_refcount_t *refcount_block_ptr = gSLiM_Mutation_Refcounts;
+	// then gather the mutation runs referenced by the genomes, and tally each distinct run once; see TallyDistinctMutationRuns()
+	static std::vector<MutationRun *> tally_runs;	// prevent reallocation by using a static
 	slim_popsize_t genome_count = (slim_popsize_t)p_genomes_to_tally->size();
 	std::vector<Genome *> &genomes = *p_genomes_to_tally;
 	slim_refcount_t total_genome_count = 0;
 	
+	tally_runs.clear();
+	
 	for (slim_popsize_t i = 0; i < genome_count; i++)							// child genomes
 	{
 		Genome &genome = *genomes[i];
@@ -5844,19 +5958,14 @@ slim_refcount_t Population::TallyMutationReferences(std::vector<Genome*> *p_geno
 			int mutrun_count = genome.mutrun_count_;
 			
 			for (int run_index = 0; run_index < mutrun_count; ++run_index)
-			{
-				MutationRun *mutrun = genome.mutruns_[run_index].get();
-				const MutationIndex *genome_iter = mutrun->begin_pointer_const();
-				const MutationIndex *genome_end_iter = mutrun->end_pointer_const();
-				
-				for (; genome_iter != genome_end_iter; ++genome_iter)
-					++(*(refcount_block_ptr + *genome_iter));
-			}
+				tally_runs.emplace_back(genome.mutruns_[run_index].get());
 			
 			total_genome_count++;	// count only non-null genomes to determine fixation
 		}
 	}
 	
+	TallyDistinctMutationRuns(tally_runs);
+	
 	// set up the cache info; we have messed up any cached tallies
 	last_tallied_subpops_.clear();
 	cached_tally_genome_count_ = 0;
@@ -5865,6 +5974,12 @@ slim_refcount_t Population::TallyMutationReferences(std::vector<Genome*> *p_geno
 	return total_genome_count;
 }
 
+// Note that this tally already scales with the number of distinct mutation runs, not the number of genomes, since each run is
+// walked only once (weighted by its use count).  Maintaining the refcounts incrementally instead, from per-run use count deltas
+// as runs are created, shared, and freed, has been considered and does not pay off: in WF models nearly every run that survives
+// into the child generation changes its use count (inheritance is a multinomial draw), so its contents would need to be walked
+// anyway, and every freed run would need an additional walk to subtract its contribution.  It would also require every
+// in-place modification of a run to be intercepted, which the MutationRun API (with its direct buffer access) cannot guarantee.
 slim_refcount_t Population::TallyMutationReferences_FAST(void)
 {
 	// first zero out the refcounts in all registered Mutation objects
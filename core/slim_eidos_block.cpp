@@ -16,6 +16,8 @@
 #include "slim_sim.h"
 #include "interaction_type.h"
 #include "subpopulation.h"
+#include "individual.h"
+#include "mutation.h"
 
 #include "errno.h"
 #include "string.h"
@@ -1017,6 +1019,29 @@ void SLiMEidosBlock::_ScanNodeForIdentifiersUsed(const EidosASTNode *p_scan_node
 		if (token_string.compare(gStr_surviving) == 0)			contains_surviving_ = true;
 		if (token_string.compare(gStr_fitness) == 0)			contains_fitness_ = true;
 		if (token_string.compare(gStr_draw) == 0)				contains_draw_ = true;
+		
+		if (token_string.compare(gStr_active) == 0)							may_alter_script_blocks_ = true;
+		if (token_string.compare(gEidosStr_source) == 0)					may_alter_script_blocks_ = true;
+		if (token_string.compare(gEidosStr_executeLambda) == 0)				may_alter_script_blocks_ = true;
+		if (token_string.compare(gEidosStr_doCall) == 0)					may_alter_script_blocks_ = true;
+		if (token_string.compare(gEidosStr_apply) == 0)						may_alter_script_blocks_ = true;	// lambda strings are not scanned; the wildcard
+		if (token_string.compare(gEidosStr_sapply) == 0)					may_alter_script_blocks_ = true;	// flag implies this too, but we are explicit
+		if (token_string.compare(gStr_deregisterScriptBlock) == 0)			may_alter_script_blocks_ = true;
+		if (token_string.compare(gStr_rescheduleScriptBlock) == 0)			may_alter_script_blocks_ = true;
+		if (token_string.compare(0, 8, "register") == 0)					may_alter_script_blocks_ = true;	// registerFitnessCallback() etc.
+	}
+	else if (p_scan_node->token_->token_type_ == EidosTokenType::kTokenLParen)
+	{
+		// a function call whose name is not a built-in Eidos function might call a user-defined function, which could do anything
+		const EidosASTNode *call_name_node = (p_scan_node->children_.size() > 0) ? p_scan_node->children_[0] : nullptr;
+		
+		if (call_name_node && (call_name_node->token_->token_type_ == EidosTokenType::kTokenIdentifier))
+		{
+			const EidosFunctionMap *builtin_function_map = EidosInterpreter::BuiltInFunctionMap();
+			
+			if (builtin_function_map->find(call_name_node->token_->token_string_) == builtin_function_map->end())
+				may_alter_script_blocks_ = true;
+		}
 	}
 }
 
@@ -1062,10 +1087,617 @@ void SLiMEidosBlock::ScanTreeForIdentifiersUsed(void)
 		contains_surviving_ = true;
 		contains_fitness_ = true;
 		contains_draw_ = true;
+		may_alter_script_blocks_ = true;
 	}
 }
 
 
+int32_t SLiMEidosBlock::_CompileArithmeticNode(const EidosASTNode *p_node)
+{
+	// Returns the index of the compiled node in compiled_nodes_, or -1 if the node is outside the subset we compile.  The typing
+	// rules here mirror what EidosInterpreter would do with singleton operands; anything that the interpreter would reject
+	// (logical operands to arithmetic operators, an integer x for dnorm(), etc.) is left uncompiled so that it raises as usual.
+	SLiMCompiledNode compiled_node = {SLiMCompiledOp::kConstant, EidosValueType::kValueVOID, EidosValueType::kValueVOID, {-1, -1, -1}, 0.0, 0};
+	EidosTokenType token_type = p_node->token_->token_type_;
+	const std::string &token_string = p_node->token_->token_string_;
+	size_t child_count = p_node->children_.size();
+	bool is_global_callback = (type_ == SLiMEidosBlockType::SLiMEidosFitnessGlobalCallback);
+	
+	if (p_node->cached_literal_value_)
+	{
+		// numeric literals, and constant identifiers such as T, PI, and INF
+		EidosValue *literal = p_node->cached_literal_value_.get();
+		
+		if ((literal->Count() != 1) || (literal->DimensionCount() != 1))
+			return -1;
+		
+		compiled_node.type_ = literal->Type();
+		
+		switch (compiled_node.type_)
+		{
+			case EidosValueType::kValueLogical:	compiled_node.float_value_ = (literal->LogicalAtIndex(0, nullptr) ? 1.0 : 0.0); break;
+			case EidosValueType::kValueInt:		compiled_node.int_value_ = literal->IntAtIndex(0, nullptr); break;
+			case EidosValueType::kValueFloat:	compiled_node.float_value_ = literal->FloatAtIndex(0, nullptr); break;
+			default: return -1;
+		}
+	}
+	else if ((token_type == EidosTokenType::kTokenIdentifier) && (child_count == 0))
+	{
+		if (token_string == gStr_relFitness)
+		{
+			// relFitness is always 1.0 in fitness(NULL) callbacks
+			compiled_node.type_ = EidosValueType::kValueFloat;
+			
+			if (is_global_callback)
+				compiled_node.float_value_ = 1.0;
+			else
+				compiled_node.op_ = SLiMCompiledOp::kRelFitness;
+		}
+		else if ((token_string == gStr_homozygous) && !is_global_callback)
+		{
+			compiled_node.op_ = SLiMCompiledOp::kHomozygous;
+			compiled_node.type_ = EidosValueType::kValueLogical;
+		}
+		else
+			return -1;
+	}
+	else if ((token_type == EidosTokenType::kTokenDot) && (child_count == 2))
+	{
+		const EidosASTNode *object_node = p_node->children_[0];
+		const EidosASTNode *property_node = p_node->children_[1];
+		
+		if ((object_node->token_->token_type_ != EidosTokenType::kTokenIdentifier) || (object_node->children_.size() != 0) ||
+			(property_node->token_->token_type_ != EidosTokenType::kTokenIdentifier))
+			return -1;
+		
+		const std::string &object_name = object_node->token_->token_string_;
+		const std::string &property_name = property_node->token_->token_string_;
+		
+		compiled_node.type_ = EidosValueType::kValueInt;
+		
+		if ((object_name == gStr_mut) && !is_global_callback)
+		{
+			if (property_name == gStr_selectionCoeff)			{ compiled_node.op_ = SLiMCompiledOp::kMutSelectionCoeff; compiled_node.type_ = EidosValueType::kValueFloat; }
+			else if (property_name == gStr_position)			compiled_node.op_ = SLiMCompiledOp::kMutPosition;
+			else if (property_name == gStr_originGeneration)	compiled_node.op_ = SLiMCompiledOp::kMutOriginGeneration;
+			else if (property_name == gStr_id)					compiled_node.op_ = SLiMCompiledOp::kMutID;
+			else return -1;
+		}
+		else if (object_name == gStr_individual)
+		{
+			if (property_name == gStr_tag)						compiled_node.op_ = SLiMCompiledOp::kIndividualTag;
+			else if (property_name == gStr_tagF)				{ compiled_node.op_ = SLiMCompiledOp::kIndividualTagF; compiled_node.type_ = EidosValueType::kValueFloat; }
+#ifdef SLIM_NONWF_ONLY
+			else if (property_name == gStr_age)					compiled_node.op_ = SLiMCompiledOp::kIndividualAge;
+#endif
+			else return -1;
+		}
+		else if (object_name == gStr_sim)
+		{
+			if (property_name == gStr_generation)				compiled_node.op_ = SLiMCompiledOp::kSimGeneration;
+			else return -1;
+		}
+		else
+			return -1;
+	}
+	else if (((token_type == EidosTokenType::kTokenMinus) || (token_type == EidosTokenType::kTokenNot)) && (child_count == 1))
+	{
+		int32_t operand = _CompileArithmeticNode(p_node->children_[0]);
+		
+		if (operand == -1)
+			return -1;
+		
+		EidosValueType operand_type = compiled_nodes_[operand].type_;
+		
+		if (token_type == EidosTokenType::kTokenMinus)
+		{
+			if ((operand_type != EidosValueType::kValueInt) && (operand_type != EidosValueType::kValueFloat))
+				return -1;
+			
+			compiled_node.op_ = SLiMCompiledOp::kNegate;
+		}
+		else
+		{
+			if (operand_type != EidosValueType::kValueLogical)
+				return -1;
+			
+			compiled_node.op_ = SLiMCompiledOp::kNot;
+		}
+		
+		compiled_node.type_ = operand_type;
+		compiled_node.child_[0] = operand;
+	}
+	else if (child_count == 2)
+	{
+		switch (token_type)
+		{
+			case EidosTokenType::kTokenPlus:	compiled_node.op_ = SLiMCompiledOp::kAdd; break;
+			case EidosTokenType::kTokenMinus:	compiled_node.op_ = SLiMCompiledOp::kSubtract; break;
+			case EidosTokenType::kTokenMult:	compiled_node.op_ = SLiMCompiledOp::kMultiply; break;
+			case EidosTokenType::kTokenDiv:		compiled_node.op_ = SLiMCompiledOp::kDivide; break;
+			case EidosTokenType::kTokenMod:		compiled_node.op_ = SLiMCompiledOp::kMod; break;
+			case EidosTokenType::kTokenExp:		compiled_node.op_ = SLiMCompiledOp::kPower; break;
+			case EidosTokenType::kTokenLt:		compiled_node.op_ = SLiMCompiledOp::kLess; break;
+			case EidosTokenType::kTokenLtEq:	compiled_node.op_ = SLiMCompiledOp::kLessEqual; break;
+			case EidosTokenType::kTokenGt:		compiled_node.op_ = SLiMCompiledOp::kGreater; break;
+			case EidosTokenType::kTokenGtEq:	compiled_node.op_ = SLiMCompiledOp::kGreaterEqual; break;
+			case EidosTokenType::kTokenEq:		compiled_node.op_ = SLiMCompiledOp::kEqual; break;
+			case EidosTokenType::kTokenNotEq:	compiled_node.op_ = SLiMCompiledOp::kNotEqual; break;
+			case EidosTokenType::kTokenAnd:		compiled_node.op_ = SLiMCompiledOp::kAnd; break;
+			case EidosTokenType::kTokenOr:		compiled_node.op_ = SLiMCompiledOp::kOr; break;
+			default: return -1;
+		}
+		
+		int32_t first_operand = _CompileArithmeticNode(p_node->children_[0]);
+		
+		if (first_operand == -1)
+			return -1;
+		
+		int32_t second_operand = _CompileArithmeticNode(p_node->children_[1]);
+		
+		if (second_operand == -1)
+			return -1;
+		
+		EidosValueType first_type = compiled_nodes_[first_operand].type_;
+		EidosValueType second_type = compiled_nodes_[second_operand].type_;
+		bool both_numeric = ((first_type != EidosValueType::kValueLogical) && (second_type != EidosValueType::kValueLogical));
+		bool both_int = ((first_type == EidosValueType::kValueInt) && (second_type == EidosValueType::kValueInt));
+		
+		switch (compiled_node.op_)
+		{
+			case SLiMCompiledOp::kAdd:
+			case SLiMCompiledOp::kSubtract:
+			case SLiMCompiledOp::kMultiply:
+				if (!both_numeric)
+					return -1;
+				compiled_node.type_ = (both_int ? EidosValueType::kValueInt : EidosValueType::kValueFloat);
+				break;
+			case SLiMCompiledOp::kDivide:
+			case SLiMCompiledOp::kMod:
+			case SLiMCompiledOp::kPower:
+				if (!both_numeric)
+					return -1;
+				compiled_node.type_ = EidosValueType::kValueFloat;
+				break;
+			case SLiMCompiledOp::kAnd:
+			case SLiMCompiledOp::kOr:
+				if ((first_type != EidosValueType::kValueLogical) || (second_type != EidosValueType::kValueLogical))
+					return -1;
+				compiled_node.type_ = EidosValueType::kValueLogical;
+				break;
+			default:
+				// comparisons promote logical < integer < float, as EidosTypeForPromotion() does
+				compiled_node.type_ = EidosValueType::kValueLogical;
+				compiled_node.operand_type_ = std::max(first_type, second_type);
+				break;
+		}
+		
+		compiled_node.child_[0] = first_operand;
+		compiled_node.child_[1] = second_operand;
+	}
+	else if ((token_type == EidosTokenType::kTokenConditional) && (child_count == 3))
+	{
+		int32_t condition = _CompileArithmeticNode(p_node->children_[0]);
+		int32_t true_operand = ((condition == -1) ? -1 : _CompileArithmeticNode(p_node->children_[1]));
+		int32_t false_operand = ((true_operand == -1) ? -1 : _CompileArithmeticNode(p_node->children_[2]));
+		
+		if ((false_operand == -1) || (compiled_nodes_[condition].type_ != EidosValueType::kValueLogical) ||
+			(compiled_nodes_[true_operand].type_ != compiled_nodes_[false_operand].type_))
+			return -1;
+		
+		compiled_node.op_ = SLiMCompiledOp::kConditional;
+		compiled_node.type_ = compiled_nodes_[true_operand].type_;
+		compiled_node.child_[0] = condition;
+		compiled_node.child_[1] = true_operand;
+		compiled_node.child_[2] = false_operand;
+	}
+	else if ((token_type == EidosTokenType::kTokenLParen) && (child_count >= 2))
+	{
+		// a call to a built-in function; named arguments are not handled
+		const EidosASTNode *call_name_node = p_node->children_[0];
+		
+		if (call_name_node->token_->token_type_ != EidosTokenType::kTokenIdentifier)
+			return -1;
+		
+		const std::string &function_name = call_name_node->token_->token_string_;
+		int argument_count = (int)child_count - 1;
+		
+		if ((function_name == "exp") || (function_name == "log") || (function_name == "log10") || (function_name == "sqrt") || (function_name == "abs"))
+		{
+			if (argument_count != 1)
+				return -1;
+			
+			int32_t operand = _CompileArithmeticNode(p_node->children_[1]);
+			
+			if ((operand == -1) || (compiled_nodes_[operand].type_ == EidosValueType::kValueLogical))
+				return -1;
+			
+			if (function_name == "exp")			compiled_node.op_ = SLiMCompiledOp::kExp;
+			else if (function_name == "log")	compiled_node.op_ = SLiMCompiledOp::kLog;
+			else if (function_name == "log10")	compiled_node.op_ = SLiMCompiledOp::kLog10;
+			else if (function_name == "sqrt")	compiled_node.op_ = SLiMCompiledOp::kSqrt;
+			else								compiled_node.op_ = SLiMCompiledOp::kAbs;
+			
+			compiled_node.type_ = ((compiled_node.op_ == SLiMCompiledOp::kAbs) ? compiled_nodes_[operand].type_ : EidosValueType::kValueFloat);
+			compiled_node.child_[0] = operand;
+		}
+		else if (function_name == "ifelse")
+		{
+			if (argument_count != 3)
+				return -1;
+			
+			int32_t test = _CompileArithmeticNode(p_node->children_[1]);
+			int32_t true_operand = ((test == -1) ? -1 : _CompileArithmeticNode(p_node->children_[2]));
+			int32_t false_operand = ((true_operand == -1) ? -1 : _CompileArithmeticNode(p_node->children_[3]));
+			
+			if ((false_operand == -1) || (compiled_nodes_[test].type_ != EidosValueType::kValueLogical) ||
+				(compiled_nodes_[true_operand].type_ != compiled_nodes_[false_operand].type_))
+				return -1;
+			
+			compiled_node.op_ = SLiMCompiledOp::kIfElse;
+			compiled_node.type_ = compiled_nodes_[true_operand].type_;
+			compiled_node.child_[0] = test;
+			compiled_node.child_[1] = true_operand;
+			compiled_node.child_[2] = false_operand;
+		}
+		else if (function_name == "dnorm")
+		{
+			if (argument_count > 3)
+				return -1;
+			
+			for (int argument_index = 0; argument_index < argument_count; ++argument_index)
+			{
+				int32_t operand = _CompileArithmeticNode(p_node->children_[argument_index + 1]);
+				
+				if (operand == -1)
+					return -1;
+				
+				// x must be float; mean and sd may be integer or float
+				EidosValueType operand_type = compiled_nodes_[operand].type_;
+				
+				if ((operand_type == EidosValueType::kValueLogical) || ((argument_index == 0) && (operand_type != EidosValueType::kValueFloat)))
+					return -1;
+				
+				compiled_node.child_[argument_index] = operand;
+			}
+			
+			compiled_node.op_ = SLiMCompiledOp::kDnorm;
+			compiled_node.type_ = EidosValueType::kValueFloat;
+		}
+		else
+			return -1;
+	}
+	else
+		return -1;
+	
+	compiled_nodes_.emplace_back(compiled_node);
+	return (int32_t)(compiled_nodes_.size() - 1);
+}
+
+void SLiMEidosBlock::CompileArithmeticCallback(void)
+{
+	// We compile only fitness() callbacks whose body is "{ return <expression>; }" with an expression in the subset handled by
+	// _CompileArithmeticNode(): constants, callback parameters, a few properties, arithmetic, comparisons, ifelse(), the
+	// ternary conditional, and a few math functions.  Callbacks outside that subset are interpreted as usual.
+	compiled_nodes_.clear();
+	
+	if ((type_ != SLiMEidosBlockType::SLiMEidosFitnessCallback) && (type_ != SLiMEidosBlockType::SLiMEidosFitnessGlobalCallback))
+		return;
+	if (contains_wildcard_ || compound_statement_node_->cached_return_value_)
+		return;
+	
+	const EidosASTNode *base_node = compound_statement_node_;
+	
+	if ((base_node->token_->token_type_ != EidosTokenType::kTokenLBrace) || (base_node->children_.size() != 1))
+		return;
+	
+	const EidosASTNode *return_node = base_node->children_[0];
+	
+	if ((return_node->token_->token_type_ != EidosTokenType::kTokenReturn) || (return_node->children_.size() != 1))
+		return;
+	
+	int32_t root = _CompileArithmeticNode(return_node->children_[0]);
+	
+	// the result must be a float singleton; if not, the interpreter will raise, so we leave that to it
+	if ((root == -1) || (compiled_nodes_[root].type_ != EidosValueType::kValueFloat))
+	{
+		compiled_nodes_.clear();
+		return;
+	}
+	
+	compiled_nodes_.shrink_to_fit();
+}
+
+static double _SLiM_EvaluateCompiledFloat(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context);
+static int64_t _SLiM_EvaluateCompiledInt(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context);
+static bool _SLiM_EvaluateCompiledLogical(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context);
+
+static inline double _SLiM_EvaluateCompiledAsFloat(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context)
+{
+	switch (p_nodes[p_index].type_)
+	{
+		case EidosValueType::kValueFloat:	return _SLiM_EvaluateCompiledFloat(p_nodes, p_index, p_context);
+		case EidosValueType::kValueInt:		return (double)_SLiM_EvaluateCompiledInt(p_nodes, p_index, p_context);
+		default:							return (_SLiM_EvaluateCompiledLogical(p_nodes, p_index, p_context) ? 1.0 : 0.0);
+	}
+}
+
+static inline int64_t _SLiM_EvaluateCompiledAsInt(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context)
+{
+	if (p_nodes[p_index].type_ == EidosValueType::kValueInt)
+		return _SLiM_EvaluateCompiledInt(p_nodes, p_index, p_context);
+	
+	return (_SLiM_EvaluateCompiledLogical(p_nodes, p_index, p_context) ? 1 : 0);
+}
+
+static double _SLiM_EvaluateCompiledFloat(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context)
+{
+	const SLiMCompiledNode &node = p_nodes[p_index];
+	
+	switch (node.op_)
+	{
+		case SLiMCompiledOp::kConstant:				return node.float_value_;
+		case SLiMCompiledOp::kRelFitness:			return p_context.rel_fitness_;
+		case SLiMCompiledOp::kMutSelectionCoeff:	return p_context.mut_->selection_coeff_;
+		case SLiMCompiledOp::kIndividualTagF:
+		{
+			double tagF_value = p_context.individual_->tagF_value_;
+			
+			if (tagF_value == SLIM_TAGF_UNSET_VALUE)
+				p_context.failed_ = true;
+			
+			return tagF_value;
+		}
+		case SLiMCompiledOp::kNegate:				return -_SLiM_EvaluateCompiledFloat(p_nodes, node.child_[0], p_context);
+		case SLiMCompiledOp::kAdd:					return _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context) + _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context);
+		case SLiMCompiledOp::kSubtract:				return _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context) - _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context);
+		case SLiMCompiledOp::kMultiply:				return _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context) * _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context);
+		case SLiMCompiledOp::kDivide:				return _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context) / _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context);
+		case SLiMCompiledOp::kMod:
+		{
+			double first_value = _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context);
+			return fmod(first_value, _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context));
+		}
+		case SLiMCompiledOp::kPower:
+		{
+			double first_value = _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context);
+			return pow(first_value, _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context));
+		}
+		case SLiMCompiledOp::kIfElse:
+		{
+			// ifelse() evaluates all of its arguments, so we do too, to fail in the same cases
+			bool test = _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context);
+			double true_value = _SLiM_EvaluateCompiledFloat(p_nodes, node.child_[1], p_context);
+			double false_value = _SLiM_EvaluateCompiledFloat(p_nodes, node.child_[2], p_context);
+			
+			return (test ? true_value : false_value);
+		}
+		case SLiMCompiledOp::kConditional:
+		{
+			if (_SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context))
+				return _SLiM_EvaluateCompiledFloat(p_nodes, node.child_[1], p_context);
+			return _SLiM_EvaluateCompiledFloat(p_nodes, node.child_[2], p_context);
+		}
+		case SLiMCompiledOp::kExp:					return exp(_SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context));
+		case SLiMCompiledOp::kLog:					return log(_SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context));
+		case SLiMCompiledOp::kLog10:				return log10(_SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context));
+		case SLiMCompiledOp::kSqrt:					return sqrt(_SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context));
+		case SLiMCompiledOp::kAbs:					return fabs(_SLiM_EvaluateCompiledFloat(p_nodes, node.child_[0], p_context));
+		case SLiMCompiledOp::kDnorm:
+		{
+			double x = _SLiM_EvaluateCompiledFloat(p_nodes, node.child_[0], p_context);
+			double mu = ((node.child_[1] == -1) ? 0.0 : _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context));
+			double sigma = ((node.child_[2] == -1) ? 1.0 : _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[2], p_context));
+			
+			if (sigma <= 0.0)
+			{
+				p_context.failed_ = true;
+				return 0.0;
+			}
+			
+			return gsl_ran_gaussian_pdf(x - mu, sigma);
+		}
+		default:
+			p_context.failed_ = true;
+			return 0.0;
+	}
+}
+
+static int64_t _SLiM_EvaluateCompiledInt(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context)
+{
+	const SLiMCompiledNode &node = p_nodes[p_index];
+	
+	switch (node.op_)
+	{
+		case SLiMCompiledOp::kConstant:				return node.int_value_;
+		case SLiMCompiledOp::kMutPosition:			return p_context.mut_->position_;
+		case SLiMCompiledOp::kMutOriginGeneration:	return p_context.mut_->origin_generation_;
+		case SLiMCompiledOp::kMutID:				return p_context.mut_->mutation_id_;
+		case SLiMCompiledOp::kSimGeneration:		return p_context.sim_->Generation();
+		case SLiMCompiledOp::kIndividualTag:
+		{
+			slim_usertag_t tag_value = p_context.individual_->tag_value_;
+			
+			if (tag_value == SLIM_TAG_UNSET_VALUE)
+				p_context.failed_ = true;
+			
+			return tag_value;
+		}
+#ifdef SLIM_NONWF_ONLY
+		case SLiMCompiledOp::kIndividualAge:
+		{
+			slim_age_t age = p_context.individual_->age_;
+			
+			if (age == -1)
+				p_context.failed_ = true;
+			
+			return age;
+		}
+#endif
+		case SLiMCompiledOp::kNegate:
+		{
+			int64_t operand = _SLiM_EvaluateCompiledInt(p_nodes, node.child_[0], p_context);
+			
+			if (operand == INT64_MIN)
+			{
+				p_context.failed_ = true;
+				return 0;
+			}
+			
+			return -operand;
+		}
+		case SLiMCompiledOp::kAbs:
+		{
+			int64_t operand = _SLiM_EvaluateCompiledInt(p_nodes, node.child_[0], p_context);
+			
+			if (operand == INT64_MIN)
+			{
+				p_context.failed_ = true;
+				return 0;
+			}
+			
+			return llabs(operand);
+		}
+		case SLiMCompiledOp::kAdd:
+		case SLiMCompiledOp::kSubtract:
+		case SLiMCompiledOp::kMultiply:
+		{
+			int64_t first_value = _SLiM_EvaluateCompiledInt(p_nodes, node.child_[0], p_context);
+			int64_t second_value = _SLiM_EvaluateCompiledInt(p_nodes, node.child_[1], p_context);
+			int64_t result;
+			
+#if EIDOS_HAS_OVERFLOW_BUILTINS
+			bool overflow;
+			
+			if (node.op_ == SLiMCompiledOp::kAdd)			overflow = Eidos_add_overflow(first_value, second_value, &result);
+			else if (node.op_ == SLiMCompiledOp::kSubtract)	overflow = Eidos_sub_overflow(first_value, second_value, &result);
+			else											overflow = Eidos_mul_overflow(first_value, second_value, &result);
+			
+			if (overflow)
+				p_context.failed_ = true;
+#else
+			if (node.op_ == SLiMCompiledOp::kAdd)			result = first_value + second_value;
+			else if (node.op_ == SLiMCompiledOp::kSubtract)	result = first_value - second_value;
+			else											result = first_value * second_value;
+#endif
+			
+			return result;
+		}
+		case SLiMCompiledOp::kIfElse:
+		{
+			bool test = _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context);
+			int64_t true_value = _SLiM_EvaluateCompiledInt(p_nodes, node.child_[1], p_context);
+			int64_t false_value = _SLiM_EvaluateCompiledInt(p_nodes, node.child_[2], p_context);
+			
+			return (test ? true_value : false_value);
+		}
+		case SLiMCompiledOp::kConditional:
+		{
+			if (_SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context))
+				return _SLiM_EvaluateCompiledInt(p_nodes, node.child_[1], p_context);
+			return _SLiM_EvaluateCompiledInt(p_nodes, node.child_[2], p_context);
+		}
+		default:
+			p_context.failed_ = true;
+			return 0;
+	}
+}
+
+static bool _SLiM_EvaluateCompiledLogical(const SLiMCompiledNode *p_nodes, int32_t p_index, SLiMCompiledContext &p_context)
+{
+	const SLiMCompiledNode &node = p_nodes[p_index];
+	
+	switch (node.op_)
+	{
+		case SLiMCompiledOp::kConstant:				return (node.float_value_ != 0.0);
+		case SLiMCompiledOp::kHomozygous:
+		{
+			// a mutation opposed by a null genome gets a homozygous value of NULL, which we do not handle
+			if (p_context.homozygous_ == -1)
+				p_context.failed_ = true;
+			
+			return (p_context.homozygous_ == 1);
+		}
+		case SLiMCompiledOp::kNot:					return !_SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context);
+		case SLiMCompiledOp::kAnd:
+		{
+			bool first_value = _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context);
+			return (_SLiM_EvaluateCompiledLogical(p_nodes, node.child_[1], p_context) && first_value);
+		}
+		case SLiMCompiledOp::kOr:
+		{
+			bool first_value = _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context);
+			return (_SLiM_EvaluateCompiledLogical(p_nodes, node.child_[1], p_context) || first_value);
+		}
+		case SLiMCompiledOp::kLess:
+		case SLiMCompiledOp::kLessEqual:
+		case SLiMCompiledOp::kGreater:
+		case SLiMCompiledOp::kGreaterEqual:
+		case SLiMCompiledOp::kEqual:
+		case SLiMCompiledOp::kNotEqual:
+		{
+			int comparison;		// -1, 0, or 1; 2 for unordered (NAN)
+			
+			if (node.operand_type_ == EidosValueType::kValueFloat)
+			{
+				double first_value = _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[0], p_context);
+				double second_value = _SLiM_EvaluateCompiledAsFloat(p_nodes, node.child_[1], p_context);
+				
+				comparison = ((first_value < second_value) ? -1 : ((first_value > second_value) ? 1 : ((first_value == second_value) ? 0 : 2)));
+			}
+			else
+			{
+				int64_t first_value = _SLiM_EvaluateCompiledAsInt(p_nodes, node.child_[0], p_context);
+				int64_t second_value = _SLiM_EvaluateCompiledAsInt(p_nodes, node.child_[1], p_context);
+				
+				comparison = ((first_value < second_value) ? -1 : ((first_value > second_value) ? 1 : 0));
+			}
+			
+			switch (node.op_)
+			{
+				case SLiMCompiledOp::kLess:			return (comparison == -1);
+				case SLiMCompiledOp::kLessEqual:	return ((comparison == -1) || (comparison == 0));
+				case SLiMCompiledOp::kGreater:		return (comparison == 1);
+				case SLiMCompiledOp::kGreaterEqual:	return ((comparison == 1) || (comparison == 0));
+				case SLiMCompiledOp::kEqual:		return (comparison == 0);
+				default:							return (comparison != 0);
+			}
+		}
+		case SLiMCompiledOp::kIfElse:
+		{
+			bool test = _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context);
+			bool true_value = _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[1], p_context);
+			bool false_value = _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[2], p_context);
+			
+			return (test ? true_value : false_value);
+		}
+		case SLiMCompiledOp::kConditional:
+		{
+			if (_SLiM_EvaluateCompiledLogical(p_nodes, node.child_[0], p_context))
+				return _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[1], p_context);
+			return _SLiM_EvaluateCompiledLogical(p_nodes, node.child_[2], p_context);
+		}
+		default:
+			p_context.failed_ = true;
+			return false;
+	}
+}
+
+bool SLiMEidosBlock::EvaluateCompiledCallback(double p_rel_fitness, int p_homozygous, const Mutation *p_mut, const Individual *p_individual, const SLiMSim *p_sim, double *p_result) const
+{
+	// Returns false if evaluation failed, in which case the caller must run the interpreter instead; this is safe because
+	// the compiled subset has no side effects
+	SLiMCompiledContext context = {p_rel_fitness, p_homozygous, p_mut, p_individual, p_sim, false};
+	
+	double result = _SLiM_EvaluateCompiledFloat(compiled_nodes_.data(), (int32_t)(compiled_nodes_.size() - 1), context);
+	
+	if (context.failed_)
+		return false;
+	
+	*p_result = result;
+	return true;
+}
+
 //
 //	Eidos support
 //
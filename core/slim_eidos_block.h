@@ -107,6 +107,72 @@ public:
 
 extern EidosClass *gSLiM_SLiMEidosBlock_Class;
 
+class Mutation;
+class Individual;
+
+
+// The operations of a compiled callback expression; see SLiMEidosBlock::CompileArithmeticCallback().  Each node of the
+// compiled tree has a static type of logical, integer, or float, determined at compile time just as the interpreter would
+// determine it at runtime, so the evaluator below never needs to box values or consult a symbol table.
+enum class SLiMCompiledOp : uint8_t {
+	kConstant = 0,
+	kRelFitness,
+	kHomozygous,
+	kMutSelectionCoeff,
+	kMutPosition,
+	kMutOriginGeneration,
+	kMutID,
+	kIndividualTag,
+	kIndividualTagF,
+	kIndividualAge,
+	kSimGeneration,
+	kNegate,
+	kNot,
+	kAdd,
+	kSubtract,
+	kMultiply,
+	kDivide,
+	kMod,
+	kPower,
+	kLess,
+	kLessEqual,
+	kGreater,
+	kGreaterEqual,
+	kEqual,
+	kNotEqual,
+	kAnd,
+	kOr,
+	kIfElse,
+	kConditional,
+	kExp,
+	kLog,
+	kLog10,
+	kSqrt,
+	kAbs,
+	kDnorm
+};
+
+typedef struct {
+	SLiMCompiledOp op_;
+	EidosValueType type_;			// kValueLogical, kValueInt, or kValueFloat
+	EidosValueType operand_type_;	// for comparisons, the type to which the operands are promoted
+	int32_t child_[3];				// indices of child nodes in compiled_nodes_, or -1
+	double float_value_;			// the value of a float or logical constant
+	int64_t int_value_;				// the value of an integer constant
+} SLiMCompiledNode;
+
+// The values a compiled callback may read; the caller supplies those that are meaningful for the callback type.  If evaluation
+// hits a case the compiled code does not handle (an integer overflow, an unset tag, a NULL homozygous, sd <= 0 for dnorm()),
+// failed_ is set and the caller falls back to the interpreter, which then produces the appropriate error or result.
+typedef struct {
+	double rel_fitness_;
+	int homozygous_;				// -1 for NULL, 0 for F, 1 for T, as in Subpopulation::ApplyFitnessCallbacks()
+	const Mutation *mut_;
+	const Individual *individual_;
+	const SLiMSim *sim_;
+	bool failed_;
+} SLiMCompiledContext;
+
 
 class SLiMEidosBlock : public EidosDictionaryUnretained
 {
@@ -179,6 +245,11 @@ public:
 	bool contains_fitness_ = false;				// "fitness" (survival callback parameter)
 	bool contains_draw_ = false;				// "draw" (survival callback parameter)
 	
+	// Set by ScanTreeForIdentifiersUsed() if executing the block might change the state of script blocks: it uses "active",
+	// "source", "deregisterScriptBlock", "rescheduleScriptBlock", or a register...() method, calls a function that is not
+	// built into Eidos (which could do anything), or contains a wildcard.  See the nonneutral caching regimes in mutation_run.h.
+	bool may_alter_script_blocks_ = false;
+	
 	// Special-case optimizations for particular common callback types.  If a callback can be substituted by C++ code,
 	// has_cached_optimization_ will be true and the flags and values below will indicate exactly how to do so.
 	bool has_cached_optimization_ = false;
@@ -189,6 +260,10 @@ public:
 	double cached_opt_C_ = 0.0;
 	double cached_opt_D_ = 0.0;
 	
+	// A compiled form of callbacks whose body is a single return of a pure arithmetic expression; empty if the callback was not
+	// compiled.  The root is the last node.  This generalizes the pattern-matched optimizations above; see SLiMSim::OptimizeScriptBlock().
+	std::vector<SLiMCompiledNode> compiled_nodes_;
+	
 	
 	SLiMEidosBlock(const SLiMEidosBlock&) = delete;					// no copying
 	SLiMEidosBlock& operator=(const SLiMEidosBlock&) = delete;		// no copying
@@ -205,6 +280,11 @@ public:
 	void _ScanNodeForIdentifiersUsed(const EidosASTNode *p_scan_node);
 	void ScanTreeForIdentifiersUsed(void);
 	
+	// Compile the body of a fitness() callback into compiled_nodes_ if it lies within the supported subset of Eidos, and evaluate it
+	int32_t _CompileArithmeticNode(const EidosASTNode *p_node);
+	void CompileArithmeticCallback(void);
+	bool EvaluateCompiledCallback(double p_rel_fitness, int p_homozygous, const Mutation *p_mut, const Individual *p_individual, const SLiMSim *p_sim, double *p_result) const;
+	
 	//
 	// Eidos support
 	//
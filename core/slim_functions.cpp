@@ -32,13 +32,7 @@
 #include <vector>
 #include <limits>
 #include <algorithm>
-
-
-extern const char *gSLiMSourceCode_calcFST;
-extern const char *gSLiMSourceCode_calcVA;
-extern const char *gSLiMSourceCode_calcPairHeterozygosity;
-extern const char *gSLiMSourceCode_calcHeterozygosity;
-extern const char *gSLiMSourceCode_calcWattersonsTheta;
+#include <cmath>
 
 
 const std::vector<EidosFunctionSignature_CSP> *SLiMSim::SLiMFunctionSignatures(void)
@@ -59,12 +53,12 @@ const std::vector<EidosFunctionSignature_CSP> *SLiMSim::SLiMFunctionSignatures(v
 		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("nucleotidesToCodons", SLiM_ExecuteFunction_nucleotidesToCodons, kEidosValueMaskInt, "SLiM"))->AddIntString("sequence"));
 		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("randomNucleotides", SLiM_ExecuteFunction_randomNucleotides, kEidosValueMaskInt | kEidosValueMaskString, "SLiM"))->AddInt_S("length")->AddNumeric_ON("basis", gStaticEidosValueNULL)->AddString_OS("format", EidosValue_String_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_String_singleton("string"))));
 		
-		// Population genetics utilities (implemented with Eidos code
-		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcFST", gSLiMSourceCode_calcFST, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("genomes1", gSLiM_Genome_Class)->AddObject("genomes2", gSLiM_Genome_Class)->AddObject_ON("muts", gSLiM_Mutation_Class, gStaticEidosValueNULL)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL));
-		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcVA", gSLiMSourceCode_calcVA, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("individuals", gSLiM_Individual_Class)->AddIntObject_S("mutType", gSLiM_MutationType_Class));
-		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcPairHeterozygosity", gSLiMSourceCode_calcPairHeterozygosity, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject_S("genome1", gSLiM_Genome_Class)->AddObject_S("genome2", gSLiM_Genome_Class)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL)->AddLogical_OS("infiniteSites", gStaticEidosValue_LogicalT));
-		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcHeterozygosity", gSLiMSourceCode_calcHeterozygosity, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("genomes", gSLiM_Genome_Class)->AddObject_ON("muts", gSLiM_Mutation_Class, gStaticEidosValueNULL)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL));
-		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcWattersonsTheta", gSLiMSourceCode_calcWattersonsTheta, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("genomes", gSLiM_Genome_Class)->AddObject_ON("muts", gSLiM_Mutation_Class, gStaticEidosValueNULL)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL));
+		// Population genetics utilities
+		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcFST", SLiM_ExecuteFunction_calcFST, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("genomes1", gSLiM_Genome_Class)->AddObject("genomes2", gSLiM_Genome_Class)->AddObject_ON("muts", gSLiM_Mutation_Class, gStaticEidosValueNULL)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL));
+		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcVA", SLiM_ExecuteFunction_calcVA, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("individuals", gSLiM_Individual_Class)->AddIntObject_S("mutType", gSLiM_MutationType_Class));
+		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcPairHeterozygosity", SLiM_ExecuteFunction_calcPairHeterozygosity, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject_S("genome1", gSLiM_Genome_Class)->AddObject_S("genome2", gSLiM_Genome_Class)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL)->AddLogical_OS("infiniteSites", gStaticEidosValue_LogicalT));
+		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcHeterozygosity", SLiM_ExecuteFunction_calcHeterozygosity, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("genomes", gSLiM_Genome_Class)->AddObject_ON("muts", gSLiM_Mutation_Class, gStaticEidosValueNULL)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL));
+		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("calcWattersonsTheta", SLiM_ExecuteFunction_calcWattersonsTheta, kEidosValueMaskFloat | kEidosValueMaskSingleton, "SLiM"))->AddObject("genomes", gSLiM_Genome_Class)->AddObject_ON("muts", gSLiM_Mutation_Class, gStaticEidosValueNULL)->AddInt_OSN("start", gStaticEidosValueNULL)->AddInt_OSN("end", gStaticEidosValueNULL));
 		
 		// Other built-in SLiM functions
 		sim_func_signatures_.emplace_back((EidosFunctionSignature *)(new EidosFunctionSignature("summarizeIndividuals", SLiM_ExecuteFunction_summarizeIndividuals, kEidosValueMaskFloat, "SLiM"))->AddObject("individuals", gSLiM_Individual_Class)->AddInt("dim")->AddNumeric("spatialBounds")->AddString_S("operation")->AddLogicalEquiv_OSN("empty", gStaticEidosValue_Float0)->AddLogical_OS("perUnitArea", gStaticEidosValue_LogicalF)->AddString_OSN("spatiality", gStaticEidosValueNULL));
@@ -83,139 +77,371 @@ const std::vector<EidosFunctionSignature_CSP> *SLiMSim::SLiMFunctionSignatures(v
 #pragma mark Population genetics utilities
 #pragma mark -
 
-// These are implemented in Eidos, for transparency/modifiability.  These strings are globals mostly so the
-// formatting of the code looks nice in Xcode; they are used only by SLiMSim::SLiMFunctionSignatures().
+// These are implemented natively, working directly from the mutation runs of the genomes and from the refcounts
+// tallied by Population, rather than building vectors of mutations and frequencies in Eidos.  Each function's
+// comment gives the Eidos code it is equivalent to; the floating-point operations are done in the same order,
+// so the results match that code exactly.
 
-// (float$)calcFST(object<Genome> genomes1, object<Genome> genomes2, [No<Mutation> muts = NULL], [Ni$ start = NULL], [Ni$ end = NULL])
-const char *gSLiMSourceCode_calcFST = 
-R"({
-	// handle windowing
-	if (!isNULL(start) & !isNULL(end))
+// Handle the optional [start, end] window shared by these functions; returns true if windowing was requested
+static bool SLiM_PopGenWindow(EidosValue *p_start_value, EidosValue *p_end_value, slim_position_t *p_start, slim_position_t *p_end, const char *p_function_name)
+{
+	bool start_null = (p_start_value->Type() == EidosValueType::kValueNULL);
+	bool end_null = (p_end_value->Type() == EidosValueType::kValueNULL);
+	
+	if (!start_null && !end_null)
 	{
-		if (start > end)
-			stop("ERROR (calcFST()): start must be less than or equal to end");
-		if (isNULL(muts))
-			muts = sim.mutations;
-		mpos = muts.position;
-		muts = muts[(mpos >= start) & (mpos <= end)];
-		length = end - start + 1;
+		*p_start = p_start_value->IntAtIndex(0, nullptr);
+		*p_end = p_end_value->IntAtIndex(0, nullptr);
+		
+		if (*p_start > *p_end)
+			EIDOS_TERMINATION << "ERROR (" << p_function_name << "): start must be less than or equal to end." << EidosTerminate();
+		
+		return true;
 	}
-	else if (!isNULL(start) | !isNULL(end))
+	else if (!start_null || !end_null)
 	{
-		stop("ERROR (calcFST()): start and end must both be NULL or both be non-NULL");
+		EIDOS_TERMINATION << "ERROR (" << p_function_name << "): start and end must both be NULL or both be non-NULL." << EidosTerminate();
 	}
 	
-	// do the calculation
-	p1_p = genomes1.mutationFrequenciesInGenomes(muts);
-	p2_p = genomes2.mutationFrequenciesInGenomes(muts);
-	mean_p = (p1_p + p2_p) / 2.0;
-	H_t = 2.0 * mean_p * (1.0 - mean_p);
-	H_s = p1_p * (1.0 - p1_p) + p2_p * (1.0 - p2_p);
-	fst = 1.0 - H_s/H_t;
-	fst = fst[!isNAN(fst)];  // exclude muts where mean_p is 0.0 or 1.0
-	return mean(fst);
-})";
-
-// (float$)calcVA(object<Individual> individuals, io<MutationType>$ mutType)
-const char *gSLiMSourceCode_calcVA = 
-R"({
-	// look up an integer mutation type id
-	if (type(mutType) == "integer") {
-		mutType = sim.mutationTypes[sim.mutationTypes.id == mutType];
-		assert(length(mutType) == 1, "calcVA() mutation type lookup failed");
-	}
-	return var(individuals.sumOfMutationsOfType(mutType));
-})";
-
-// (float$)calcPairHeterozygosity(object<Genome>$ genome1, object<Genome>$ genome2, [Ni$ start = NULL], [Ni$ end = NULL], [l$ infiniteSites = T])
-const char *gSLiMSourceCode_calcPairHeterozygosity = 
-R"({
-	muts1 = genome1.mutations;
-	muts2 = genome2.mutations;
-	length = sim.chromosome.lastPosition + 1;
-
-	// handle windowing
-	if (!isNULL(start) & !isNULL(end))
+	return false;
+}
+
+// Collect the mutations to be assessed: muts, or all segregating mutations if muts is NULL, limited to the window if any
+static void SLiM_PopGenMutations(Population &p_population, EidosValue *p_muts_value, bool p_windowed, slim_position_t p_start, slim_position_t p_end, std::vector<Mutation *> &p_muts)
+{
+	p_muts.clear();
+	
+	if (p_muts_value->Type() == EidosValueType::kValueNULL)
 	{
-		if (start > end)
-			stop("ERROR (calcPairHeterozygosity()): start must be less than or equal to end");
-		m1pos = muts1.position;
-		m2pos = muts2.position;
-		muts1 = muts1[(m1pos >= start) & (m1pos <= end)];
-		muts2 = muts2[(m2pos >= start) & (m2pos <= end)];
-		length = end - start + 1;
+		Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+		int registry_size;
+		const MutationIndex *registry = p_population.MutationRegistry(&registry_size);
+		
+		p_muts.reserve(registry_size);
+		
+		for (int registry_index = 0; registry_index < registry_size; ++registry_index)
+		{
+			Mutation *mut = mut_block_ptr + registry[registry_index];
+			
+			if (!p_windowed || ((mut->position_ >= p_start) && (mut->position_ <= p_end)))
+				p_muts.emplace_back(mut);
+		}
 	}
-	else if (!isNULL(start) | !isNULL(end))
+	else
 	{
-		stop("ERROR (calcPairHeterozygosity()): start and end must both be NULL or both be non-NULL");
+		int muts_count = p_muts_value->Count();
+		
+		p_muts.reserve(muts_count);
+		
+		for (int muts_index = 0; muts_index < muts_count; ++muts_index)
+		{
+			Mutation *mut = (Mutation *)p_muts_value->ObjectElementAtIndex(muts_index, nullptr);
+			
+			if (!p_windowed || ((mut->position_ >= p_start) && (mut->position_ <= p_end)))
+				p_muts.emplace_back(mut);
+		}
 	}
+}
 
-	// do the calculation
-	unshared = setSymmetricDifference(muts1, muts2);
-	if (!infiniteSites)
-		unshared = unique(unshared.position, preserveOrder=F);
+// Collect the genomes to be tallied, with the same checks as mutationFrequenciesInGenomes()
+static void SLiM_PopGenGenomes(EidosValue *p_genomes_value, std::vector<Genome *> &p_genomes, const char *p_function_name)
+{
+	int genomes_count = p_genomes_value->Count();
+	
+	if (genomes_count == 0)
+		EIDOS_TERMINATION << "ERROR (" << p_function_name << "): cannot calculate frequencies in a zero-length Genome vector (divide by zero)." << EidosTerminate();
+	
+	p_genomes.clear();
+	p_genomes.reserve(genomes_count);
+	
+	for (int genome_index = 0; genome_index < genomes_count; ++genome_index)
+	{
+		Genome *genome = (Genome *)p_genomes_value->ObjectElementAtIndex(genome_index, nullptr);
+		
+		if (genome->IsNull())
+			EIDOS_TERMINATION << "ERROR (" << p_function_name << "): cannot calculate frequencies in a null genome." << EidosTerminate();
+		
+		p_genomes.emplace_back(genome);
+	}
+}
 
-	return size(unshared) / length;
-})";
+// The frequency of a mutation after Population::TallyMutationReferences(), as in Population::Eidos_FrequenciesForTalliedMutations()
+static inline double SLiM_PopGenTalliedFrequency(const Mutation *p_mut, double p_denominator)
+{
+	int8_t mut_state = p_mut->state_;
+	
+	if (mut_state == MutationState::kInRegistry)			return *(gSLiM_Mutation_Refcounts + p_mut->BlockIndex()) / p_denominator;
+	else if (mut_state == MutationState::kLostAndRemoved)	return 0.0;
+	else													return 1.0;
+}
 
-// (float$)calcHeterozygosity(o<Genome> genomes, [No<Mutation> muts = NULL], [Ni$ start = NULL], [Ni$ end = NULL])
-const char *gSLiMSourceCode_calcHeterozygosity = 
-R"({
-	length = sim.chromosome.lastPosition + 1;
+//	(float$)calcFST(object<Genome> genomes1, object<Genome> genomes2, [No<Mutation> muts = NULL], [Ni$ start = NULL], [Ni$ end = NULL])
+//
+//	p1_p = genomes1.mutationFrequenciesInGenomes(muts);
+//	p2_p = genomes2.mutationFrequenciesInGenomes(muts);
+//	mean_p = (p1_p + p2_p) / 2.0;
+//	H_t = 2.0 * mean_p * (1.0 - mean_p);
+//	H_s = p1_p * (1.0 - p1_p) + p2_p * (1.0 - p2_p);
+//	fst = 1.0 - H_s/H_t;
+//	fst = fst[!isNAN(fst)];  // exclude muts where mean_p is 0.0 or 1.0
+//	return mean(fst);
+//
+EidosValue_SP SLiM_ExecuteFunction_calcFST(const std::vector<EidosValue_SP> &p_arguments, __attribute__((unused)) EidosInterpreter &p_interpreter)
+{
+	EidosValue *genomes1_value = p_arguments[0].get();
+	EidosValue *genomes2_value = p_arguments[1].get();
+	EidosValue *muts_value = p_arguments[2].get();
+	EidosValue *start_value = p_arguments[3].get();
+	EidosValue *end_value = p_arguments[4].get();
+	
+	SLiMSim &sim = SLiM_GetSimFromInterpreter(p_interpreter);
+	Population &population = sim.ThePopulation();
+	slim_position_t start = 0, end = 0;
+	bool windowed = SLiM_PopGenWindow(start_value, end_value, &start, &end, "calcFST()");
+	
+	static std::vector<Mutation *> muts;		// prevent reallocation by using statics
+	static std::vector<Genome *> genomes;
+	static std::vector<double> p1_freqs;
+	
+	SLiM_PopGenMutations(population, muts_value, windowed, start, end, muts);
+	
+	size_t muts_count = muts.size();
+	
+	// tally genomes1 and save its frequencies; the refcount buffer is then reused for genomes2
+	SLiM_PopGenGenomes(genomes1_value, genomes, "calcFST()");
+	population.TallyMutationReferences(&genomes);
+	
+	double denominator1 = genomes.size();
+	
+	p1_freqs.resize(muts_count);
+	
+	for (size_t mut_index = 0; mut_index < muts_count; ++mut_index)
+		p1_freqs[mut_index] = SLiM_PopGenTalliedFrequency(muts[mut_index], denominator1);
+	
+	SLiM_PopGenGenomes(genomes2_value, genomes, "calcFST()");
+	population.TallyMutationReferences(&genomes);
+	
+	double denominator2 = genomes.size();
+	double fst_total = 0.0;
+	int64_t fst_count = 0;
+	
+	for (size_t mut_index = 0; mut_index < muts_count; ++mut_index)
+	{
+		double p1_p = p1_freqs[mut_index];
+		double p2_p = SLiM_PopGenTalliedFrequency(muts[mut_index], denominator2);
+		double mean_p = (p1_p + p2_p) / 2.0;
+		double H_t = 2.0 * mean_p * (1.0 - mean_p);
+		double H_s = p1_p * (1.0 - p1_p) + p2_p * (1.0 - p2_p);
+		double fst = 1.0 - H_s / H_t;
+		
+		if (!std::isnan(fst))
+		{
+			fst_total += fst;
+			fst_count++;
+		}
+	}
+	
+	if (fst_count == 0)
+		return gStaticEidosValueNULL;
+	
+	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(fst_total / fst_count));
+}
 
-	// handle windowing
-	if (!isNULL(start) & !isNULL(end))
+//	(float$)calcVA(object<Individual> individuals, io<MutationType>$ mutType)
+//
+//	return var(individuals.sumOfMutationsOfType(mutType));
+//
+EidosValue_SP SLiM_ExecuteFunction_calcVA(const std::vector<EidosValue_SP> &p_arguments, __attribute__((unused)) EidosInterpreter &p_interpreter)
+{
+	EidosValue *individuals_value = p_arguments[0].get();
+	EidosValue *mutType_value = p_arguments[1].get();
+	
+	SLiMSim &sim = SLiM_GetSimFromInterpreter(p_interpreter);
+	MutationType *mutation_type_ptr;
+	int individuals_count = individuals_value->Count();
+	
+	// look up an integer mutation type id; a failed lookup raises the same error as the old Eidos implementation did
+	if (mutType_value->Type() == EidosValueType::kValueInt)
 	{
-		if (start > end)
-			stop("ERROR (calcHeterozygosity()): start must be less than or equal to end");
-		if (isNULL(muts))
-			muts = sim.mutations;
-		mpos = muts.position;
-		muts = muts[(mpos >= start) & (mpos <= end)];
-		length = end - start + 1;
+		int64_t mutType_id = mutType_value->IntAtIndex(0, nullptr);
+		
+		mutation_type_ptr = ((mutType_id >= 0) && (mutType_id <= SLIM_MAX_ID_VALUE)) ? sim.MutationTypeWithID((slim_objectid_t)mutType_id) : nullptr;
+		
+		if (!mutation_type_ptr)
+			EIDOS_TERMINATION << "ERROR (SLiM_ExecuteFunction_calcVA): assertion failed: calcVA() mutation type lookup failed." << EidosTerminate();
 	}
-	else if (!isNULL(start) | !isNULL(end))
+	else
 	{
-		stop("ERROR (calcHeterozygosity()): start and end must both be NULL or both be non-NULL");
+		mutation_type_ptr = (MutationType *)mutType_value->ObjectElementAtIndex(0, nullptr);
 	}
+	
+	// var() of fewer than two values is NULL
+	if (individuals_count <= 1)
+		return gStaticEidosValueNULL;
+	
+	// sum the selection coefficients of the mutations of the given type in each individual, as sumOfMutationsOfType() does
+	static std::vector<double> selcoeff_sums;		// prevent reallocation by using a static
+	
+	selcoeff_sums.resize(individuals_count);
+	
+	for (int individual_index = 0; individual_index < individuals_count; ++individual_index)
+	{
+		Individual *individual = (Individual *)individuals_value->ObjectElementAtIndex(individual_index, nullptr);
+		
+		selcoeff_sums[individual_index] = individual->SumOfMutationsOfType(mutation_type_ptr);
+	}
+	
+	// calculate the variance as var() does
+	double mean = 0;
+	
+	for (int individual_index = 0; individual_index < individuals_count; ++individual_index)
+		mean += selcoeff_sums[individual_index];
+	
+	mean /= individuals_count;
+	
+	double var = 0;
+	
+	for (int individual_index = 0; individual_index < individuals_count; ++individual_index)
+	{
+		double temp = (selcoeff_sums[individual_index] - mean);
+		var += temp * temp;
+	}
+	
+	var = var / (individuals_count - 1);
+	
+	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(var));
+}
 
-	// do the calculation
-	p = genomes.mutationFrequenciesInGenomes(muts);
-	heterozygosity = 2 * sum(p * (1 - p)) / length;
-	return heterozygosity;
-})";
-
-// (float$)calcWattersonsTheta(o<Genome> genomes, [No<Mutation> muts = NULL], [Ni$ start = NULL], [Ni$ end = NULL])
-const char *gSLiMSourceCode_calcWattersonsTheta = 
-R"({
-	if (isNULL(muts))
-		muts = sim.mutations;
+//	(float$)calcPairHeterozygosity(object<Genome>$ genome1, object<Genome>$ genome2, [Ni$ start = NULL], [Ni$ end = NULL], [l$ infiniteSites = T])
+//
+//	unshared = setSymmetricDifference(genome1.mutations, genome2.mutations);
+//	if (!infiniteSites)
+//		unshared = unique(unshared.position, preserveOrder=F);
+//	return size(unshared) / length;
+//
+EidosValue_SP SLiM_ExecuteFunction_calcPairHeterozygosity(const std::vector<EidosValue_SP> &p_arguments, __attribute__((unused)) EidosInterpreter &p_interpreter)
+{
+	EidosValue *genome1_value = p_arguments[0].get();
+	EidosValue *genome2_value = p_arguments[1].get();
+	EidosValue *start_value = p_arguments[2].get();
+	EidosValue *end_value = p_arguments[3].get();
+	EidosValue *infiniteSites_value = p_arguments[4].get();
+	
+	SLiMSim &sim = SLiM_GetSimFromInterpreter(p_interpreter);
+	Genome *genome1 = (Genome *)genome1_value->ObjectElementAtIndex(0, nullptr);
+	Genome *genome2 = (Genome *)genome2_value->ObjectElementAtIndex(0, nullptr);
+	bool infinite_sites = infiniteSites_value->LogicalAtIndex(0, nullptr);
+	int64_t length = sim.TheChromosome().last_position_ + 1;
+	slim_position_t start = 0, end = 0;
+	bool windowed = SLiM_PopGenWindow(start_value, end_value, &start, &end, "calcPairHeterozygosity()");
+	
+	if (windowed)
+		length = end - start + 1;
+	
+	int64_t unshared_count = Genome::UnsharedMutationCount(genome1, genome2, windowed, start, end, infinite_sites);
+	
+	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(unshared_count / (double)length));
+}
 
-	// handle windowing
-	if (!isNULL(start) & !isNULL(end))
-	{
-		if (start > end)
-			stop("ERROR (calcWattersonsTheta()): start must be less than or equal to end");
-		mpos = muts.position;
-		muts = muts[(mpos >= start) & (mpos <= end)];
+//	(float$)calcHeterozygosity(o<Genome> genomes, [No<Mutation> muts = NULL], [Ni$ start = NULL], [Ni$ end = NULL])
+//
+//	p = genomes.mutationFrequenciesInGenomes(muts);
+//	heterozygosity = 2 * sum(p * (1 - p)) / length;
+//	return heterozygosity;
+//
+EidosValue_SP SLiM_ExecuteFunction_calcHeterozygosity(const std::vector<EidosValue_SP> &p_arguments, __attribute__((unused)) EidosInterpreter &p_interpreter)
+{
+	EidosValue *genomes_value = p_arguments[0].get();
+	EidosValue *muts_value = p_arguments[1].get();
+	EidosValue *start_value = p_arguments[2].get();
+	EidosValue *end_value = p_arguments[3].get();
+	
+	SLiMSim &sim = SLiM_GetSimFromInterpreter(p_interpreter);
+	Population &population = sim.ThePopulation();
+	int64_t length = sim.TheChromosome().last_position_ + 1;
+	slim_position_t start = 0, end = 0;
+	bool windowed = SLiM_PopGenWindow(start_value, end_value, &start, &end, "calcHeterozygosity()");
+	
+	if (windowed)
 		length = end - start + 1;
-	}
-	else if (!isNULL(start) | !isNULL(end))
+	
+	static std::vector<Mutation *> muts;		// prevent reallocation by using statics
+	static std::vector<Genome *> genomes;
+	
+	SLiM_PopGenMutations(population, muts_value, windowed, start, end, muts);
+	SLiM_PopGenGenomes(genomes_value, genomes, "calcHeterozygosity()");
+	population.TallyMutationReferences(&genomes);
+	
+	double denominator = genomes.size();
+	double total = 0.0;
+	
+	for (Mutation *mut : muts)
 	{
-		stop("ERROR (calcWattersonsTheta()): start and end must both be NULL or both be non-NULL");
+		double p = SLiM_PopGenTalliedFrequency(mut, denominator);
+		
+		total += p * (1 - p);
 	}
+	
+	double heterozygosity = 2 * total / length;
+	
+	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(heterozygosity));
+}
 
-	// narrow down to the mutations that are actually present in the genomes and aren't fixed
-	p = genomes.mutationFrequenciesInGenomes(muts);
-	muts = muts[(p != 0.0) & (p != 1.0)];
-
-	// do the calculation
-	k = size(muts);
-	n = genomes.size();
-	a_n = sum(1 / 1:(n-1));
-	theta = (k / a_n) / (sim.chromosome.lastPosition + 1);
-	return theta;
-})";
+//	(float$)calcWattersonsTheta(o<Genome> genomes, [No<Mutation> muts = NULL], [Ni$ start = NULL], [Ni$ end = NULL])
+//
+//	p = genomes.mutationFrequenciesInGenomes(muts);
+//	muts = muts[(p != 0.0) & (p != 1.0)];
+//	k = size(muts);
+//	n = genomes.size();
+//	a_n = sum(1 / 1:(n-1));
+//	theta = (k / a_n) / (sim.chromosome.lastPosition + 1);
+//	return theta;
+//
+EidosValue_SP SLiM_ExecuteFunction_calcWattersonsTheta(const std::vector<EidosValue_SP> &p_arguments, __attribute__((unused)) EidosInterpreter &p_interpreter)
+{
+	EidosValue *genomes_value = p_arguments[0].get();
+	EidosValue *muts_value = p_arguments[1].get();
+	EidosValue *start_value = p_arguments[2].get();
+	EidosValue *end_value = p_arguments[3].get();
+	
+	SLiMSim &sim = SLiM_GetSimFromInterpreter(p_interpreter);
+	Population &population = sim.ThePopulation();
+	slim_position_t start = 0, end = 0;
+	bool windowed = SLiM_PopGenWindow(start_value, end_value, &start, &end, "calcWattersonsTheta()");
+	
+	static std::vector<Mutation *> muts;		// prevent reallocation by using statics
+	static std::vector<Genome *> genomes;
+	
+	SLiM_PopGenMutations(population, muts_value, windowed, start, end, muts);
+	SLiM_PopGenGenomes(genomes_value, genomes, "calcWattersonsTheta()");
+	population.TallyMutationReferences(&genomes);
+	
+	// count the mutations that are segregating in the genomes; only these contribute to theta
+	double denominator = genomes.size();
+	int64_t k = 0;
+	
+	for (Mutation *mut : muts)
+	{
+		double p = SLiM_PopGenTalliedFrequency(mut, denominator);
+		
+		if ((p != 0.0) && (p != 1.0))
+			k++;
+	}
+	
+	// a_n is the harmonic number of n-1; for a single genome, 1:(n-1) is c(1, 0) and so a_n is INF
+	int64_t n = (int64_t)genomes.size();
+	double a_n = 0;
+	
+	if (n == 1)
+		a_n = std::numeric_limits<double>::infinity();
+	else
+		for (int64_t i = 1; i <= n - 1; ++i)
+			a_n += 1.0 / i;
+	
+	double theta = (k / a_n) / (sim.TheChromosome().last_position_ + 1);
+	
+	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(theta));
+}
 
 
 // ************************************************************************************
@@ -1197,6 +1197,7 @@ const std::string &gStr_periodicity = EidosRegisteredString("periodicity", gID_p
 const std::string &gStr_spatiality = EidosRegisteredString("spatiality", gID_spatiality);
 const std::string &gStr_spatialPosition = EidosRegisteredString("spatialPosition", gID_spatialPosition);
 const std::string &gStr_maxDistance = EidosRegisteredString("maxDistance", gID_maxDistance);
+const std::string &gStr_kernelTolerance = EidosRegisteredString("kernelTolerance", gID_kernelTolerance);
 
 // mostly method names
 const std::string &gStr_ancestralNucleotides = EidosRegisteredString("ancestralNucleotides", gID_ancestralNucleotides);
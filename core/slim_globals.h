@@ -686,6 +686,7 @@ extern const std::string &gStr_periodicity;
 extern const std::string &gStr_spatiality;
 extern const std::string &gStr_spatialPosition;
 extern const std::string &gStr_maxDistance;
+extern const std::string &gStr_kernelTolerance;
 
 extern const std::string &gStr_ancestralNucleotides;
 extern const std::string &gStr_nucleotides;
@@ -1029,6 +1030,7 @@ enum _SLiMGlobalStringID : int {
 	gID_spatiality,
 	gID_spatialPosition,
 	gID_maxDistance,
+	gID_kernelTolerance,
 	
 	gID_ancestralNucleotides,
 	gID_nucleotides,
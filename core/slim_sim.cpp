@@ -2154,6 +2154,11 @@ void SLiMSim::OptimizeScriptBlock(SLiMEidosBlock *p_script_block)
 //			else
 //				std::cout << "NOT OPTIMIZED:" << std::endl << "   " << base_node->token_->token_string_ << std::endl;
 		}
+		
+		// Callbacks that did not match one of the special cases above may still be simple formulas that we can compile into a tree
+		// of native operations, avoiding the interpreter and symbol table setup; see SLiMEidosBlock::CompileArithmeticCallback()
+		if (!p_script_block->has_cached_optimization_)
+			p_script_block->CompileArithmeticCallback();
 	}
 }
 
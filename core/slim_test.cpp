@@ -340,6 +340,7 @@ int RunSLiMTests(void)
 	_RunTreeSeqTests(temp_path);
 	_RunNucleotideFunctionTests();
 	_RunNucleotideMethodTests();
+	_RunPopGenFunctionTests();
 	_RunSLiMTimingTests();
 	
 	_RunInteractionTypeTests();		// many tests, time-consuming, so do this last
@@ -1870,6 +1870,30 @@ void _RunSLiMEidosBlockTests(void)
 	SLiMAssertScriptSuccess(gen1_setup_p1p2p3 + "early() { s1.active = 0; } s1 fitness(m1, p1) { stop(); } 100 { ; }", __LINE__);
 	SLiMAssertScriptSuccess(gen1_setup_p1p2p3 + "early() { s1.active = 0; } s1 fitness(NULL, p1) { stop(); } 100 { ; }", __LINE__);
 	
+	// a mix of constant neutral callbacks and other callbacks; the fitness of each individual should reflect only the m3 mutations,
+	// whether or not the other callbacks are well-behaved (and so whether or not the constant callback is trusted by the nonneutral caches)
+	std::string mixed_callbacks_setup("initialize() { initializeMutationRate(1e-5); initializeMutationType('m1', 1.0, 'f', 0.0); initializeMutationType('m2', 1.0, 'f', 0.5); initializeMutationType('m3', 1.0, 'e', 0.05); initializeGenomicElementType('g1', c(m1,m2,m3), c(1,1,1)); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); } 1 { sim.addSubpop('p1', 100); } fitness(m2) { return 1.0; } ");
+	std::string mixed_callbacks_check("early() { if (sim.generation > 1) { fitnesses = p1.cachedFitness(NULL); for (ind in p1.individuals) { muts = unique(c(ind.genome1.mutationsOfType(m3), ind.genome2.mutationsOfType(m3))); if (abs(fitnesses[ind.index] / product(1.0 + muts.selectionCoeff) - 1.0) > 1e-5) stop('fitness mismatch'); } } } 30 { if (sum(sim.mutations.mutationType == m2) > 0) stop(); } ");
+	
+	SLiMAssertScriptStop(mixed_callbacks_setup + "fitness(m3) { return relFitness; } " + mixed_callbacks_check, __LINE__);
+	SLiMAssertScriptStop(mixed_callbacks_setup + "fitness(m3) { if (homozygous) return relFitness; return 1.0 + mut.selectionCoeff; } " + mixed_callbacks_check, __LINE__);
+	SLiMAssertScriptStop(mixed_callbacks_setup + "fitness(m3) { if (self.active) return relFitness; return 1.0; } " + mixed_callbacks_check, __LINE__);
+	SLiMAssertScriptStop(mixed_callbacks_setup + "function (f$)identity(f$ x) { return x; } fitness(m3) { return identity(relFitness); } " + mixed_callbacks_check, __LINE__);
+	
+	// a callback that deactivates the constant callback through a lambda is not well-behaved; once the constant callback is inactive,
+	// the m2 mutations evaluated after that point must affect fitness (so each individual has some number of m2 effects, up to all)
+	std::string toggled_callbacks_setup("initialize() { initializeMutationRate(1e-5); initializeMutationType('m1', 1.0, 'f', 0.0); initializeMutationType('m2', 1.0, 'f', 0.5); initializeMutationType('m3', 1.0, 'e', 0.05); initializeGenomicElementType('g1', c(m1,m2,m3), c(1,1,1)); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); } 1 { sim.addSubpop('p1', 100); defineConstant('SEEN', c(F)); } s1 fitness(m2) { return 1.0; } ");
+	std::string toggled_callbacks_check("early() { if (sim.generation > 1) { fitnesses = p1.cachedFitness(NULL); for (ind in p1.individuals) { m3muts = unique(c(ind.genome1.mutationsOfType(m3), ind.genome2.mutationsOfType(m3))); m2count = size(unique(c(ind.genome1.mutationsOfType(m2), ind.genome2.mutationsOfType(m2)))); ratio = fitnesses[ind.index] / product(1.0 + m3muts.selectionCoeff); k = asInteger(round(log(ratio) / log(1.5))); if ((k < 0) | (k > m2count) | (abs(ratio / 1.5^k - 1.0) > 1e-5)) stop('fitness mismatch'); if (k > 0) rm('SEEN', T); } } } 30 { if (!exists('SEEN')) stop(); } ");
+	
+	SLiMAssertScriptStop(toggled_callbacks_setup + "fitness(m3) { sapply(1, 's1.active = 0; NULL;'); return relFitness; } " + toggled_callbacks_check, __LINE__);
+	SLiMAssertScriptStop(toggled_callbacks_setup + "fitness(m3) { apply(matrix(1), 0, 's1.active = 0; NULL;'); return relFitness; } " + toggled_callbacks_check, __LINE__);
+	
+	// simple formulas are compiled into native code by SLiMSim::OptimizeScriptBlock(); check that they match the interpreter, and fall back to it for errors
+	SLiMAssertScriptStop(mixed_callbacks_setup + "fitness(m3) { return ifelse(homozygous, relFitness, 1.0 + mut.selectionCoeff * (mut.position >= 0 ? 1.0 else 0.0)); } " + mixed_callbacks_check, __LINE__);
+	SLiMAssertScriptStop(gen1_setup_p1 + "1 late() { p1.individuals.tagF = (0:9) / 10.0; } fitness(NULL) { return 0.5 + exp(individual.tagF) - abs(-1) * 0.25 / 2; } 2 early() { if (all(abs(p1.cachedFitness(NULL) - (0.375 + exp((0:9) / 10.0))) < 1e-12)) stop(); }", __LINE__);
+	SLiMAssertScriptRaise(gen1_setup_p1 + "fitness(NULL) { return 1.0 + individual.tagF; } 10 { ; }", 1, 283, "before being set", __LINE__);
+	SLiMAssertScriptRaise(gen1_setup_p1 + "1 late() { p1.individuals.tagF = 1.0; } fitness(NULL) { return dnorm(individual.tagF, 0.0, -1 + sim.generation - 1); } 10 { ; }", 1, 306, "requires sd > 0.0", __LINE__);
+	
 	SLiMAssertScriptRaise(gen1_setup_p1p2p3 + "fitness() { stop(); } 100 { ; }", 1, 301, "mutation type id is required", __LINE__);
 	SLiMAssertScriptRaise(gen1_setup_p1p2p3 + "fitness(m1, p1, p2) { stop(); } 100 { ; }", 1, 307, "unexpected token", __LINE__);
 	SLiMAssertScriptRaise(gen1_setup_p1p2p3 + "fitness(m1, m1) { stop(); } 100 { ; }", 1, 305, "identifier prefix \"p\" was expected", __LINE__);
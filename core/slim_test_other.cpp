@@ -28,6 +28,7 @@
 #pragma mark InteractionType tests
 static void _RunInteractionTypeTests_Nonspatial(bool p_reciprocal, bool p_immediate, bool p_sex_enabled, std::string p_sex_segregation);
 static void _RunInteractionTypeTests_Spatial(std::string p_max_distance, bool p_reciprocal, bool p_immediate, bool p_sex_enabled, std::string p_sex_segregation);
+static void _RunInteractionTypeTests_Periodic(void);
 
 void _RunInteractionTypeTests(void)
 {
@@ -42,12 +43,16 @@ void _RunInteractionTypeTests(void)
 	
 	// Test InteractionType properties
 	SLiMAssertScriptStop(gen1_setup_i1x + "1 { if (i1.id == 1) stop(); }", __LINE__);
+	SLiMAssertScriptStop(gen1_setup_i1x + "1 { if (i1.kernelTolerance == 0.0) stop(); }", __LINE__);
 	SLiMAssertScriptStop(gen1_setup_i1x + "1 { if (isInfinite(i1.maxDistance)) stop(); }", __LINE__);
 	SLiMAssertScriptStop(gen1_setup_i1x + "1 { if (i1.reciprocal == F) stop(); }", __LINE__);
 	SLiMAssertScriptStop(gen1_setup_i1x + "1 { if (i1.sexSegregation == '**') stop(); }", __LINE__);
 	SLiMAssertScriptStop(gen1_setup_i1x + "1 { if (i1.spatiality == 'x') stop(); }", __LINE__);
 	
 	SLiMAssertScriptRaise(gen1_setup_i1x + "1 { i1.id = 2; }", 1, 427, "read-only property", __LINE__);
+	SLiMAssertScriptStop(gen1_setup_i1x + "1 { i1.kernelTolerance = 0.01; if (i1.kernelTolerance == 0.01) stop(); }", __LINE__);
+	SLiMAssertScriptRaise(gen1_setup_i1x + "1 { i1.kernelTolerance = -0.01; }", 1, 440, "greater than or equal to zero", __LINE__);
+	SLiMAssertScriptRaise(gen1_setup_i1x + "1 late() { i1.kernelTolerance = 0.01; }", 1, 447, "while the interaction is being evaluated", __LINE__);
 	SLiMAssertScriptStop(gen1_setup_i1x + "1 { i1.maxDistance = 0.5; if (i1.maxDistance == 0.5) stop(); }", __LINE__);
 	SLiMAssertScriptRaise(gen1_setup_i1x + "1 { i1.reciprocal = F; }", 1, 435, "read-only property", __LINE__);
 	SLiMAssertScriptRaise(gen1_setup_i1x + "1 { i1.sexSegregation = '**'; }", 1, 439, "read-only property", __LINE__);
@@ -106,6 +111,8 @@ void _RunInteractionTypeTests(void)
 		_RunInteractionTypeTests_Spatial(" INF ", true, true, true, seg_str);
 		_RunInteractionTypeTests_Spatial("999.0", true, true, true, seg_str);
 	}
+	
+	_RunInteractionTypeTests_Periodic();
 }
 
 void _RunInteractionTypeTests_Nonspatial(bool p_reciprocal, bool p_immediate, bool p_sex_enabled, std::string p_sex_segregation)
@@ -905,6 +912,99 @@ void _RunInteractionTypeTests_Spatial(std::string p_max_distance, bool p_recipro
 	SLiMAssertScriptStop(gen1_setup_i1xyz_pop_full + "i1.unevaluate(); i1.unevaluate(); stop(); }", __LINE__);
 }
 
+void _RunInteractionTypeTests_Periodic(void)
+{
+	// These tests check the spatial engine's answers against brute-force calculations using distance(), for
+	// larger random populations with periodic boundaries, where the k-d tree holds replicated individuals
+	const char *spatialities[4] = {"x", "xy", "xy", "xyz"};
+	const char *periodicities[4] = {"x", "xy", "y", "xz"};
+	
+	for (int config = 0; config < 4; ++config)
+	{
+		std::string spatiality(spatialities[config]), periodicity(periodicities[config]);
+		std::string gen1_setup_i1_periodic("initialize() { initializeSLiMOptions(dimensionality='" + spatiality + "', periodicity='" + periodicity + "'); initializeMutationRate(1e-5); initializeMutationType('m1', 0.5, 'f', 0.0); initializeGenomicElementType('g1', m1, 1.0); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); initializeInteractionType('i1', '" + spatiality + "', maxDistance=0.2); } 1 { sim.addSubpop('p1', 300); ind = p1.individuals; ind.setSpatialPosition(p1.pointUniform(300)); i1.evaluate(); ");
+		
+		SLiMAssertScriptStop(gen1_setup_i1_periodic + "counts = sapply(ind, 'd = i1.distance(applyValue); sum(d <= 0.2) - 1;'); if (identical(i1.interactingNeighborCount(ind), counts)) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_periodic + "ok = T; for (i in 0:9) { d = i1.distance(ind[i]); if (!identical(sort(i1.nearestNeighbors(ind[i], 300).index), which((d <= 0.2) & (ind.index != i)))) ok = F; } if (ok) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_periodic + "ok = T; for (i in 0:9) { d = i1.distance(ind[i]); d[i] = INF; nearest = (min(d) <= 0.2) ? whichMin(d) else integer(0); if (!identical(i1.nearestNeighbors(ind[i], 1).index, nearest)) ok = F; } if (ok) stop(); }", __LINE__);
+		
+		if (config == 1)
+			SLiMAssertScriptRaise(gen1_setup_i1_periodic + "i1.nearestNeighborsOfPoint(p1, c(-0.5, 0.5)); }", 1, 446, "fall inside spatial", __LINE__);
+	}
+	
+	// These populations are large enough that the sparse array is built with the cell grid rather than the k-d tree; the
+	// small maximum distance forces the grid to be coarsened, and sex segregation limits the grid to the male exerters
+	const char *grid_spatialities[3] = {"x", "xy", "xyz"};
+	const char *max_distances[2] = {"0.2", "0.01"};
+	
+	for (int config = 0; config < 6; ++config)
+	{
+		std::string spatiality(grid_spatialities[config % 3]), max_distance(max_distances[config / 3]);
+		std::string gen1_setup_i1_grid("initialize() { initializeSLiMOptions(dimensionality='" + spatiality + "'); initializeSex('A'); initializeMutationRate(1e-5); initializeMutationType('m1', 0.5, 'f', 0.0); initializeGenomicElementType('g1', m1, 1.0); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); initializeInteractionType('i1', '" + spatiality + "', maxDistance=" + max_distance + ", sexSegregation='FM'); } 1 { sim.addSubpop('p1', 700); ind = p1.individuals; ind.setSpatialPosition(p1.pointUniform(700)); i1.evaluate(); fem = ind[ind.sex == 'F']; ");
+		
+		SLiMAssertScriptStop(gen1_setup_i1_grid + "counts = sapply(fem, 'd = i1.distance(applyValue); sum((d <= " + max_distance + ") & (ind.sex == \"M\"));'); if (identical(i1.interactingNeighborCount(fem), counts)) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_grid + "totals = sapply(fem, 'sum(i1.strength(applyValue));'); if (all(abs(i1.totalOfNeighborStrengths(fem) - totals) < 1e-6)) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_grid + "ok = T; for (i in 0:9) { s = i1.strength(fem[i]); if (!identical(which(s > 0), which((i1.distance(fem[i]) <= " + max_distance + ") & (ind.sex == \"M\")))) ok = F; } if (ok) stop(); }", __LINE__);
+	}
+	
+	// Reciprocal interactions keep only half of each pair in a symmetric sparse array; full rows are reconstructed on demand,
+	// and totals over many individuals are made in a single pass, so we check both of those against brute force
+	for (int config = 0; config < 3; ++config)
+	{
+		std::string spatiality(grid_spatialities[config]);
+		std::string gen1_setup_i1_recip("initialize() { initializeSLiMOptions(dimensionality='" + spatiality + "'); initializeMutationRate(1e-5); initializeMutationType('m1', 0.5, 'f', 0.0); initializeGenomicElementType('g1', m1, 1.0); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); initializeInteractionType('i1', '" + spatiality + "', reciprocal=T, maxDistance=0.2); i1.setInteractionFunction('l', 2.0); } 1 { sim.addSubpop('p1', 400); ind = p1.individuals; ind.setSpatialPosition(p1.pointUniform(400)); i1.evaluate(); ");
+		
+		SLiMAssertScriptStop(gen1_setup_i1_recip + "counts = sapply(ind, 'd = i1.distance(applyValue); sum(d <= 0.2) - 1;'); if (identical(i1.interactingNeighborCount(ind), counts)) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_recip + "totals = sapply(ind, 'sum(i1.strength(applyValue));'); if (identical(i1.totalOfNeighborStrengths(ind), totals) & identical(i1.totalOfNeighborStrengths(ind[0:9]), totals[0:9])) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_recip + "ok = T; for (i in 0:9) { x = ind[i]; s = i1.strength(x); if (!identical(s, sapply(ind, 'i1.strength(applyValue, x);'))) ok = F; d = i1.distance(x); d[i] = INF; if (!identical(which(s > 0), which(d <= 0.2))) ok = F; } if (ok) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_recip + "ok = T; for (i in 0:9) { x = ind[i]; n = i1.nearestInteractingNeighbors(x, 400); d = i1.interactionDistance(x, n); if (any(abs(d - i1.distance(x, n)) > 1e-6)) ok = F; if ((size(n) > 0) & !identical(d, sapply(n, 'i1.interactionDistance(applyValue, x);'))) ok = F; } if (ok) stop(); }", __LINE__);
+	}
+	
+	// Until the sparse array is built, totalOfNeighborStrengths(), localPopulationDensity() and drawByStrength() stream each
+	// row instead (except for fully reciprocal interactions, which always build the symmetric sparse array); strength() then
+	// builds the sparse array, and the results from it must be identical to the streamed results
+	const char *stream_options[3] = {"reciprocal=T, maxDistance=0.3", "maxDistance=0.3, sexSegregation='FM'", "maxDistance=0.3, sexSegregation='MM'"};
+	
+	for (int config = 0; config < 9; ++config)
+	{
+		std::string spatiality(grid_spatialities[config % 3]), options(stream_options[config / 3]);
+		std::string pop_size((config / 3 == 2) ? "100" : "500");
+		std::string gen1_setup_i1_stream("initialize() { initializeSLiMOptions(dimensionality='" + spatiality + "'); initializeSex('A'); initializeMutationRate(1e-5); initializeMutationType('m1', 0.5, 'f', 0.0); initializeGenomicElementType('g1', m1, 1.0); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); initializeInteractionType('i1', '" + spatiality + "', " + options + "); i1.setInteractionFunction('n', 2.0, 0.1); } 1 { sim.addSubpop('p1', " + pop_size + "); ind = p1.individuals; ind.setSpatialPosition(p1.pointUniform(" + pop_size + ")); i1.evaluate(); ");
+		
+		SLiMAssertScriptStop(gen1_setup_i1_stream + "t1 = i1.totalOfNeighborStrengths(ind); u1 = i1.totalOfNeighborStrengths(ind[5]); setSeed(3); d1 = i1.drawByStrength(ind[7], 20); i1.strength(ind[0]); t2 = i1.totalOfNeighborStrengths(ind); u2 = i1.totalOfNeighborStrengths(ind[5]); setSeed(3); d2 = i1.drawByStrength(ind[7], 20); if (identical(t1, t2) & identical(u1, u2) & identical(d1, d2)) stop(); }", __LINE__);
+		
+		if (config % 3 != 2)
+			SLiMAssertScriptStop(gen1_setup_i1_stream + "l1 = i1.localPopulationDensity(ind); i1.strength(ind[0]); l2 = i1.localPopulationDensity(ind); if (identical(l1, l2)) stop(); }", __LINE__);
+	}
+	
+	// With periodic boundaries, the results for a fully reciprocal interaction must not depend on whether the sparse array was
+	// already built by an earlier call
+	for (int config = 0; config < 3; ++config)
+	{
+		std::string spatiality(grid_spatialities[config]);
+		std::string gen1_setup_i1_recip_periodic("initialize() { initializeSLiMOptions(dimensionality='" + spatiality + "', periodicity='" + spatiality + "'); initializeMutationRate(1e-5); initializeMutationType('m1', 0.5, 'f', 0.0); initializeGenomicElementType('g1', m1, 1.0); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); initializeInteractionType('i1', '" + spatiality + "', reciprocal=T, maxDistance=0.3); i1.setInteractionFunction('n', 2.0, 0.1); } 1 { sim.addSubpop('p1', 500); ind = p1.individuals; ind.setSpatialPosition(p1.pointUniform(500)); i1.evaluate(); ");
+		
+		SLiMAssertScriptStop(gen1_setup_i1_recip_periodic + "t1 = i1.totalOfNeighborStrengths(ind); setSeed(3); d1 = i1.drawByStrength(ind[7], 20); i1.unevaluate(); i1.evaluate(); i1.strength(ind[0]); t2 = i1.totalOfNeighborStrengths(ind); setSeed(3); d2 = i1.drawByStrength(ind[7], 20); if (identical(t1, t2) & identical(d1, d2)) stop(); }", __LINE__);
+		
+		if (config != 2)
+			SLiMAssertScriptStop(gen1_setup_i1_recip_periodic + "l1 = i1.localPopulationDensity(ind); i1.unevaluate(); i1.evaluate(); i1.strength(ind[0]); l2 = i1.localPopulationDensity(ind); if (identical(l1, l2)) stop(); }", __LINE__);
+	}
+	
+	// With kernelTolerance set, the interaction function is interpolated from a table; each strength must be within the tolerance
+	// of the exact strength (plus float rounding), both from the sparse array and from streamed totals, and a tolerance of zero
+	// must restore exact evaluation
+	const char *kernel_functions[3] = {"'e', 2.0, 10.0", "'n', 2.0, 0.1", "'c', 2.0, 0.05"};
+	
+	for (int config = 0; config < 6; ++config)
+	{
+		std::string kernel_function(kernel_functions[config % 3]), reciprocal((config / 3) ? "T" : "F");
+		std::string gen1_setup_i1_table("initialize() { initializeSLiMOptions(dimensionality='xy'); initializeMutationRate(1e-5); initializeMutationType('m1', 0.5, 'f', 0.0); initializeGenomicElementType('g1', m1, 1.0); initializeGenomicElement(g1, 0, 99999); initializeRecombinationRate(1e-8); initializeInteractionType('i1', 'xy', reciprocal=" + reciprocal + ", maxDistance=0.3); i1.setInteractionFunction(" + kernel_function + "); } 1 { sim.addSubpop('p1', 300); ind = p1.individuals; ind.setSpatialPosition(p1.pointUniform(300)); i1.evaluate(); s0 = i1.strength(ind[0]); t0 = i1.totalOfNeighborStrengths(ind); i1.unevaluate(); ");
+		
+		SLiMAssertScriptStop(gen1_setup_i1_table + "i1.kernelTolerance = 1e-3; i1.evaluate(); t1 = i1.totalOfNeighborStrengths(ind); s1 = i1.strength(ind[0]); n = i1.interactingNeighborCount(ind); if (all(abs(s1 - s0) <= 1e-3 + 1e-6) & all(abs(t1 - t0) <= n * (1e-3 + 1e-6)) & any(s1 != s0)) stop(); }", __LINE__);
+		SLiMAssertScriptStop(gen1_setup_i1_table + "i1.kernelTolerance = 1e-3; i1.kernelTolerance = 0.0; i1.evaluate(); t1 = i1.totalOfNeighborStrengths(ind); s1 = i1.strength(ind[0]); if (identical(s1, s0) & identical(t1, t0)) stop(); }", __LINE__);
+	}
+}
+
 #pragma mark Continuous space tests
 void _RunContinuousSpaceTests(void)
 {
@@ -1586,26 +1686,38 @@ void _RunNucleotideMethodTests(void)
 	SLiMAssertScriptRaise(gen1_setup + "1 { sim.chromosome.setGeneConversion(0.5, 1000, 0.0, 0.1); stop(); }", 1, 231, "must be 0.0 in non-nucleotide-based models", __LINE__);
 }
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+#pragma mark population genetics function tests
+void _RunPopGenFunctionTests(void)
+{
+	// These functions are implemented natively; check them against the Eidos code they are documented to be equivalent to
+	std::string popgen_setup(gen1_setup_highmut_p1 + "1 { sim.addSubpop('p2', 10); p1.setMigrationRates(p2, 0.1); } 20 late() { gA = p1.genomes; gB = p2.genomes; m = sim.mutations; ");
+	
+	// calcFST()
+	SLiMAssertScriptStop(popgen_setup + "p1_p = gA.mutationFrequenciesInGenomes(); p2_p = gB.mutationFrequenciesInGenomes(); mean_p = (p1_p + p2_p) / 2.0; fst = 1.0 - (p1_p * (1.0 - p1_p) + p2_p * (1.0 - p2_p)) / (2.0 * mean_p * (1.0 - mean_p)); if (identical(calcFST(gA, gB), mean(fst[!isNAN(fst)]))) stop(); }", __LINE__);
+	SLiMAssertScriptStop(popgen_setup + "m = m[(m.position >= 20000) & (m.position <= 70000)]; p1_p = gA.mutationFrequenciesInGenomes(m); p2_p = gB.mutationFrequenciesInGenomes(m); mean_p = (p1_p + p2_p) / 2.0; fst = 1.0 - (p1_p * (1.0 - p1_p) + p2_p * (1.0 - p2_p)) / (2.0 * mean_p * (1.0 - mean_p)); if (identical(calcFST(gA, gB, NULL, 20000, 70000), mean(fst[!isNAN(fst)]))) stop(); }", __LINE__);
+	SLiMAssertScriptStop(popgen_setup + "if (isNULL(calcFST(gA, gA, m[integer(0)]))) stop(); }", __LINE__);
+	SLiMAssertScriptRaise(popgen_setup + "calcFST(gA, gB, NULL, 5, 4); }", 1, 370, "start must be less than or equal to end", __LINE__);
+	SLiMAssertScriptRaise(popgen_setup + "calcFST(gA, gB, NULL, 5); }", 1, 370, "both be NULL or both be non-NULL", __LINE__);
+	SLiMAssertScriptRaise(popgen_setup + "calcFST(gA, gB[integer(0)]); }", 1, 370, "zero-length Genome vector", __LINE__);
+	
+	// calcHeterozygosity()
+	SLiMAssertScriptStop(popgen_setup + "p = gA.mutationFrequenciesInGenomes(); if (identical(calcHeterozygosity(gA), 2 * sum(p * (1 - p)) / 100000)) stop(); }", __LINE__);
+	SLiMAssertScriptStop(popgen_setup + "m = m[(m.position >= 20000) & (m.position <= 69999)]; p = gB.mutationFrequenciesInGenomes(m); if (identical(calcHeterozygosity(gB, NULL, 20000, 69999), 2 * sum(p * (1 - p)) / 50000)) stop(); }", __LINE__);
+	
+	// calcWattersonsTheta()
+	SLiMAssertScriptStop(popgen_setup + "p = gA.mutationFrequenciesInGenomes(); k = sum((p != 0.0) & (p != 1.0)); if (identical(calcWattersonsTheta(gA), (k / sum(1 / 1:19)) / 100000)) stop(); }", __LINE__);
+	SLiMAssertScriptStop(popgen_setup + "if (calcWattersonsTheta(gA[0]) == 0.0) stop(); }", __LINE__);
+	
+	// calcPairHeterozygosity()
+	SLiMAssertScriptStop(popgen_setup + "a = gA[0]; b = gB[0]; if (calcPairHeterozygosity(a, b) == size(setSymmetricDifference(a.mutations, b.mutations)) / 100000) stop(); }", __LINE__);
+	SLiMAssertScriptStop(popgen_setup + "a = gA[0]; b = gB[0]; u = setSymmetricDifference(a.mutations, b.mutations); u = u[(u.position >= 1000) & (u.position <= 50999)]; if (calcPairHeterozygosity(a, b, 1000, 50999, F) == size(unique(u.position)) / 50000) stop(); }", __LINE__);
+	SLiMAssertScriptStop(popgen_setup + "if (calcPairHeterozygosity(gA[3], gA[3]) == 0.0) stop(); }", __LINE__);
+	
+	// calcVA()
+	SLiMAssertScriptStop(popgen_setup + "for (x in m) x.setSelectionCoeff(rnorm(1)); if (identical(calcVA(p1.individuals, m1), var(p1.individuals.sumOfMutationsOfType(m1))) & identical(calcVA(p1.individuals, 1), calcVA(p1.individuals, m1))) stop(); }", __LINE__);
+	SLiMAssertScriptStop(popgen_setup + "if (isNULL(calcVA(p1.individuals[0], m1))) stop(); }", __LINE__);
+	SLiMAssertScriptRaise(popgen_setup + "calcVA(p1.individuals, 7); }", 1, 370, "calcVA() mutation type lookup failed", __LINE__);
+}
 
 
 
@@ -23,12 +23,13 @@
 #include <ostream>
 #include <cmath>
 #include <string.h>
+#include <algorithm>
 
 #pragma mark -
 #pragma mark SparseArray
 #pragma mark -
 
-SparseArray::SparseArray(unsigned int p_nrows, unsigned int p_ncols)
+SparseArray::SparseArray(unsigned int p_nrows, unsigned int p_ncols, bool p_symmetric)
 {
 	if ((p_nrows == 0) || (p_ncols == 0))
 		EIDOS_TERMINATION << "ERROR (SparseArray::SparseArray): zero-size sparse array." << EidosTerminate(nullptr);
@@ -39,6 +40,12 @@ SparseArray::SparseArray(unsigned int p_nrows, unsigned int p_ncols)
 	nnz_ = 0;
 	nnz_capacity_ = 1024;
 	
+	symmetric_ = p_symmetric;
+	lower_offsets_ = nullptr;
+	lower_columns_ = nullptr;
+	lower_capacity_ = 0;
+	scratch_row_ = UINT32_MAX;
+	
 	row_offsets_ = (uint64_t *)malloc((nrows_ + 1) * sizeof(uint64_t));
 	columns_ = (uint32_t *)malloc(nnz_capacity_ * sizeof(uint32_t));
 	distances_ = (sa_distance_t *)malloc(nnz_capacity_ * sizeof(sa_distance_t));
@@ -49,6 +56,7 @@ SparseArray::SparseArray(unsigned int p_nrows, unsigned int p_ncols)
 	
 	row_offsets_[nrows_set_] = 0;
 	finished_ = false;
+	strengths_added_ = false;
 }
 
 SparseArray::~SparseArray(void)
@@ -71,6 +79,13 @@ SparseArray::~SparseArray(void)
 	
 	free(strengths_);
 	strengths_ = nullptr;
+	
+	free(lower_offsets_);
+	lower_offsets_ = nullptr;
+	
+	free(lower_columns_);
+	lower_columns_ = nullptr;
+	lower_capacity_ = 0;
 }
 
 void SparseArray::Reset(void)
@@ -80,9 +95,11 @@ void SparseArray::Reset(void)
 	nrows_set_ = 0;
 	nnz_ = 0;
 	finished_ = false;
+	strengths_added_ = false;
+	scratch_row_ = UINT32_MAX;
 }
 
-void SparseArray::Reset(unsigned int p_nrows, unsigned int p_ncols)
+void SparseArray::Reset(unsigned int p_nrows, unsigned int p_ncols, bool p_symmetric)
 {
 	if ((p_nrows == 0) || (p_ncols == 0))
 		EIDOS_TERMINATION << "ERROR (SparseArray::Reset): zero-size sparse array." << EidosTerminate(nullptr);
@@ -91,6 +108,8 @@ void SparseArray::Reset(unsigned int p_nrows, unsigned int p_ncols)
 	ncols_ = p_ncols;
 	nrows_set_ = 0;
 	nnz_ = 0;
+	symmetric_ = p_symmetric;
+	scratch_row_ = UINT32_MAX;
 	
 	row_offsets_ = (uint64_t *)realloc(row_offsets_, (nrows_ + 1) * sizeof(uint64_t));
 	if (!row_offsets_)
@@ -98,6 +117,7 @@ void SparseArray::Reset(unsigned int p_nrows, unsigned int p_ncols)
 	
 	row_offsets_[nrows_set_] = 0;
 	finished_ = false;
+	strengths_added_ = false;
 }
 
 void SparseArray::_ResizeToFitNNZ(void)
@@ -123,6 +143,8 @@ void SparseArray::AddRowDistances(uint32_t p_row, const uint32_t *p_columns, con
 	// ensure that we are building sequentially, visiting each row exactly once
 	if (finished_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::AddRowDistances): adding row to sparse array that is finished." << EidosTerminate(nullptr);
+	if (symmetric_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::AddRowDistances): (internal error) adding rows is not supported for symmetric sparse arrays." << EidosTerminate(nullptr);
 	if (nrows_set_ >= nrows_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::AddRowDistances): adding row to sparse array that is already full." << EidosTerminate(nullptr);
 	if (p_row != nrows_set_)
@@ -147,6 +169,8 @@ void SparseArray::AddRowInteractions(uint32_t p_row, const uint32_t *p_columns,
 	// ensure that we are building sequentially, visiting each row exactly once
 	if (finished_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::AddRowInteractions): adding row to sparse array that is finished." << EidosTerminate(nullptr);
+	if (symmetric_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::AddRowInteractions): (internal error) adding rows is not supported for symmetric sparse arrays." << EidosTerminate(nullptr);
 	if (nrows_set_ >= nrows_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::AddRowInteractions): adding row to sparse array that is already full." << EidosTerminate(nullptr);
 	if (p_row != nrows_set_)
@@ -165,6 +189,7 @@ void SparseArray::AddRowInteractions(uint32_t p_row, const uint32_t *p_columns,
 	memcpy(columns_ + offset, p_columns, p_row_nnz * sizeof(uint32_t));
 	memcpy(distances_ + offset, p_distances, p_row_nnz * sizeof(sa_distance_t));
 	memcpy(strengths_ + offset, p_strengths, p_row_nnz * sizeof(sa_strength_t));
+	strengths_added_ = true;
 }
 
 void SparseArray::AddEntryInteraction(uint32_t p_row, uint32_t p_column, sa_distance_t p_distance, sa_strength_t p_strength)
@@ -188,6 +213,10 @@ void SparseArray::AddEntryInteraction(uint32_t p_row, uint32_t p_column, sa_dist
 	if (p_column >= ncols_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::AddEntryInteraction): adding column beyond the end of the sparse array." << EidosTerminate(nullptr);
 	
+	// a symmetric sparse array stores only its upper triangle
+	if (symmetric_ && (p_column <= p_row))
+		return;
+	
 	// make room for the new entries
 	nnz_++;
 	ResizeToFitNNZ();
@@ -203,6 +232,7 @@ void SparseArray::AddEntryInteraction(uint32_t p_row, uint32_t p_column, sa_dist
 	columns_[offset] = p_column;
 	distances_[offset] = p_distance;
 	strengths_[offset] = p_strength;
+	strengths_added_ = true;
 }
 
 void SparseArray::Finished(void)
@@ -215,9 +245,172 @@ void SparseArray::Finished(void)
 	while (nrows_set_ < nrows_)
 		row_offsets_[++nrows_set_] = offset;
 	
+	SortRowsByColumn();
+	
+	if (symmetric_)
+		BuildLowerIndex();
+	
+	scratch_row_ = UINT32_MAX;
 	finished_ = true;
 }
 
+void SparseArray::BeginStreamedRow(uint32_t p_row)
+{
+	if (symmetric_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::BeginStreamedRow): (internal error) streaming is not supported for symmetric sparse arrays." << EidosTerminate(nullptr);
+	if (p_row >= nrows_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::BeginStreamedRow): row out of range." << EidosTerminate(nullptr);
+	
+	// discard whatever the array held, and pretend that the rows before p_row were added empty; only row_offsets_[p_row] and
+	// row_offsets_[p_row + 1] are touched, so AddEntryDistance() then builds p_row at the start of the entry buffers
+	nrows_set_ = p_row;
+	nnz_ = 0;
+	row_offsets_[p_row] = 0;
+	row_offsets_[p_row + 1] = 0;
+	scratch_row_ = UINT32_MAX;
+	finished_ = false;
+	strengths_added_ = false;
+}
+
+void SparseArray::FinishStreamedRow(void)
+{
+	if (finished_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::FinishStreamedRow): finishing sparse array that is already finished." << EidosTerminate(nullptr);
+	
+	// the row being streamed is nrows_set_ - 1 if any entry was added to it, or nrows_set_ if it is empty; the sorting buffers
+	// are kept across rows, since many rows are usually streamed in succession
+	if (nnz_)
+		SortRowByColumn(nrows_set_ - 1, stream_keys_, stream_distances_, stream_strengths_);
+	
+	finished_ = true;
+}
+
+void SparseArray::SortRowsByColumn(void)
+{
+	std::vector<uint64_t> keys;
+	std::vector<sa_distance_t> temp_distances;
+	std::vector<sa_strength_t> temp_strengths;
+	
+	for (uint32_t row = 0; row < nrows_; ++row)
+		SortRowByColumn(row, keys, temp_distances, temp_strengths);
+}
+
+void SparseArray::SortRowByColumn(uint32_t p_row, std::vector<uint64_t> &p_keys, std::vector<sa_distance_t> &p_temp_distances, std::vector<sa_strength_t> &p_temp_strengths)
+{
+	// Sort the entries of the row by column; we sort keys that combine the column (in the high bits) with the entry's
+	// original position in the row (in the low bits), and then permute the distances and strengths to match.  If the array
+	// was built from distances alone, strengths_ has not been filled in yet, so it is left alone; reading it would read
+	// uninitialized memory.  Rows that are already sorted are skipped.
+	uint64_t offset = row_offsets_[p_row];
+	uint32_t row_nnz = (uint32_t)(row_offsets_[p_row + 1] - offset);
+	uint32_t *row_columns = columns_ + offset;
+	uint32_t col_iter;
+	
+	for (col_iter = 1; col_iter < row_nnz; ++col_iter)
+		if (row_columns[col_iter - 1] > row_columns[col_iter])
+			break;
+	
+	if (col_iter >= row_nnz)
+		return;
+	
+	sa_distance_t *row_distances = distances_ + offset;
+	
+	p_keys.resize(row_nnz);
+	p_temp_distances.assign(row_distances, row_distances + row_nnz);
+	
+	for (col_iter = 0; col_iter < row_nnz; ++col_iter)
+		p_keys[col_iter] = (((uint64_t)row_columns[col_iter]) << 32) | col_iter;
+	
+	std::sort(p_keys.begin(), p_keys.end());
+	
+	for (col_iter = 0; col_iter < row_nnz; ++col_iter)
+	{
+		uint64_t key = p_keys[col_iter];
+		uint32_t source_iter = (uint32_t)(key & 0x00000000FFFFFFFFULL);
+		
+		row_columns[col_iter] = (uint32_t)(key >> 32);
+		row_distances[col_iter] = p_temp_distances[source_iter];
+	}
+	
+	if (strengths_added_)
+	{
+		sa_strength_t *row_strengths = strengths_ + offset;
+		
+		p_temp_strengths.assign(row_strengths, row_strengths + row_nnz);
+		
+		for (col_iter = 0; col_iter < row_nnz; ++col_iter)
+			row_strengths[col_iter] = p_temp_strengths[(uint32_t)(p_keys[col_iter] & 0x00000000FFFFFFFFULL)];
+	}
+}
+
+void SparseArray::BuildLowerIndex(void)
+{
+	// For each row, collect the rows that have an entry in its column; since those entries are all above the diagonal, these
+	// are the entries of the row below the diagonal, which are not stored.  This is a counting sort by column, visiting rows
+	// in order, so each row's list comes out in ascending order.
+	lower_offsets_ = (uint64_t *)realloc(lower_offsets_, (nrows_ + 1) * sizeof(uint64_t));
+	
+	if (nnz_ > lower_capacity_)
+	{
+		lower_capacity_ = nnz_capacity_;
+		lower_columns_ = (uint32_t *)realloc(lower_columns_, lower_capacity_ * sizeof(uint32_t));
+	}
+	
+	if (!lower_offsets_ || (!lower_columns_ && lower_capacity_))
+		EIDOS_TERMINATION << "ERROR (SparseArray::BuildLowerIndex): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
+	
+	for (uint32_t row = 0; row <= nrows_; ++row)
+		lower_offsets_[row] = 0;
+	
+	for (uint64_t entry = 0; entry < nnz_; ++entry)
+		lower_offsets_[columns_[entry] + 1]++;
+	
+	for (uint32_t row = 0; row < nrows_; ++row)
+		lower_offsets_[row + 1] += lower_offsets_[row];
+	
+	// scatter, advancing each row's offset to the start of the next row, then shift the offsets back up by one row
+	for (uint32_t row = 0; row < nrows_; ++row)
+		for (uint64_t entry = row_offsets_[row]; entry < row_offsets_[row + 1]; ++entry)
+			lower_columns_[lower_offsets_[columns_[entry]]++] = row;
+	
+	for (uint32_t row = nrows_; row > 0; --row)
+		lower_offsets_[row] = lower_offsets_[row - 1];
+	lower_offsets_[0] = 0;
+}
+
+void SparseArray::ReconstructRow(uint32_t p_row) const
+{
+	// Assemble the full contents of p_row of a symmetric array: first the entries below the diagonal, which are looked up in
+	// the rows above, and then the stored entries above the diagonal.  Both parts are sorted, so the full row is too.
+	if (scratch_row_ == p_row)
+		return;
+	
+	uint64_t lower_offset = lower_offsets_[p_row];
+	uint32_t lower_nnz = (uint32_t)(lower_offsets_[p_row + 1] - lower_offset);
+	uint64_t upper_offset = row_offsets_[p_row];
+	uint32_t upper_nnz = (uint32_t)(row_offsets_[p_row + 1] - upper_offset);
+	
+	scratch_columns_.resize(lower_nnz + upper_nnz);
+	scratch_distances_.resize(lower_nnz + upper_nnz);
+	scratch_strengths_.resize(lower_nnz + upper_nnz);
+	
+	for (uint32_t col_iter = 0; col_iter < lower_nnz; ++col_iter)
+	{
+		uint32_t col = lower_columns_[lower_offset + col_iter];
+		int64_t index = FindColumn(col, p_row);		// always present, by construction
+		
+		scratch_columns_[col_iter] = col;
+		scratch_distances_[col_iter] = distances_[index];
+		scratch_strengths_[col_iter] = strengths_[index];
+	}
+	
+	std::copy(columns_ + upper_offset, columns_ + upper_offset + upper_nnz, scratch_columns_.begin() + lower_nnz);
+	std::copy(distances_ + upper_offset, distances_ + upper_offset + upper_nnz, scratch_distances_.begin() + lower_nnz);
+	std::copy(strengths_ + upper_offset, strengths_ + upper_offset + upper_nnz, scratch_strengths_.begin() + lower_nnz);
+	
+	scratch_row_ = p_row;
+}
+
 sa_distance_t SparseArray::Distance(uint32_t p_row, uint32_t p_column) const
 {
 #if DEBUG
@@ -232,16 +425,15 @@ sa_distance_t SparseArray::Distance(uint32_t p_row, uint32_t p_column) const
 	if (p_column >= ncols_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::Distance): column out of range." << EidosTerminate(nullptr);
 	
-	// get the offset into columns/values for p_row, and the number of entries for this row
-	uint64_t offset = row_offsets_[p_row];
-	uint64_t offset_next = row_offsets_[p_row + 1];
+	// a symmetric array keeps the entry for (row, column) at (column, row) when column < row
+	if (symmetric_ && (p_column < p_row))
+		std::swap(p_row, p_column);
 	
-	// scan for the requested column
-	for (uint64_t index = offset; index < offset_next; ++index)
-	{
-		if (columns_[index] == p_column)
-			return distances_[index];
-	}
+	// binary search for the requested column
+	int64_t index = FindColumn(p_row, p_column);
+	
+	if (index >= 0)
+		return distances_[index];
 	
 	// no match found; return infinite distance
 	return INFINITY;
@@ -261,16 +453,15 @@ sa_strength_t SparseArray::Strength(uint32_t p_row, uint32_t p_column) const
 	if (p_column >= ncols_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::Strength): column out of range." << EidosTerminate(nullptr);
 	
-	// get the offset into columns/values for p_row, and the number of entries for this row
-	uint64_t offset = row_offsets_[p_row];
-	uint64_t offset_next = row_offsets_[p_row + 1];
+	// a symmetric array keeps the entry for (row, column) at (column, row) when column < row
+	if (symmetric_ && (p_column < p_row))
+		std::swap(p_row, p_column);
 	
-	// scan for the requested column
-	for (uint64_t index = offset; index < offset_next; ++index)
-	{
-		if (columns_[index] == p_column)
-			return strengths_[index];
-	}
+	// binary search for the requested column
+	int64_t index = FindColumn(p_row, p_column);
+	
+	if (index >= 0)
+		return strengths_[index];
 	
 	// no match found; return zero interaction strength
 	return 0;
@@ -290,18 +481,18 @@ void SparseArray::PatchStrength(uint32_t p_row, uint32_t p_column, sa_strength_t
 	if (p_column >= ncols_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::PatchStrength): column out of range." << EidosTerminate(nullptr);
 	
-	// get the offset into columns/values for p_row, and the number of entries for this row
-	uint64_t offset = row_offsets_[p_row];
-	uint64_t offset_next = row_offsets_[p_row + 1];
+	// a symmetric array keeps the entry for (row, column) at (column, row) when column < row
+	if (symmetric_ && (p_column < p_row))
+		std::swap(p_row, p_column);
+	
+	// binary search for the requested column
+	int64_t index = FindColumn(p_row, p_column);
 	
-	// scan for the requested column
-	for (uint64_t index = offset; index < offset_next; ++index)
+	if (index >= 0)
 	{
-		if (columns_[index] == p_column)
-		{
-			strengths_[index] = p_strength;
-			return;
-		}
+		strengths_[index] = p_strength;
+		scratch_row_ = UINT32_MAX;
+		return;
 	}
 	
 	// no match found
@@ -320,6 +511,16 @@ const sa_distance_t *SparseArray::DistancesForRow(uint32_t p_row, uint32_t *p_ro
 	if (p_row >= nrows_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::DistancesForRow): row out of range." << EidosTerminate(nullptr);
 	
+	if (symmetric_)
+	{
+		ReconstructRow(p_row);
+		
+		*p_row_nnz = (uint32_t)scratch_columns_.size();
+		if (p_row_columns)
+			*p_row_columns = scratch_columns_.data();
+		return scratch_distances_.data();
+	}
+	
 	// get the offset into columns/values for p_row, and the number of entries for this row
 	uint64_t offset = row_offsets_[p_row];
 	uint64_t count = row_offsets_[p_row + 1] - offset;
@@ -343,6 +544,16 @@ const sa_strength_t *SparseArray::StrengthsForRow(uint32_t p_row, uint32_t *p_ro
 	if (p_row >= nrows_)
 		EIDOS_TERMINATION << "ERROR (SparseArray::StrengthsForRow): row out of range." << EidosTerminate(nullptr);
 	
+	if (symmetric_)
+	{
+		ReconstructRow(p_row);
+		
+		*p_row_nnz = (uint32_t)scratch_columns_.size();
+		if (p_row_columns)
+			*p_row_columns = scratch_columns_.data();
+		return scratch_strengths_.data();
+	}
+	
 	// get the offset into columns/values for p_row, and the number of entries for this row
 	uint64_t offset = row_offsets_[p_row];
 	uint64_t count = row_offsets_[p_row + 1] - offset;
@@ -354,6 +565,67 @@ const sa_strength_t *SparseArray::StrengthsForRow(uint32_t p_row, uint32_t *p_ro
 	return strengths_ + offset;
 }
 
+uint32_t SparseArray::InteractionCountForRow(uint32_t p_row) const
+{
+#if DEBUG
+	// should be done building the array
+	if (!finished_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::InteractionCountForRow): sparse array is not finished being built." << EidosTerminate(nullptr);
+#endif
+	
+	// bounds-check
+	if (p_row >= nrows_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::InteractionCountForRow): row out of range." << EidosTerminate(nullptr);
+	
+	uint64_t count = row_offsets_[p_row + 1] - row_offsets_[p_row];
+	
+	if (symmetric_)
+		count += lower_offsets_[p_row + 1] - lower_offsets_[p_row];
+	
+	return (uint32_t)count;
+}
+
+void SparseArray::StrengthTotalsForRows(double *p_totals) const
+{
+#if DEBUG
+	// should be done building the array
+	if (!finished_)
+		EIDOS_TERMINATION << "ERROR (SparseArray::StrengthTotalsForRows): sparse array is not finished being built." << EidosTerminate(nullptr);
+#endif
+	
+	// p_totals must have nrows_ entries.  For a symmetric array, this visits each stored entry once and adds it to the totals
+	// for both its row and its column, which is much faster than reconstructing every row.  Because rows are visited in order,
+	// each total receives the entries below the diagonal (ascending) before those above it, exactly the order of the full row
+	// given by StrengthsForRow(), so the totals are identical to summing each full row.
+	for (uint32_t row = 0; row < nrows_; ++row)
+		p_totals[row] = 0.0;
+	
+	for (uint32_t row = 0; row < nrows_; ++row)
+	{
+		uint64_t row_end = row_offsets_[row + 1];
+		
+		if (symmetric_)
+		{
+			for (uint64_t entry = row_offsets_[row]; entry < row_end; ++entry)
+			{
+				sa_strength_t strength = strengths_[entry];
+				
+				p_totals[row] += strength;
+				p_totals[columns_[entry]] += strength;
+			}
+		}
+		else
+		{
+			double total = 0.0;
+			
+			for (uint64_t entry = row_offsets_[row]; entry < row_end; ++entry)
+				total += strengths_[entry];
+			
+			p_totals[row] = total;
+		}
+	}
+}
+
 void SparseArray::InteractionsForRow(uint32_t p_row, uint32_t *p_row_nnz, uint32_t **p_row_columns, sa_distance_t **p_row_distances, sa_strength_t **p_row_strengths)
 {
 #if DEBUG
@@ -378,6 +650,9 @@ void SparseArray::InteractionsForRow(uint32_t p_row, uint32_t *p_row_nnz, uint32
 		*p_row_distances = distances_ + offset;
 	if (p_row_strengths)
 		*p_row_strengths = strengths_ + offset;
+	
+	// the caller may modify the row, so any reconstructed row is no longer trustworthy
+	scratch_row_ = UINT32_MAX;
 }
 
 size_t SparseArray::MemoryUsage(void)
@@ -387,6 +662,11 @@ size_t SparseArray::MemoryUsage(void)
 	usage += sizeof(uint32_t) * (nrows_ + 1);
 	usage += (sizeof(uint32_t) + sizeof(sa_distance_t) + sizeof(sa_strength_t)) * (nnz_capacity_);
 	
+	if (lower_offsets_)
+		usage += sizeof(uint64_t) * (nrows_ + 1);
+	usage += sizeof(uint32_t) * lower_capacity_;
+	usage += (sizeof(uint32_t) + sizeof(sa_distance_t) + sizeof(sa_strength_t)) * scratch_columns_.capacity();
+	
 	return usage;
 }
 
@@ -402,6 +682,7 @@ std::ostream &operator<<(std::ostream &p_outstream, const SparseArray &p_array)
 	p_outstream << "   nrows_set == " << p_array.nrows_set_ << std::endl;
 	p_outstream << "   nnz == " << p_array.nnz_ << std::endl;
 	p_outstream << "   nnz_capacity == " << p_array.nnz_capacity_ << std::endl;
+	p_outstream << "   symmetric == " << (p_array.symmetric_ ? "true" : "false") << std::endl;
 	
 	p_outstream << "   row_offsets == {";
 	for (uint32_t row = 0; row < p_array.nrows_set_; ++row)
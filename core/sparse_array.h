@@ -24,6 +24,7 @@
 #include "slim_globals.h"
 
 #include <vector>
+#include <algorithm>
 
 
 /*
@@ -33,6 +34,17 @@
  strength of 0.  Each row of the sparse array contains all of the interaction values *felt* by a given individual; each column
  represents the interactions *exerted* by a given individual.  This way one can quickly read all of the interaction strengths
  felt by a focal individual, which is the typical use case.
+ 
+ A sparse array may also be symmetric, for reciprocal interactions in which the (row, column) entry always equals the (column,
+ row) entry.  In that case only the upper triangle is stored: entries with column <= row are ignored when added, so each
+ interacting pair is stored, and its strength calculated, only once.  When the array is finished, an index is built that gives,
+ for each row, the rows above it that contain an entry for it; the full contents of a row can then be reconstructed, and are,
+ transparently, by DistancesForRow() and StrengthsForRow().  This stores 16 bytes per interacting pair, rather than 24.
+ 
+ Finally, a sparse array may be used to stream rows one at a time, holding only a single row in memory.  BeginStreamedRow()
+ discards the contents of the array and starts a new row, which is then built with AddEntryDistance() as usual and finished with
+ FinishStreamedRow(); that row may then be read and modified with the usual row accessors, but no other row may be accessed.
+ The entry buffers thus only ever grow to the size of the largest row streamed, rather than to the size of the whole array.
  */
 
 // These are the types used to store distances and strengths in SparseArray.  They are defined as float, in order to both cut
@@ -49,7 +61,7 @@ class SparseArray
 private:
 	// we store the spare array in CSR format, with an offset for each row
 	// see https://medium.com/@jmaxg3/101-ways-to-store-a-sparse-matrix-c7f2bf15a229
-	// we do not sort by column within a row; we do a linear search for the column
+	// entries may be added to a row in any order, but Finished() sorts each row by column; lookups then use a binary search
 	// BCH 6/5/2021: expanding to 64-bit for some ivars to accommodate models with > 2 billion interactions
 	uint64_t *row_offsets_;			// offsets into columns/values for each row; for N rows, N+1 entries (extra end entry)
 	uint32_t *columns_;				// the column indices for the non-empty values in each row
@@ -62,21 +74,56 @@ private:
 	uint64_t nnz_capacity_;			// the number of non-zero entries allocated for at present
 	
 	bool finished_;					// if true, Finished() has been called and the sparse array is ready to use
+	bool strengths_added_;			// if true, strengths were supplied while building; otherwise strengths_ is not yet filled in
+	
+	bool symmetric_;				// if true, only entries with column > row are stored; see the comment above
+	uint64_t *lower_offsets_;		// for a symmetric array, offsets into lower_columns_ for each row; for N rows, N+1 entries
+	uint32_t *lower_columns_;		// for a symmetric array, the rows (ascending) whose stored entries have each row as their column
+	uint64_t lower_capacity_;		// the number of entries allocated for in lower_columns_
+	
+	// scratch buffers holding the reconstructed full row scratch_row_ of a symmetric array; UINT32_MAX if none
+	mutable uint32_t scratch_row_;
+	mutable std::vector<uint32_t> scratch_columns_;
+	mutable std::vector<sa_distance_t> scratch_distances_;
+	mutable std::vector<sa_strength_t> scratch_strengths_;
+	
+	// buffers used to sort each streamed row, kept to avoid reallocating them for every row
+	std::vector<uint64_t> stream_keys_;
+	std::vector<sa_distance_t> stream_distances_;
+	std::vector<sa_strength_t> stream_strengths_;
 	
 	void _ResizeToFitNNZ(void);
+	void SortRowsByColumn(void);
+	void SortRowByColumn(uint32_t p_row, std::vector<uint64_t> &p_keys, std::vector<sa_distance_t> &p_temp_distances, std::vector<sa_strength_t> &p_temp_strengths);
+	void BuildLowerIndex(void);
+	void ReconstructRow(uint32_t p_row) const;
+	
+	inline __attribute__((always_inline)) int64_t FindColumn(uint32_t p_row, uint32_t p_column) const
+	{
+		// binary search for p_column in the (sorted) columns of p_row; returns the entry's offset, or -1 if it is not present
+		const uint32_t *row_begin = columns_ + row_offsets_[p_row];
+		const uint32_t *row_end = columns_ + row_offsets_[p_row + 1];
+		const uint32_t *found = std::lower_bound(row_begin, row_end, p_column);
+		
+		if ((found == row_end) || (*found != p_column))
+			return -1;
+		return found - columns_;
+	}
 	inline __attribute__((always_inline)) void ResizeToFitNNZ(void) { if (nnz_ > nnz_capacity_) _ResizeToFitNNZ(); };
 	
 public:
 	SparseArray(const SparseArray&) = delete;					// no copying
 	SparseArray& operator=(const SparseArray&) = delete;		// no copying
 	SparseArray(void) = delete;									// no null construction
-	SparseArray(unsigned int p_nrows, unsigned int p_ncols);
+	SparseArray(unsigned int p_nrows, unsigned int p_ncols, bool p_symmetric = false);
 	~SparseArray(void);
 	
-	void Reset(void);											// reset to a dimensionless state, keeping buffers
-	void Reset(unsigned int p_nrows, unsigned int p_ncols);		// reset to new dimensions, keeping buffers
+	void Reset(void);																// reset to a dimensionless state, keeping buffers
+	void Reset(unsigned int p_nrows, unsigned int p_ncols, bool p_symmetric = false);	// reset to new dimensions, keeping buffers
 	
-	// Building a sparse array; has to be done in row order, and then has to be Finished().  SparseArray supports building
+	// Building a sparse array; has to be done in row order, and then has to be Finished().  Within a row, entries may be
+	// added in any order; Finished() sorts each row by column, so that the contents of a finished sparse array do not depend
+	// upon the order in which entries were added (and thus, for InteractionType, upon the spatial search method used).  SparseArray supports building
 	// a row at a time, or one entry at a time, but one or the other method must be chosen and used throughout the build.
 	// Similarly, you can supply just distances and then add strengths later (using InteractionsForRow() to modify the data),
 	// or you can build supplying strengths during the build, but you should choose one method or the other and stick with
@@ -88,6 +135,10 @@ public:
 	
 	inline void AddEntryDistance(uint32_t p_row, const uint32_t p_column, sa_distance_t p_distance)
 	{
+		// a symmetric sparse array stores only its upper triangle
+		if (symmetric_ && (p_column <= p_row))
+			return;
+		
 #if DEBUG
 		if (finished_)
 			EIDOS_TERMINATION << "ERROR (SparseArray::AddEntryDistance): (internal error) adding entry to sparse array that is finished." << EidosTerminate(nullptr);
@@ -127,7 +178,13 @@ public:
 	void AddEntryInteraction(uint32_t p_row, const uint32_t p_column, sa_distance_t p_distance, sa_strength_t p_strength);
 	
 	void Finished(void);
+	
+	// Streaming a single row instead of building the whole array; see the comment above.  Not supported for symmetric arrays.
+	void BeginStreamedRow(uint32_t p_row);
+	void FinishStreamedRow(void);
+	
 	inline __attribute__((always_inline)) bool IsFinished() const { return finished_; };
+	inline __attribute__((always_inline)) bool IsSymmetric() const { return symmetric_; };
 	
 	// Dimensions
 	inline __attribute__((always_inline)) uint32_t RowCount() const { return nrows_; };
@@ -140,13 +197,18 @@ public:
 	sa_strength_t Strength(uint32_t p_row, uint32_t p_column) const;
 	void PatchStrength(uint32_t p_row, uint32_t p_column, sa_strength_t p_strength);	// modify a strength after the sparse array has been built
 	
+	// These return the full contents of a row.  For a symmetric array the row is reconstructed into scratch buffers, so the
+	// pointers returned are valid only until the next call for a different row, or until the sparse array is modified.
 	const sa_distance_t *DistancesForRow(uint32_t p_row, uint32_t *p_row_nnz, const uint32_t **p_row_columns) const;
 	const sa_strength_t *StrengthsForRow(uint32_t p_row, uint32_t *p_row_nnz, const uint32_t **p_row_columns) const;
+	uint32_t InteractionCountForRow(uint32_t p_row) const;		// the number of entries in the full row, without reconstructing it
+	void StrengthTotalsForRows(double *p_totals) const;			// the total strength of every row, in one pass over the array
 	
 	// Memory usage tallying, for outputUsage()
 	size_t MemoryUsage(void);
 	
-	// Non-const access, for filling in strength values after the fact (among other uses)
+	// Non-const access, for filling in strength values after the fact (among other uses); for a symmetric array, this gives
+	// only the stored entries of the row (those with column > row), which is exactly what needs to be filled in
 	void InteractionsForRow(uint32_t p_row, uint32_t *p_row_nnz, uint32_t **p_row_columns, sa_distance_t **p_row_distances, sa_strength_t **p_row_strengths);
 	
 	friend std::ostream &operator<<(std::ostream &p_outstream, const SparseArray &p_array);
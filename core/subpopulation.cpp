@@ -1878,6 +1878,11 @@ double Subpopulation::ApplyFitnessCallbacks(MutationIndex p_mutation, int p_homo
 						EIDOS_TERMINATION << "ERROR (Subpopulation::ApplyFitnessCallbacks): (internal error) cached optimization flag mismatch" << EidosTerminate(fitness_callback->identifier_token_);
 					}
 				}
+				else if (fitness_callback->compiled_nodes_.size() && fitness_callback->EvaluateCompiledCallback(p_computed_fitness, p_homozygous, gSLiM_Mutation_Block + p_mutation, p_individual, &sim, &p_computed_fitness))
+				{
+					// The callback was compiled into native operations by SLiMSim::OptimizeScriptBlock(), and has now set p_computed_fitness
+					// without involving the interpreter.  If the compiled evaluation fails, we drop through to the interpreter below instead.
+				}
 				else
 				{
 					// local variables for the callback parameters that we might need to allocate here, and thus need to free below
@@ -1965,7 +1970,7 @@ double Subpopulation::ApplyGlobalFitnessCallbacks(std::vector<SLiMEidosBlock*> &
 	SLIM_PROFILE_BLOCK_START();
 #endif
 	
-	double computed_fitness = 1.0;
+	double computed_fitness = 1.0, compiled_fitness;
 	Individual *individual = parent_individuals_[p_individual_index];
 	Genome *genome1 = parent_genomes_[p_individual_index * 2];
 	Genome *genome2 = parent_genomes_[p_individual_index * 2 + 1];
@@ -2039,6 +2044,11 @@ double Subpopulation::ApplyGlobalFitnessCallbacks(std::vector<SLiMEidosBlock*> &
 					EIDOS_TERMINATION << "ERROR (Subpopulation::ApplyGlobalFitnessCallbacks): (internal error) cached optimization flag mismatch" << EidosTerminate(fitness_callback->identifier_token_);
 				}
 			}
+			else if (fitness_callback->compiled_nodes_.size() && fitness_callback->EvaluateCompiledCallback(1.0, -1, nullptr, individual, &sim, &compiled_fitness))
+			{
+				// The callback was compiled into native operations by SLiMSim::OptimizeScriptBlock(); see ApplyFitnessCallbacks()
+				computed_fitness *= compiled_fitness;
+			}
 			else
 			{
 				// We need to actually execute the script; we start a block here to manage the lifetime of the symbol table
@@ -2131,7 +2141,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 	int32_t nonneutral_regime = sim.last_nonneutral_regime_;
 #endif
 	
-	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 	Genome *genome1 = parent_genomes_[p_individual_index * 2];
 	Genome *genome2 = parent_genomes_[p_individual_index * 2 + 1];
 	bool genome1_null = genome1->IsNull();
@@ -2165,7 +2175,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 			
 			// with an unpaired chromosome, we need to multiply each selection coefficient by the haploid dominance coefficient
 			while (genome_iter != genome_max)
-				w *= (mut_block_ptr + *genome_iter++)->cached_one_plus_haploiddom_sel_;
+				w *= (mut_cache_ptr + *genome_iter++)->cached_one_plus_haploiddom_sel_;
 		}
 		
 		return w;
@@ -2180,6 +2190,26 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 			MutationRun *mutrun1 = genome1->mutruns_[run_index].get();
 			MutationRun *mutrun2 = genome2->mutruns_[run_index].get();
 			
+			if (mutrun1 == mutrun2)
+			{
+				// Both genomes share the same mutation run object, so every mutation in it is homozygous; there is no need to
+				// merge the two runs.  This is common, since runs are shared between genomes, and the multiplication order is the
+				// same as the merge below would produce, so the result is bit-identical.
+#if SLIM_USE_NONNEUTRAL_CACHES
+				const MutationIndex *genome_iter, *genome_max;
+				
+				mutrun1->beginend_nonneutral_pointers(&genome_iter, &genome_max, nonneutral_change_counter, nonneutral_regime);
+#else
+				const MutationIndex *genome_iter = mutrun1->begin_pointer_const();
+				const MutationIndex *genome_max = mutrun1->end_pointer_const();
+#endif
+				
+				while (genome_iter != genome_max)
+					w *= (mut_cache_ptr + *genome_iter++)->cached_one_plus_sel_;
+				
+				continue;
+			}
+			
 #if SLIM_USE_NONNEUTRAL_CACHES
 			// Cache non-neutral mutations and read from the non-neutral buffers
 			const MutationIndex *genome1_iter, *genome2_iter, *genome1_max, *genome2_max;
@@ -2199,32 +2229,32 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 			if (genome1_iter != genome1_max && genome2_iter != genome2_max)
 			{
 				MutationIndex genome1_mutation = *genome1_iter, genome2_mutation = *genome2_iter;
-				slim_position_t genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_, genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+				slim_position_t genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_, genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 				
 				do
 				{
 					if (genome1_iter_position < genome2_iter_position)
 					{
 						// Process a mutation in genome1 since it is leading
-						w *= (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
+						w *= (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
 						
 						if (++genome1_iter == genome1_max)
 							break;
 						else {
 							genome1_mutation = *genome1_iter;
-							genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_;
+							genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_;
 						}
 					}
 					else if (genome1_iter_position > genome2_iter_position)
 					{
 						// Process a mutation in genome2 since it is leading
-						w *= (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
+						w *= (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
 						
 						if (++genome2_iter == genome2_max)
 							break;
 						else {
 							genome2_mutation = *genome2_iter;
-							genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+							genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 						}
 					}
 					else
@@ -2239,12 +2269,12 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 							const MutationIndex *genome2_matchscan = genome2_iter; 
 							
 							// advance through genome2 with genome2_matchscan, looking for a match for the current mutation in genome1, to determine whether we are homozygous or not
-							while (genome2_matchscan != genome2_max && (mut_block_ptr + *genome2_matchscan)->position_ == position)
+							while (genome2_matchscan != genome2_max && (mut_cache_ptr + *genome2_matchscan)->position_ == position)
 							{
 								if (genome1_mutation == *genome2_matchscan) 		// note pointer equality test
 								{
 									// a match was found, so we multiply our fitness by the full selection coefficient
-									w *= (mut_block_ptr + genome1_mutation)->cached_one_plus_sel_;
+									w *= (mut_cache_ptr + genome1_mutation)->cached_one_plus_sel_;
 									goto homozygousExit1;
 								}
 								
@@ -2252,7 +2282,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 							}
 							
 							// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-							w *= (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
+							w *= (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
 							
 						homozygousExit1:
 							
@@ -2260,7 +2290,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 								break;
 							else {
 								genome1_mutation = *genome1_iter;
-								genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_;
+								genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_;
 							}
 						} while (genome1_iter_position == position);
 						
@@ -2270,7 +2300,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 							const MutationIndex *genome1_matchscan = genome1_start; 
 							
 							// advance through genome1 with genome1_matchscan, looking for a match for the current mutation in genome2, to determine whether we are homozygous or not
-							while (genome1_matchscan != genome1_max && (mut_block_ptr + *genome1_matchscan)->position_ == position)
+							while (genome1_matchscan != genome1_max && (mut_cache_ptr + *genome1_matchscan)->position_ == position)
 							{
 								if (genome2_mutation == *genome1_matchscan)		// note pointer equality test
 								{
@@ -2282,7 +2312,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 							}
 							
 							// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-							w *= (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
+							w *= (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
 							
 						homozygousExit2:
 							
@@ -2290,7 +2320,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 								break;
 							else {
 								genome2_mutation = *genome2_iter;
-								genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+								genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 							}
 						} while (genome2_iter_position == position);
 						
@@ -2308,11 +2338,11 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_NoCallbacks(slim_popsize_
 			
 			// if genome1 is unfinished, finish it
 			while (genome1_iter != genome1_max)
-				w *= (mut_block_ptr + *genome1_iter++)->cached_one_plus_dom_sel_;
+				w *= (mut_cache_ptr + *genome1_iter++)->cached_one_plus_dom_sel_;
 			
 			// if genome2 is unfinished, finish it
 			while (genome2_iter != genome2_max)
-				w *= (mut_block_ptr + *genome2_iter++)->cached_one_plus_dom_sel_;
+				w *= (mut_cache_ptr + *genome2_iter++)->cached_one_plus_dom_sel_;
 		}
 		
 		return w;
@@ -2332,7 +2362,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 	int32_t nonneutral_regime = sim.last_nonneutral_regime_;
 #endif
 	
-	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 	Individual *individual = parent_individuals_[p_individual_index];
 	Genome *genome1 = parent_genomes_[p_individual_index * 2];
 	Genome *genome2 = parent_genomes_[p_individual_index * 2 + 1];
@@ -2370,7 +2400,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 			{
 				MutationIndex genome_mutation = *genome_iter;
 				
-				w *= ApplyFitnessCallbacks(genome_mutation, -1, (mut_block_ptr + genome_mutation)->cached_one_plus_haploiddom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+				w *= ApplyFitnessCallbacks(genome_mutation, -1, (mut_cache_ptr + genome_mutation)->cached_one_plus_haploiddom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 				
 				if (w <= 0.0)
 					return 0.0;
@@ -2410,14 +2440,14 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 			if (genome1_iter != genome1_max && genome2_iter != genome2_max)
 			{
 				MutationIndex genome1_mutation = *genome1_iter, genome2_mutation = *genome2_iter;
-				slim_position_t genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_, genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+				slim_position_t genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_, genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 				
 				do
 				{
 					if (genome1_iter_position < genome2_iter_position)
 					{
 						// Process a mutation in genome1 since it is leading
-						w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+						w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 						
 						if (w <= 0.0)
 							return 0.0;
@@ -2426,13 +2456,13 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 							break;
 						else {
 							genome1_mutation = *genome1_iter;
-							genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_;
+							genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_;
 						}
 					}
 					else if (genome1_iter_position > genome2_iter_position)
 					{
 						// Process a mutation in genome2 since it is leading
-						w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+						w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 						
 						if (w <= 0.0)
 							return 0.0;
@@ -2441,7 +2471,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 							break;
 						else {
 							genome2_mutation = *genome2_iter;
-							genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+							genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 						}
 					}
 					else
@@ -2456,12 +2486,12 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 							const MutationIndex *genome2_matchscan = genome2_iter; 
 							
 							// advance through genome2 with genome2_matchscan, looking for a match for the current mutation in genome1, to determine whether we are homozygous or not
-							while (genome2_matchscan != genome2_max && (mut_block_ptr + *genome2_matchscan)->position_ == position)
+							while (genome2_matchscan != genome2_max && (mut_cache_ptr + *genome2_matchscan)->position_ == position)
 							{
 								if (genome1_mutation == *genome2_matchscan)		// note pointer equality test
 								{
 									// a match was found, so we multiply our fitness by the full selection coefficient
-									w *= ApplyFitnessCallbacks(genome1_mutation, true, (mut_block_ptr + genome1_mutation)->cached_one_plus_sel_, p_fitness_callbacks, individual, genome1, genome2);
+									w *= ApplyFitnessCallbacks(genome1_mutation, true, (mut_cache_ptr + genome1_mutation)->cached_one_plus_sel_, p_fitness_callbacks, individual, genome1, genome2);
 									
 									goto homozygousExit3;
 								}
@@ -2470,7 +2500,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 							}
 							
 							// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-							w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+							w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 							
 						homozygousExit3:
 							
@@ -2481,7 +2511,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 								break;
 							else {
 								genome1_mutation = *genome1_iter;
-								genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_;
+								genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_;
 							}
 						} while (genome1_iter_position == position);
 						
@@ -2491,7 +2521,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 							const MutationIndex *genome1_matchscan = genome1_start; 
 							
 							// advance through genome1 with genome1_matchscan, looking for a match for the current mutation in genome2, to determine whether we are homozygous or not
-							while (genome1_matchscan != genome1_max && (mut_block_ptr + *genome1_matchscan)->position_ == position)
+							while (genome1_matchscan != genome1_max && (mut_cache_ptr + *genome1_matchscan)->position_ == position)
 							{
 								if (genome2_mutation == *genome1_matchscan)		// note pointer equality test
 								{
@@ -2503,7 +2533,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 							}
 							
 							// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-							w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+							w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 							
 							if (w <= 0.0)
 								return 0.0;
@@ -2514,7 +2544,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 								break;
 							else {
 								genome2_mutation = *genome2_iter;
-								genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+								genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 							}
 						} while (genome2_iter_position == position);
 						
@@ -2533,7 +2563,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 			{
 				MutationIndex genome1_mutation = *genome1_iter;
 				
-				w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+				w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 				
 				if (w <= 0.0)
 					return 0.0;
@@ -2546,7 +2576,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_Callbacks(slim_popsize_t
 			{
 				MutationIndex genome2_mutation = *genome2_iter;
 				
-				w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+				w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 				
 				if (w <= 0.0)
 					return 0.0;
@@ -2573,6 +2603,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 #endif
 	
 	Mutation *mut_block_ptr = gSLiM_Mutation_Block;
+	MutationFitnessCache *mut_cache_ptr = gSLiM_Mutation_FitnessCaches;
 	Individual *individual = parent_individuals_[p_individual_index];
 	Genome *genome1 = parent_genomes_[p_individual_index * 2];
 	Genome *genome2 = parent_genomes_[p_individual_index * 2 + 1];
@@ -2612,14 +2643,14 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 				
 				if ((mut_block_ptr + genome_mutation)->mutation_type_ptr_ == p_single_callback_mut_type)
 				{
-					w *= ApplyFitnessCallbacks(genome_mutation, -1, (mut_block_ptr + genome_mutation)->cached_one_plus_haploiddom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+					w *= ApplyFitnessCallbacks(genome_mutation, -1, (mut_cache_ptr + genome_mutation)->cached_one_plus_haploiddom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 					
 					if (w <= 0.0)
 						return 0.0;
 				}
 				else
 				{
-					w *= (mut_block_ptr + genome_mutation)->cached_one_plus_haploiddom_sel_;
+					w *= (mut_cache_ptr + genome_mutation)->cached_one_plus_haploiddom_sel_;
 				}
 				
 				genome_iter++;
@@ -2657,7 +2688,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 			if (genome1_iter != genome1_max && genome2_iter != genome2_max)
 			{
 				MutationIndex genome1_mutation = *genome1_iter, genome2_mutation = *genome2_iter;
-				slim_position_t genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_, genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+				slim_position_t genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_, genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 				
 				do
 				{
@@ -2668,21 +2699,21 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 						
 						if (genome1_muttype == p_single_callback_mut_type)
 						{
-							w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+							w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 							
 							if (w <= 0.0)
 								return 0.0;
 						}
 						else
 						{
-							w *= (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
+							w *= (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
 						}
 						
 						if (++genome1_iter == genome1_max)
 							break;
 						else {
 							genome1_mutation = *genome1_iter;
-							genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_;
+							genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_;
 						}
 					}
 					else if (genome1_iter_position > genome2_iter_position)
@@ -2692,21 +2723,21 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 						
 						if (genome2_muttype == p_single_callback_mut_type)
 						{
-							w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+							w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 							
 							if (w <= 0.0)
 								return 0.0;
 						}
 						else
 						{
-							w *= (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
+							w *= (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
 						}
 						
 						if (++genome2_iter == genome2_max)
 							break;
 						else {
 							genome2_mutation = *genome2_iter;
-							genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+							genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 						}
 					}
 					else
@@ -2725,12 +2756,12 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								const MutationIndex *genome2_matchscan = genome2_iter; 
 								
 								// advance through genome2 with genome2_matchscan, looking for a match for the current mutation in genome1, to determine whether we are homozygous or not
-								while (genome2_matchscan != genome2_max && (mut_block_ptr + *genome2_matchscan)->position_ == position)
+								while (genome2_matchscan != genome2_max && (mut_cache_ptr + *genome2_matchscan)->position_ == position)
 								{
 									if (genome1_mutation == *genome2_matchscan)		// note pointer equality test
 									{
 										// a match was found, so we multiply our fitness by the full selection coefficient
-										w *= ApplyFitnessCallbacks(genome1_mutation, true, (mut_block_ptr + genome1_mutation)->cached_one_plus_sel_, p_fitness_callbacks, individual, genome1, genome2);
+										w *= ApplyFitnessCallbacks(genome1_mutation, true, (mut_cache_ptr + genome1_mutation)->cached_one_plus_sel_, p_fitness_callbacks, individual, genome1, genome2);
 										
 										goto homozygousExit5;
 									}
@@ -2739,7 +2770,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								}
 								
 								// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-								w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+								w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 								
 							homozygousExit5:
 								
@@ -2751,12 +2782,12 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								const MutationIndex *genome2_matchscan = genome2_iter; 
 								
 								// advance through genome2 with genome2_matchscan, looking for a match for the current mutation in genome1, to determine whether we are homozygous or not
-								while (genome2_matchscan != genome2_max && (mut_block_ptr + *genome2_matchscan)->position_ == position)
+								while (genome2_matchscan != genome2_max && (mut_cache_ptr + *genome2_matchscan)->position_ == position)
 								{
 									if (genome1_mutation == *genome2_matchscan) 		// note pointer equality test
 									{
 										// a match was found, so we multiply our fitness by the full selection coefficient
-										w *= (mut_block_ptr + genome1_mutation)->cached_one_plus_sel_;
+										w *= (mut_cache_ptr + genome1_mutation)->cached_one_plus_sel_;
 										goto homozygousExit6;
 									}
 									
@@ -2764,7 +2795,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								}
 								
 								// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-								w *= (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
+								w *= (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
 								
 							homozygousExit6:
 								;
@@ -2774,7 +2805,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								break;
 							else {
 								genome1_mutation = *genome1_iter;
-								genome1_iter_position = (mut_block_ptr + genome1_mutation)->position_;
+								genome1_iter_position = (mut_cache_ptr + genome1_mutation)->position_;
 							}
 						} while (genome1_iter_position == position);
 						
@@ -2788,7 +2819,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								const MutationIndex *genome1_matchscan = genome1_start; 
 								
 								// advance through genome1 with genome1_matchscan, looking for a match for the current mutation in genome2, to determine whether we are homozygous or not
-								while (genome1_matchscan != genome1_max && (mut_block_ptr + *genome1_matchscan)->position_ == position)
+								while (genome1_matchscan != genome1_max && (mut_cache_ptr + *genome1_matchscan)->position_ == position)
 								{
 									if (genome2_mutation == *genome1_matchscan)		// note pointer equality test
 									{
@@ -2800,7 +2831,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								}
 								
 								// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-								w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+								w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 								
 								if (w <= 0.0)
 									return 0.0;
@@ -2813,7 +2844,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								const MutationIndex *genome1_matchscan = genome1_start; 
 								
 								// advance through genome1 with genome1_matchscan, looking for a match for the current mutation in genome2, to determine whether we are homozygous or not
-								while (genome1_matchscan != genome1_max && (mut_block_ptr + *genome1_matchscan)->position_ == position)
+								while (genome1_matchscan != genome1_max && (mut_cache_ptr + *genome1_matchscan)->position_ == position)
 								{
 									if (genome2_mutation == *genome1_matchscan)		// note pointer equality test
 									{
@@ -2825,7 +2856,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								}
 								
 								// no match was found, so we are heterozygous; we multiply our fitness by the selection coefficient and the dominance coefficient
-								w *= (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
+								w *= (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
 								
 							homozygousExit8:
 								;
@@ -2835,7 +2866,7 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 								break;
 							else {
 								genome2_mutation = *genome2_iter;
-								genome2_iter_position = (mut_block_ptr + genome2_mutation)->position_;
+								genome2_iter_position = (mut_cache_ptr + genome2_mutation)->position_;
 							}
 						} while (genome2_iter_position == position);
 						
@@ -2857,14 +2888,14 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 				
 				if (genome1_muttype == p_single_callback_mut_type)
 				{
-					w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+					w *= ApplyFitnessCallbacks(genome1_mutation, false, (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 					
 					if (w <= 0.0)
 						return 0.0;
 				}
 				else
 				{
-					w *= (mut_block_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
+					w *= (mut_cache_ptr + genome1_mutation)->cached_one_plus_dom_sel_;
 				}
 				
 				genome1_iter++;
@@ -2878,14 +2909,14 @@ double Subpopulation::FitnessOfParentWithGenomeIndices_SingleCallback(slim_popsi
 				
 				if (genome2_muttype == p_single_callback_mut_type)
 				{
-					w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
+					w *= ApplyFitnessCallbacks(genome2_mutation, false, (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_, p_fitness_callbacks, individual, genome1, genome2);
 					
 					if (w <= 0.0)
 						return 0.0;
 				}
 				else
 				{
-					w *= (mut_block_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
+					w *= (mut_cache_ptr + genome2_mutation)->cached_one_plus_dom_sel_;
 				}
 				
 				genome2_iter++;
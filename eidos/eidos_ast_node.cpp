@@ -79,6 +79,7 @@ void EidosASTNode::OptimizeTree(void) const
 	_OptimizeEvaluators();		// cache evaluator functions in cached_evaluator_ for fast node evaluation
 	_OptimizeFor();				// cache information about for loops that allows them to be accelerated at runtime
 	_OptimizeAssignments();		// cache information about assignments that allows simple increment/decrement assignments to be accelerated
+	_OptimizeFusedReductions();	// cache information about reductions like sum(x * y) that allows them to be evaluated without temporaries
 }
 
 void EidosASTNode::_OptimizeConstants(void) const
@@ -373,6 +374,91 @@ void EidosASTNode::_OptimizeAssignments(void) const
 	}
 }
 
+// Determines whether p_node is an elementwise arithmetic expression that EidosInterpreter::_EvaluateFusedReduction() can handle: the
+// binary operators + - * / ^, unary -, and calls to exp(), log(), log10(), sqrt(), and abs(), with only identifiers and numeric constants
+// at the leaves.  Leaves have no side effects, so the interpreter can look them up and still fall back to normal evaluation if it finds
+// types or sizes it does not handle.  p_node_count counts the nodes, which is limited by the interpreter's fixed-size block buffers.
+static bool Eidos_IsFusibleArithmetic(const EidosASTNode *p_node, int *p_node_count)
+{
+	if (++(*p_node_count) > EIDOS_FUSED_MAX_NODES)
+		return false;
+	
+	EidosTokenType token_type = p_node->token_->token_type_;
+	const std::vector<EidosASTNode *> &children = p_node->children_;
+	
+	switch (token_type)
+	{
+		case EidosTokenType::kTokenIdentifier:
+			return (children.size() == 0);
+		case EidosTokenType::kTokenNumber:
+			return (children.size() == 0) && p_node->cached_literal_value_;
+		case EidosTokenType::kTokenPlus:
+		case EidosTokenType::kTokenMult:
+		case EidosTokenType::kTokenDiv:
+		case EidosTokenType::kTokenExp:
+			return (children.size() == 2) && Eidos_IsFusibleArithmetic(children[0], p_node_count) && Eidos_IsFusibleArithmetic(children[1], p_node_count);
+		case EidosTokenType::kTokenMinus:
+			if (children.size() == 1)
+				return Eidos_IsFusibleArithmetic(children[0], p_node_count);
+			return (children.size() == 2) && Eidos_IsFusibleArithmetic(children[0], p_node_count) && Eidos_IsFusibleArithmetic(children[1], p_node_count);
+		case EidosTokenType::kTokenLParen:
+		{
+			if ((children.size() != 2) || (children[0]->token_->token_type_ != EidosTokenType::kTokenIdentifier))
+				return false;
+			
+			const EidosFunctionSignature *signature = children[0]->cached_signature_.get();
+			
+			if (!signature)
+				return false;
+			
+			EidosInternalFunctionPtr function = signature->internal_function_;
+			
+			if ((function != &Eidos_ExecuteFunction_exp) && (function != &Eidos_ExecuteFunction_log) && (function != &Eidos_ExecuteFunction_log10) && (function != &Eidos_ExecuteFunction_sqrt) && (function != &Eidos_ExecuteFunction_abs))
+				return false;
+			
+			return Eidos_IsFusibleArithmetic(children[1], p_node_count);
+		}
+		default:
+			return false;
+	}
+}
+
+void EidosASTNode::_OptimizeFusedReductions(void) const
+{
+	// recurse down the tree; determine our children, then ourselves
+	for (auto child : children_)
+		child->_OptimizeFusedReductions();
+	
+	if ((token_->token_type_ == EidosTokenType::kTokenLParen) && (children_.size() == 2))
+	{
+		// We have a call node with a single argument; it must be a call to one of the built-in reductions...
+		const EidosASTNode *call_name_node = children_[0];
+		const EidosFunctionSignature *signature = call_name_node->cached_signature_.get();
+		
+		if ((call_name_node->token_->token_type_ != EidosTokenType::kTokenIdentifier) || !signature)
+			return;
+		
+		EidosInternalFunctionPtr function = signature->internal_function_;
+		const EidosASTNode *argument_node = children_[1];
+		EidosTokenType argument_token_type = argument_node->token_->token_type_;
+		int node_count = 0;
+		
+		if ((function == &Eidos_ExecuteFunction_sum) || (function == &Eidos_ExecuteFunction_mean) || (function == &Eidos_ExecuteFunction_max) || (function == &Eidos_ExecuteFunction_min))
+		{
+			// ... and for these, the argument must be an arithmetic expression; a plain identifier gains nothing
+			if ((argument_token_type != EidosTokenType::kTokenIdentifier) && (argument_token_type != EidosTokenType::kTokenNumber) && Eidos_IsFusibleArithmetic(argument_node, &node_count))
+				cached_fused_reduction_ = true;
+		}
+		else if ((function == &Eidos_ExecuteFunction_any) || (function == &Eidos_ExecuteFunction_all))
+		{
+			// ... and for these, the argument must be a comparison between arithmetic expressions
+			if (((argument_token_type == EidosTokenType::kTokenEq) || (argument_token_type == EidosTokenType::kTokenNotEq) || (argument_token_type == EidosTokenType::kTokenLt) || (argument_token_type == EidosTokenType::kTokenLtEq) || (argument_token_type == EidosTokenType::kTokenGt) || (argument_token_type == EidosTokenType::kTokenGtEq)) &&
+				(argument_node->children_.size() == 2) && Eidos_IsFusibleArithmetic(argument_node->children_[0], &node_count) && Eidos_IsFusibleArithmetic(argument_node->children_[1], &node_count))
+				cached_fused_reduction_ = true;
+		}
+	}
+}
+
 bool EidosASTNode::HasCachedNumericValue(void) const
 {
 	if ((token_->token_type_ == EidosTokenType::kTokenNumber) && cached_literal_value_ && (cached_literal_value_->Count() == 1))
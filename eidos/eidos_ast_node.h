@@ -85,6 +85,7 @@ public:
 	mutable uint8_t cached_for_references_index_ = true;				// pre-cached as true if the index variable is referenced at all in the loop
 	mutable uint8_t cached_for_assigns_index_ = true;					// pre-cached as true if the index variable is assigned to in the loop
 	mutable uint8_t cached_compound_assignment_ = false;				// pre-cached on assignment nodes if they are of the form "x=x+1" or "x=x-1" only
+	mutable uint8_t cached_fused_reduction_ = false;					// pre-cached on call nodes like "sum(x * y)" that can be evaluated without temporaries
 	
 	mutable EidosTypeSpecifier typespec_;								// only valid for type-specifier nodes inside function declarations
 	mutable bool hit_eof_in_tolerant_parse_ = false;					// only valid for compound statement nodes; used by the type-interpreter to handle scoping
@@ -120,6 +121,7 @@ public:
 	void _OptimizeFor(void) const;										// determine whether/how for-loop index variables need to be set up
 	void _OptimizeForScan(const std::string &p_for_index_identifier, uint8_t *p_references, uint8_t *p_assigns) const;	// internal method
 	void _OptimizeAssignments(void) const;								// detect and mark simple increment/decrement assignments on a variable
+	void _OptimizeFusedReductions(void) const;							// detect and mark reductions of elementwise arithmetic that can be fused
 	
 	bool HasCachedNumericValue(void) const;
 	double CachedNumericValue(void) const;
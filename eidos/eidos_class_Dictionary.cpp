@@ -281,9 +281,11 @@ void EidosDictionaryUnretained::SetKeyValue(const std::string &key, EidosValue_S
 		if (!state_ptr_)
 			state_ptr_ = new EidosDictionaryState();
 		
-		// Copy if necessary; see ExecuteMethod_Accelerated_setValue() for comments
-		if ((value->UseCount() != 1) || value->Invisible())
+		// Copy if necessary, following EidosSymbolTable::SetValueForSymbol(); values marked copy-on-write can be shared
+		if ((!value->CopyOnWrite() && (value->UseCount() != 1)) || value->Invisible())
 			value = value->CopyValues();
+		if (value->UseCount() == 1)
+			value->SetCopyOnWrite();
 		
 		state_ptr_->dictionary_symbols_[key] = value;
 		
@@ -333,8 +335,8 @@ void EidosDictionaryUnretained::AddKeysAndValuesFrom(EidosDictionaryUnretained *
 					EIDOS_TERMINATION << "ERROR (EidosDictionaryUnretained::AddKeysAndValuesFrom): a column named '" << key << "' already exists." << EidosTerminate(nullptr);
 			}
 			
-			// always copy values here; unlike setValue(), we know the value is in use elsewhere
-			state_ptr_->dictionary_symbols_[key] = value->CopyValues();
+			// copy values here unless they can be shared copy-on-write; unlike setValue(), we know the value is in use elsewhere
+			state_ptr_->dictionary_symbols_[key] = (value->CopyOnWrite() ? value : value->CopyValues());
 			
 			KeyAddedToDictionary(key);
 		}
@@ -371,8 +373,8 @@ void EidosDictionaryUnretained::AppendKeysAndValuesFrom(EidosDictionaryUnretaine
 			
 			if (found_iter == state_ptr_->dictionary_symbols_.end())
 			{
-				// always copy values here; unlike setValue(), we know the value is in use elsewhere
-				state_ptr_->dictionary_symbols_[key] = keyvalue->CopyValues();
+				// copy values here unless they can be shared copy-on-write; unlike setValue(), we know the value is in use elsewhere
+				state_ptr_->dictionary_symbols_[key] = (keyvalue->CopyOnWrite() ? keyvalue : keyvalue->CopyValues());
 				
 				KeyAddedToDictionary(key);
 			}
@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <numeric>
 #include <cmath>
@@ -839,6 +840,137 @@ EidosValue_SP ConcatenateEidosValues(const std::vector<EidosValue_SP> &p_argumen
 	return EidosValue_SP(nullptr);
 }
 
+// Hash-based uniquing and set operations, used for vectors large enough that the simple O(N^2) scans below become
+// expensive.  These work on element indices, so that the callers can build results of the appropriate type.  Float
+// keys need a custom hash and equality so that all NANs are equal to each other, as elsewhere in Eidos, and so that
+// -0.0 and 0.0 (which compare equal) hash the same; string keys are pointers into the string vector, to avoid copying.
+#define EIDOS_HASHED_UNIQUE_THRESHOLD	50		// a guess based on timing data; will be platform-dependent and dataset-dependent
+
+struct Eidos_FloatKeyHash {
+	std::size_t operator()(double p_value) const { return std::hash<double>{}(std::isnan(p_value) ? std::numeric_limits<double>::quiet_NaN() : ((p_value == 0.0) ? 0.0 : p_value)); }
+};
+struct Eidos_FloatKeyEqual {
+	bool operator()(double p_l, double p_r) const { return (std::isnan(p_l) && std::isnan(p_r)) || (p_l == p_r); }
+};
+struct Eidos_StringKeyHash {
+	std::size_t operator()(const std::string *p_value) const { return std::hash<std::string>{}(*p_value); }
+};
+struct Eidos_StringKeyEqual {
+	bool operator()(const std::string *p_l, const std::string *p_r) const { return *p_l == *p_r; }
+};
+
+template <typename T> struct Eidos_HashSetTraits;
+
+#if EIDOS_ROBIN_HOOD_HASHING
+template <> struct Eidos_HashSetTraits<int64_t> { typedef robin_hood::unordered_flat_set<int64_t> set_type; static inline int64_t Key(const int64_t &p_value) { return p_value; } };
+template <> struct Eidos_HashSetTraits<double> { typedef robin_hood::unordered_flat_set<double, Eidos_FloatKeyHash, Eidos_FloatKeyEqual> set_type; static inline double Key(const double &p_value) { return p_value; } };
+template <> struct Eidos_HashSetTraits<std::string> { typedef robin_hood::unordered_flat_set<const std::string *, Eidos_StringKeyHash, Eidos_StringKeyEqual> set_type; static inline const std::string *Key(const std::string &p_value) { return &p_value; } };
+template <> struct Eidos_HashSetTraits<EidosObject *> { typedef robin_hood::unordered_flat_set<EidosObject *> set_type; static inline EidosObject *Key(EidosObject * const &p_value) { return p_value; } };
+#elif STD_UNORDERED_MAP_HASHING
+template <> struct Eidos_HashSetTraits<int64_t> { typedef std::unordered_set<int64_t> set_type; static inline int64_t Key(const int64_t &p_value) { return p_value; } };
+template <> struct Eidos_HashSetTraits<double> { typedef std::unordered_set<double, Eidos_FloatKeyHash, Eidos_FloatKeyEqual> set_type; static inline double Key(const double &p_value) { return p_value; } };
+template <> struct Eidos_HashSetTraits<std::string> { typedef std::unordered_set<const std::string *, Eidos_StringKeyHash, Eidos_StringKeyEqual> set_type; static inline const std::string *Key(const std::string &p_value) { return &p_value; } };
+template <> struct Eidos_HashSetTraits<EidosObject *> { typedef std::unordered_set<EidosObject *> set_type; static inline EidosObject *Key(EidosObject * const &p_value) { return p_value; } };
+#endif
+
+// Appends to p_result_indices the indices of the first occurrence of each value in p_x that is not in p_excluded;
+// p_excluded may be nullptr.  This is unique() when p_excluded is empty, and setDifference() otherwise.
+template <typename T>
+static void Eidos_HashedUniqueIndices(const T *p_x, int p_x_count, const T *p_excluded, int p_excluded_count, std::vector<int> &p_result_indices)
+{
+	typedef Eidos_HashSetTraits<T> traits;
+	typename traits::set_type seen;
+	
+	try {
+		seen.reserve(p_x_count + p_excluded_count);
+		
+		// values already in the set are never added to the result, so we seed it with the excluded values
+		for (int index = 0; index < p_excluded_count; ++index)
+			seen.emplace(traits::Key(p_excluded[index]));
+		
+		for (int index = 0; index < p_x_count; ++index)
+			if (seen.emplace(traits::Key(p_x[index])).second)
+				p_result_indices.emplace_back(index);
+	} catch (...) {
+		EIDOS_TERMINATION << "ERROR (Eidos_HashedUniqueIndices): (internal error) encountered a raise from an internal hash table; please report this." << EidosTerminate(nullptr);
+	}
+}
+
+// Appends to p_result_indices the indices of the first occurrence of each value in p_x that is also in p_y
+template <typename T>
+static void Eidos_HashedIntersectionIndices(const T *p_x, int p_x_count, const T *p_y, int p_y_count, std::vector<int> &p_result_indices)
+{
+	typedef Eidos_HashSetTraits<T> traits;
+	typename traits::set_type remaining;
+	
+	try {
+		remaining.reserve(p_y_count);
+		
+		for (int index = 0; index < p_y_count; ++index)
+			remaining.emplace(traits::Key(p_y[index]));
+		
+		// each value is removed from the set when it is first found, which uniques the result
+		for (int index = 0; index < p_x_count; ++index)
+			if (remaining.erase(traits::Key(p_x[index])))
+				p_result_indices.emplace_back(index);
+	} catch (...) {
+		EIDOS_TERMINATION << "ERROR (Eidos_HashedIntersectionIndices): (internal error) encountered a raise from an internal hash table; please report this." << EidosTerminate(nullptr);
+	}
+}
+
+// Set operations on two vectors use hashing when the scans would be costly; this is roughly the number of comparisons
+static inline bool Eidos_UseHashedSetOperation(int64_t p_x_count, int64_t p_y_count)
+{
+	return (p_x_count * (p_x_count + p_y_count) >= EIDOS_HASHED_UNIQUE_THRESHOLD * EIDOS_HASHED_UNIQUE_THRESHOLD);
+}
+
+// Appends the elements of p_source at p_indices to p_result, which must be a vector of the same type
+static void Eidos_AppendElementsAtIndices(EidosValue *p_result, const EidosValue *p_source, const std::vector<int> &p_indices)
+{
+	EidosValueType source_type = p_source->Type();
+	
+	if (source_type == EidosValueType::kValueInt)
+	{
+		const int64_t *int_data = p_source->IntVector()->data();
+		EidosValue_Int_vector *int_result = p_result->IntVector_Mutable();
+		
+		int_result->reserve(int_result->size() + p_indices.size());
+		
+		for (int index : p_indices)
+			int_result->push_int(int_data[index]);
+	}
+	else if (source_type == EidosValueType::kValueFloat)
+	{
+		const double *float_data = p_source->FloatVector()->data();
+		EidosValue_Float_vector *float_result = p_result->FloatVector_Mutable();
+		
+		float_result->reserve(float_result->size() + p_indices.size());
+		
+		for (int index : p_indices)
+			float_result->push_float(float_data[index]);
+	}
+	else if (source_type == EidosValueType::kValueString)
+	{
+		const std::vector<std::string> &string_vec = *p_source->StringVector();
+		std::vector<std::string> &string_result = *p_result->StringVector_Mutable();
+		
+		string_result.reserve(string_result.size() + p_indices.size());
+		
+		for (int index : p_indices)
+			string_result.emplace_back(string_vec[index]);
+	}
+	else if (source_type == EidosValueType::kValueObject)
+	{
+		EidosObject * const *object_data = p_source->ObjectElementVector()->data();
+		EidosValue_Object_vector *object_result = p_result->ObjectElementVector_Mutable();
+		
+		object_result->reserve(object_result->size() + p_indices.size());
+		
+		for (int index : p_indices)
+			object_result->push_object_element_CRR(object_data[index]);
+	}
+}
+
 EidosValue_SP UniqueEidosValue(const EidosValue *p_x_value, bool p_force_new_vector, bool p_preserve_order)
 {
 	EidosValue_SP result_SP(nullptr);
@@ -911,7 +1043,18 @@ EidosValue_SP UniqueEidosValue(const EidosValue *p_x_value, bool p_force_new_vec
 		EidosValue_Int_vector *int_result = new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector();
 		result_SP = EidosValue_SP(int_result);
 		
-		if (p_preserve_order)
+		if (p_preserve_order && (x_count >= EIDOS_HASHED_UNIQUE_THRESHOLD))
+		{
+			std::vector<int> unique_indices;
+			
+			Eidos_HashedUniqueIndices(int_data, x_count, (const int64_t *)nullptr, 0, unique_indices);
+			
+			int_result->resize_no_initialize(unique_indices.size());
+			
+			for (size_t unique_index = 0; unique_index < unique_indices.size(); ++unique_index)
+				int_result->set_int_no_check(int_data[unique_indices[unique_index]], unique_index);
+		}
+		else if (p_preserve_order)
 		{
 			for (int value_index = 0; value_index < x_count; ++value_index)
 			{
@@ -951,7 +1094,18 @@ EidosValue_SP UniqueEidosValue(const EidosValue *p_x_value, bool p_force_new_vec
 		EidosValue_Float_vector *float_result = new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector();
 		result_SP = EidosValue_SP(float_result);
 		
-		if (p_preserve_order)
+		if (p_preserve_order && (x_count >= EIDOS_HASHED_UNIQUE_THRESHOLD))
+		{
+			std::vector<int> unique_indices;
+			
+			Eidos_HashedUniqueIndices(float_data, x_count, (const double *)nullptr, 0, unique_indices);
+			
+			float_result->resize_no_initialize(unique_indices.size());
+			
+			for (size_t unique_index = 0; unique_index < unique_indices.size(); ++unique_index)
+				float_result->set_float_no_check(float_data[unique_indices[unique_index]], unique_index);
+		}
+		else if (p_preserve_order)
 		{
 			for (int value_index = 0; value_index < x_count; ++value_index)
 			{
@@ -996,7 +1150,16 @@ EidosValue_SP UniqueEidosValue(const EidosValue *p_x_value, bool p_force_new_vec
 		EidosValue_String_vector *string_result = new (gEidosValuePool->AllocateChunk()) EidosValue_String_vector();
 		result_SP = EidosValue_SP(string_result);
 		
-		if (p_preserve_order)
+		if (p_preserve_order && (x_count >= EIDOS_HASHED_UNIQUE_THRESHOLD))
+		{
+			std::vector<int> unique_indices;
+			
+			Eidos_HashedUniqueIndices(string_vec.data(), x_count, (const std::string *)nullptr, 0, unique_indices);
+			
+			for (int unique_index : unique_indices)
+				string_result->PushString(string_vec[unique_index]);
+		}
+		else if (p_preserve_order)
 		{
 			for (int value_index = 0; value_index < x_count; ++value_index)
 			{
@@ -1032,7 +1195,16 @@ EidosValue_SP UniqueEidosValue(const EidosValue *p_x_value, bool p_force_new_vec
 		EidosValue_Object_vector *object_result = new (gEidosValuePool->AllocateChunk()) EidosValue_Object_vector(((EidosValue_Object *)x_value)->Class());
 		result_SP = EidosValue_SP(object_result);
 		
-		if (p_preserve_order)
+		if (p_preserve_order && (x_count >= EIDOS_HASHED_UNIQUE_THRESHOLD))
+		{
+			std::vector<int> unique_indices;
+			
+			Eidos_HashedUniqueIndices(object_data, x_count, (EidosObject * const *)nullptr, 0, unique_indices);
+			
+			for (int unique_index : unique_indices)
+				object_result->push_object_element_CRR(object_data[unique_index]);
+		}
+		else if (p_preserve_order)
 		{
 			for (int value_index = 0; value_index < x_count; ++value_index)
 			{
@@ -2652,6 +2824,24 @@ EidosValue_SP Eidos_ExecuteFunction_setDifference(const std::vector<EidosValue_S
 				}
 		}
 	}
+	else if (Eidos_UseHashedSetOperation(x_count, y_count))
+	{
+		// Both arguments have size >1, and are large enough that hashing beats scanning
+		std::vector<int> result_indices;
+		
+		result_SP = x_value->NewMatchingType();
+		
+		if (arg_type == EidosValueType::kValueInt)
+			Eidos_HashedUniqueIndices(x_value->IntVector()->data(), x_count, y_value->IntVector()->data(), y_count, result_indices);
+		else if (arg_type == EidosValueType::kValueFloat)
+			Eidos_HashedUniqueIndices(x_value->FloatVector()->data(), x_count, y_value->FloatVector()->data(), y_count, result_indices);
+		else if (arg_type == EidosValueType::kValueString)
+			Eidos_HashedUniqueIndices(x_value->StringVector()->data(), x_count, y_value->StringVector()->data(), y_count, result_indices);
+		else if (arg_type == EidosValueType::kValueObject)
+			Eidos_HashedUniqueIndices(x_value->ObjectElementVector()->data(), x_count, y_value->ObjectElementVector()->data(), y_count, result_indices);
+		
+		Eidos_AppendElementsAtIndices(result_SP.get(), x_value, result_indices);
+	}
 	else
 	{
 		// Both arguments have size >1, so we can use fast APIs for both
@@ -3010,6 +3200,24 @@ EidosValue_SP Eidos_ExecuteFunction_setIntersection(const std::vector<EidosValue
 		else
 			result_SP = x_value->NewMatchingType();
 	}
+	else if (Eidos_UseHashedSetOperation(x_count, y_count))
+	{
+		// Both arguments have size >1, and are large enough that hashing beats scanning
+		std::vector<int> result_indices;
+		
+		result_SP = x_value->NewMatchingType();
+		
+		if (arg_type == EidosValueType::kValueInt)
+			Eidos_HashedIntersectionIndices(x_value->IntVector()->data(), x_count, y_value->IntVector()->data(), y_count, result_indices);
+		else if (arg_type == EidosValueType::kValueFloat)
+			Eidos_HashedIntersectionIndices(x_value->FloatVector()->data(), x_count, y_value->FloatVector()->data(), y_count, result_indices);
+		else if (arg_type == EidosValueType::kValueString)
+			Eidos_HashedIntersectionIndices(x_value->StringVector()->data(), x_count, y_value->StringVector()->data(), y_count, result_indices);
+		else if (arg_type == EidosValueType::kValueObject)
+			Eidos_HashedIntersectionIndices(x_value->ObjectElementVector()->data(), x_count, y_value->ObjectElementVector()->data(), y_count, result_indices);
+		
+		Eidos_AppendElementsAtIndices(result_SP.get(), x_value, result_indices);
+	}
 	else
 	{
 		// Both arguments have size >1, so we can use fast APIs for both
@@ -3392,6 +3600,38 @@ EidosValue_SP Eidos_ExecuteFunction_setSymmetricDifference(const std::vector<Eid
 				object_element_vec->erase_index(value_index);
 		}
 	}
+	else if (Eidos_UseHashedSetOperation(x_count, y_count))
+	{
+		// Both arguments have size >1, and are large enough that hashing beats scanning; as below, we take
+		// the unique values of x not in y, then the unique values of y not in x
+		std::vector<int> result_indices0, result_indices1;
+		
+		result_SP = x_value->NewMatchingType();
+		
+		if (arg_type == EidosValueType::kValueInt)
+		{
+			Eidos_HashedUniqueIndices(x_value->IntVector()->data(), x_count, y_value->IntVector()->data(), y_count, result_indices0);
+			Eidos_HashedUniqueIndices(y_value->IntVector()->data(), y_count, x_value->IntVector()->data(), x_count, result_indices1);
+		}
+		else if (arg_type == EidosValueType::kValueFloat)
+		{
+			Eidos_HashedUniqueIndices(x_value->FloatVector()->data(), x_count, y_value->FloatVector()->data(), y_count, result_indices0);
+			Eidos_HashedUniqueIndices(y_value->FloatVector()->data(), y_count, x_value->FloatVector()->data(), x_count, result_indices1);
+		}
+		else if (arg_type == EidosValueType::kValueString)
+		{
+			Eidos_HashedUniqueIndices(x_value->StringVector()->data(), x_count, y_value->StringVector()->data(), y_count, result_indices0);
+			Eidos_HashedUniqueIndices(y_value->StringVector()->data(), y_count, x_value->StringVector()->data(), x_count, result_indices1);
+		}
+		else if (arg_type == EidosValueType::kValueObject)
+		{
+			Eidos_HashedUniqueIndices(x_value->ObjectElementVector()->data(), x_count, y_value->ObjectElementVector()->data(), y_count, result_indices0);
+			Eidos_HashedUniqueIndices(y_value->ObjectElementVector()->data(), y_count, x_value->ObjectElementVector()->data(), x_count, result_indices1);
+		}
+		
+		Eidos_AppendElementsAtIndices(result_SP.get(), x_value, result_indices0);
+		Eidos_AppendElementsAtIndices(result_SP.get(), y_value, result_indices1);
+	}
 	else
 	{
 		// Both arguments have size >1, so we can use fast APIs for both.  Loop through x adding
@@ -3858,8 +4098,8 @@ EidosValue_SP Eidos_ExecuteFunction_setUnion(const std::vector<EidosValue_SP> &p
 	{
 		// We have two arguments which are both vectors of >1 value, so this is the base case.  We construct
 		// a new EidosValue containing all elements from both arguments, and then call UniqueEidosValue() to unique it.
-		// This code might look slow, but really the uniquing is O(N^2) and everything else is O(N), so since
-		// we are in the vector/vector case here, it really isn't worth worrying about optimizing the O(N) part.
+		// This code might look slow, but the uniquing dominates (it is O(N^2) for small vectors, and hashed for
+		// large vectors), so it really isn't worth worrying about optimizing the O(N) concatenation.
 		result_SP = ConcatenateEidosValues(p_arguments, false, false);	// no NULL, no VOID
 		result_SP = UniqueEidosValue(result_SP.get(), false, true);
 	}
@@ -8732,8 +8972,12 @@ EidosValue_SP Eidos_ExecuteFunction_order(const std::vector<EidosValue_SP> &p_ar
 		
 		if (x_type == EidosValueType::kValueLogical)
 			order = EidosSortIndexes(x_value->LogicalVector()->data(), x_count, ascending);
+		else if ((x_type == EidosValueType::kValueInt) && (x_count >= EIDOS_RADIX_SORT_THRESHOLD))
+			order = Eidos_RadixSortIndexes(x_value->IntVector()->data(), x_count, ascending);
 		else if (x_type == EidosValueType::kValueInt)
 			order = EidosSortIndexes(x_value->IntVector()->data(), x_count, ascending);
+		else if ((x_type == EidosValueType::kValueFloat) && (x_count >= EIDOS_RADIX_SORT_THRESHOLD))
+			order = Eidos_RadixSortIndexes(x_value->FloatVector()->data(), x_count, ascending);
 		else if (x_type == EidosValueType::kValueFloat)
 			order = EidosSortIndexes(x_value->FloatVector()->data(), x_count, ascending);
 		else if (x_type == EidosValueType::kValueString)
@@ -8887,13 +9131,35 @@ EidosValue_SP Eidos_ExecuteFunction_sort(const std::vector<EidosValue_SP> &p_arg
 	EidosValue *x_value = p_arguments[0].get();
 	int x_count = x_value->Count();
 	
-	result_SP = x_value->NewMatchingType();
-	EidosValue *result = result_SP.get();
+	EidosValueType x_type = x_value->Type();
 	
-	for (int value_index = 0; value_index < x_count; ++value_index)
-		result->PushValueFromIndexOfEidosValue(value_index, *x_value, nullptr);
+	if ((x_count > 1) && (x_type == EidosValueType::kValueInt))
+	{
+		// copy the data directly, rather than pushing values one at a time; for large vectors this is a real cost
+		const int64_t *int_data = x_value->IntVector()->data();
+		EidosValue_Int_vector *int_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector())->resize_no_initialize(x_count);
+		result_SP = EidosValue_SP(int_result);
+		
+		memcpy(int_result->data(), int_data, x_count * sizeof(int64_t));
+	}
+	else if ((x_count > 1) && (x_type == EidosValueType::kValueFloat))
+	{
+		const double *float_data = x_value->FloatVector()->data();
+		EidosValue_Float_vector *float_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(x_count);
+		result_SP = EidosValue_SP(float_result);
+		
+		memcpy(float_result->data(), float_data, x_count * sizeof(double));
+	}
+	else
+	{
+		result_SP = x_value->NewMatchingType();
+		EidosValue *result = result_SP.get();
+		
+		for (int value_index = 0; value_index < x_count; ++value_index)
+			result->PushValueFromIndexOfEidosValue(value_index, *x_value, nullptr);
+	}
 	
-	result->Sort(p_arguments[1]->LogicalAtIndex(0, nullptr));
+	result_SP->Sort(p_arguments[1]->LogicalAtIndex(0, nullptr));
 	
 	return result_SP;
 }
@@ -10019,6 +10285,213 @@ EidosValue_SP Eidos_ExecuteFunction_substr(const std::vector<EidosValue_SP> &p_a
 #pragma mark Matrix and array functions
 #pragma mark -
 
+// Matrix kernels used by matrixMult(), t(), cbind() and rbind().  Eidos matrices are column-major, as in R.  These work
+// directly on the underlying buffers of logical, integer, and float values; string and object values still go through the
+// general EidosValue API, since their elements need copying or retain/release anyway.  Singletons are handled by callers.
+#define EIDOS_MATMULT_BLOCK_ROWS	256		// rows of x (and the result) per block; these are guesses based on timing data, and
+#define EIDOS_MATMULT_BLOCK_INNER	128		// keep a 256 x 128 block of x (256 KB of doubles) resident in L2 while sweeping y
+#define EIDOS_TRANSPOSE_BLOCK		32		// a 32 x 32 tile of either layout fits comfortably in L1
+
+// The result of a float matrix multiply, x (n x m) * y (m x p), accumulated into a zeroed result (n x p).  The loops run over
+// blocks of rows of x and blocks of the inner dimension, so that each block of x stays in cache while it is applied to every
+// column of y; the innermost loop runs down a column of x and of the result, which is contiguous and auto-vectorizes.  Each
+// result element still accumulates its products in increasing order of the inner index, starting from 0.0, exactly as the
+// naive triple loop did, so results are bit-identical to it.
+static void Eidos_MatrixMult_Float(const double * __restrict__ p_x, const double * __restrict__ p_y, double * __restrict__ p_result, int64_t p_x_rows, int64_t p_x_cols, int64_t p_y_cols)
+{
+	std::fill(p_result, p_result + p_x_rows * p_y_cols, 0.0);
+	
+	for (int64_t row_block_start = 0; row_block_start < p_x_rows; row_block_start += EIDOS_MATMULT_BLOCK_ROWS)
+	{
+		int64_t block_rows = std::min<int64_t>(EIDOS_MATMULT_BLOCK_ROWS, p_x_rows - row_block_start);
+		
+		for (int64_t inner_block_start = 0; inner_block_start < p_x_cols; inner_block_start += EIDOS_MATMULT_BLOCK_INNER)
+		{
+			int64_t inner_block_end = std::min<int64_t>(inner_block_start + EIDOS_MATMULT_BLOCK_INNER, p_x_cols);
+			
+			for (int64_t result_col = 0; result_col < p_y_cols; ++result_col)
+			{
+				double * __restrict__ result_col_data = p_result + result_col * p_x_rows + row_block_start;
+				const double *y_col_data = p_y + result_col * p_x_cols;		// x_cols == y_rows
+				int64_t inner = inner_block_start;
+				
+				// four columns of x at a time, to cut loads and stores of the result column; the additions stay in order
+				for ( ; inner + 4 <= inner_block_end; inner += 4)
+				{
+					const double * __restrict__ x_col0 = p_x + inner * p_x_rows + row_block_start;
+					const double * __restrict__ x_col1 = x_col0 + p_x_rows;
+					const double * __restrict__ x_col2 = x_col1 + p_x_rows;
+					const double * __restrict__ x_col3 = x_col2 + p_x_rows;
+					double y0 = y_col_data[inner], y1 = y_col_data[inner + 1], y2 = y_col_data[inner + 2], y3 = y_col_data[inner + 3];
+					
+					for (int64_t row = 0; row < block_rows; ++row)
+					{
+						double sum = result_col_data[row];
+						
+						sum += x_col0[row] * y0;
+						sum += x_col1[row] * y1;
+						sum += x_col2[row] * y2;
+						sum += x_col3[row] * y3;
+						result_col_data[row] = sum;
+					}
+				}
+				
+				for ( ; inner < inner_block_end; ++inner)
+				{
+					const double * __restrict__ x_col = p_x + inner * p_x_rows + row_block_start;
+					double y_operand = y_col_data[inner];
+					
+					for (int64_t row = 0; row < block_rows; ++row)
+						result_col_data[row] += x_col[row] * y_operand;
+				}
+			}
+		}
+	}
+}
+
+// The integer version of Eidos_MatrixMult_Float(), with the same blocking and summation order.  Overflow checks prevent
+// vectorization, but the blocking still avoids streaming all of x through the cache once for every column of y.
+static void Eidos_MatrixMult_Int(const int64_t *p_x, const int64_t *p_y, int64_t *p_result, int64_t p_x_rows, int64_t p_x_cols, int64_t p_y_cols)
+{
+	std::fill(p_result, p_result + p_x_rows * p_y_cols, (int64_t)0);
+	
+	for (int64_t row_block_start = 0; row_block_start < p_x_rows; row_block_start += EIDOS_MATMULT_BLOCK_ROWS)
+	{
+		int64_t block_rows = std::min<int64_t>(EIDOS_MATMULT_BLOCK_ROWS, p_x_rows - row_block_start);
+		
+		for (int64_t inner_block_start = 0; inner_block_start < p_x_cols; inner_block_start += EIDOS_MATMULT_BLOCK_INNER)
+		{
+			int64_t inner_block_end = std::min<int64_t>(inner_block_start + EIDOS_MATMULT_BLOCK_INNER, p_x_cols);
+			
+			for (int64_t result_col = 0; result_col < p_y_cols; ++result_col)
+			{
+				int64_t *result_col_data = p_result + result_col * p_x_rows + row_block_start;
+				const int64_t *y_col_data = p_y + result_col * p_x_cols;		// x_cols == y_rows
+				
+				for (int64_t inner = inner_block_start; inner < inner_block_end; ++inner)
+				{
+					const int64_t *x_col = p_x + inner * p_x_rows + row_block_start;
+					int64_t y_operand = y_col_data[inner];
+					
+					for (int64_t row = 0; row < block_rows; ++row)
+					{
+						int64_t multiply_result;
+						bool overflow = Eidos_mul_overflow(x_col[row], y_operand, &multiply_result);
+						
+						if (overflow)
+							EIDOS_TERMINATION << "ERROR (Eidos_ExecuteFunction_matrixMult): integer multiplication overflow in function matrixMult(); you may wish to cast the matrices to float with asFloat() before multiplying." << EidosTerminate(nullptr);
+						
+						int64_t add_result;
+						bool overflow2 = Eidos_add_overflow(result_col_data[row], multiply_result, &add_result);
+						
+						if (overflow2)
+							EIDOS_TERMINATION << "ERROR (Eidos_ExecuteFunction_matrixMult): integer addition overflow in function matrixMult(); you may wish to cast the matrices to float with asFloat() before multiplying." << EidosTerminate(nullptr);
+						
+						result_col_data[row] = add_result;
+					}
+				}
+			}
+		}
+	}
+}
+
+// Transposes a column-major p_source_rows x p_source_cols matrix into p_dest, in square tiles so that both the reads and the
+// writes stay within a few cache lines at a time
+template <typename T>
+static void Eidos_MatrixTranspose(const T * __restrict__ p_source, T * __restrict__ p_dest, int64_t p_source_rows, int64_t p_source_cols)
+{
+	for (int64_t col_block_start = 0; col_block_start < p_source_cols; col_block_start += EIDOS_TRANSPOSE_BLOCK)
+	{
+		int64_t col_block_end = std::min<int64_t>(col_block_start + EIDOS_TRANSPOSE_BLOCK, p_source_cols);
+		
+		for (int64_t row_block_start = 0; row_block_start < p_source_rows; row_block_start += EIDOS_TRANSPOSE_BLOCK)
+		{
+			int64_t row_block_end = std::min<int64_t>(row_block_start + EIDOS_TRANSPOSE_BLOCK, p_source_rows);
+			
+			for (int64_t source_col = col_block_start; source_col < col_block_end; ++source_col)
+				for (int64_t source_row = row_block_start; source_row < row_block_end; ++source_row)
+					p_dest[source_row * p_source_cols + source_col] = p_source[source_col * p_source_rows + source_row];
+		}
+	}
+}
+
+// Returns the element buffer of a logical, integer, or float value; a singleton's value is copied into p_singleton_buffer
+static inline const eidos_logical_t *Eidos_MatrixElementData(const EidosValue *p_value, __attribute__((unused)) eidos_logical_t *p_singleton_buffer)
+{
+	return p_value->LogicalVector()->data();		// logical values are never singletons
+}
+
+static inline const int64_t *Eidos_MatrixElementData(const EidosValue *p_value, int64_t *p_singleton_buffer)
+{
+	if (p_value->Count() == 1)
+	{
+		*p_singleton_buffer = p_value->IntAtIndex(0, nullptr);
+		return p_singleton_buffer;
+	}
+	
+	return p_value->IntVector()->data();
+}
+
+static inline const double *Eidos_MatrixElementData(const EidosValue *p_value, double *p_singleton_buffer)
+{
+	if (p_value->Count() == 1)
+	{
+		*p_singleton_buffer = p_value->FloatAtIndex(0, nullptr);
+		return p_singleton_buffer;
+	}
+	
+	return p_value->FloatVector()->data();
+}
+
+// The element copying for cbind(); the arguments are simply concatenated, since the result is column-major
+template <typename T>
+static void Eidos_MatrixBindColumns(const std::vector<EidosValue_SP> &p_arguments, T *p_result)
+{
+	for (const EidosValue_SP &arg_SP : p_arguments)
+	{
+		const EidosValue *arg = arg_SP.get();
+		int64_t arg_length = arg->Count();
+		
+		// skip over zero-length arguments, including NULL
+		if (arg_length == 0)
+			continue;
+		
+		T singleton_buffer;
+		const T *arg_data = Eidos_MatrixElementData(arg, &singleton_buffer);
+		
+		memcpy(p_result, arg_data, arg_length * sizeof(T));
+		p_result += arg_length;
+	}
+}
+
+// The element copying for rbind(); each column of the result is the corresponding column of each argument in turn, with a
+// vector argument treated as a single row
+template <typename T>
+static void Eidos_MatrixBindRows(const std::vector<EidosValue_SP> &p_arguments, T *p_result, int64_t p_result_rows, int64_t p_result_cols)
+{
+	int64_t result_row_offset = 0;
+	
+	for (const EidosValue_SP &arg_SP : p_arguments)
+	{
+		const EidosValue *arg = arg_SP.get();
+		int64_t arg_length = arg->Count();
+		
+		// skip over zero-length arguments, including NULL
+		if (arg_length == 0)
+			continue;
+		
+		T singleton_buffer;
+		const T *arg_data = Eidos_MatrixElementData(arg, &singleton_buffer);
+		int64_t arg_nrow = (arg->DimensionCount() == 1) ? 1 : arg->Dimensions()[0];
+		
+		for (int64_t col_index = 0; col_index < p_result_cols; ++col_index)
+			memcpy(p_result + col_index * p_result_rows + result_row_offset, arg_data + col_index * arg_nrow, arg_nrow * sizeof(T));
+		
+		result_row_offset += arg_nrow;
+	}
+}
+
+
 
 //	(*)apply(* x, integer margin, string$ lambdaSource)
 EidosValue_SP Eidos_ExecuteFunction_apply(const std::vector<EidosValue_SP> &p_arguments, EidosInterpreter &p_interpreter)
@@ -10372,26 +10845,47 @@ EidosValue_SP Eidos_ExecuteFunction_cbind(const std::vector<EidosValue_SP> &p_ar
 	{
 		case EidosValueType::kValueVOID:	break;		// never hit
 		case EidosValueType::kValueNULL:	break;		// never hit
-		case EidosValueType::kValueLogical:	result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Logical())->reserve(result_length)); break;
-		case EidosValueType::kValueInt:		result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector())->reserve(result_length)); break;
-		case EidosValueType::kValueFloat:	result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->reserve(result_length)); break;
+		case EidosValueType::kValueLogical:
+		{
+			EidosValue_Logical *logical_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Logical())->resize_no_initialize(result_length);
+			result_SP = EidosValue_SP(logical_result);
+			Eidos_MatrixBindColumns(p_arguments, logical_result->data());
+			break;
+		}
+		case EidosValueType::kValueInt:
+		{
+			EidosValue_Int_vector *int_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector())->resize_no_initialize(result_length);
+			result_SP = EidosValue_SP(int_result);
+			Eidos_MatrixBindColumns(p_arguments, int_result->data());
+			break;
+		}
+		case EidosValueType::kValueFloat:
+		{
+			EidosValue_Float_vector *float_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(result_length);
+			result_SP = EidosValue_SP(float_result);
+			Eidos_MatrixBindColumns(p_arguments, float_result->data());
+			break;
+		}
 		case EidosValueType::kValueString:	result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_String_vector()); break;
 		case EidosValueType::kValueObject:	result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Object_vector(result_class))->reserve(result_length)); break;
 	}
 	
 	EidosValue *result = result_SP.get();
 	
-	for (int arg_index = 0; arg_index < argument_count; ++arg_index)
+	if ((result_type == EidosValueType::kValueString) || (result_type == EidosValueType::kValueObject))
 	{
-		EidosValue *arg = p_arguments[arg_index].get();
-		int64_t arg_length = arg->Count();
-		
-		// skip over zero-length arguments, including NULL; zero-length vectors must match in type (above) but are otherwise ignored
-		if (arg_length == 0)
-			continue;
-		
-		for (int element_index = 0; element_index < arg_length; ++element_index)
-			result->PushValueFromIndexOfEidosValue(element_index, *arg, nullptr);
+		for (int arg_index = 0; arg_index < argument_count; ++arg_index)
+		{
+			EidosValue *arg = p_arguments[arg_index].get();
+			int64_t arg_length = arg->Count();
+			
+			// skip over zero-length arguments, including NULL; zero-length vectors must match in type (above) but are otherwise ignored
+			if (arg_length == 0)
+				continue;
+			
+			for (int element_index = 0; element_index < arg_length; ++element_index)
+				result->PushValueFromIndexOfEidosValue(element_index, *arg, nullptr);
+		}
 	}
 	
 	const int64_t dim_buf[2] = {result_rows, result_cols};
@@ -10703,78 +11197,17 @@ EidosValue_SP Eidos_ExecuteFunction_matrixMult(const std::vector<EidosValue_SP>
 		// this is the general case; we have non-singleton matrices for both x and y, so we can divide by integer/float and use direct access
 		if (x_type == EidosValueType::kValueInt)
 		{
-			const int64_t *x_data = x_value->IntVector()->data();
-			const int64_t *y_data = y_value->IntVector()->data();
 			EidosValue_Int_vector *result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector())->resize_no_initialize(result_length);
 			result_SP = EidosValue_SP(result);
 			
-			for (int64_t result_col_index = 0; result_col_index < result_cols; ++result_col_index)
-			{
-				for (int64_t result_row_index = 0; result_row_index < result_rows; ++result_row_index)
-				{
-					int64_t result_index = result_col_index * result_rows + result_row_index;
-					int64_t summation_result = 0;
-					
-					for (int64_t product_index = 0; product_index < x_cols; ++product_index)	// x_cols == y_rows; this is the dimension that matches, n x m * m x p
-					{
-						int64_t x_row = result_row_index;
-						int64_t x_col = product_index;
-						int64_t x_index = x_col * x_rows + x_row;
-						int64_t y_row = product_index;
-						int64_t y_col = result_col_index;
-						int64_t y_index = y_col * y_rows + y_row;
-						int64_t x_operand = x_data[x_index];
-						int64_t y_operand = y_data[y_index];
-						int64_t multiply_result;
-						bool overflow = Eidos_mul_overflow(x_operand, y_operand, &multiply_result);
-						
-						if (overflow)
-							EIDOS_TERMINATION << "ERROR (Eidos_ExecuteFunction_matrixMult): integer multiplication overflow in function matrixMult(); you may wish to cast the matrices to float with asFloat() before multiplying." << EidosTerminate(nullptr);
-						
-						int64_t add_result;
-						bool overflow2 = Eidos_add_overflow(summation_result, multiply_result, &add_result);
-						
-						if (overflow2)
-							EIDOS_TERMINATION << "ERROR (Eidos_ExecuteFunction_matrixMult): integer addition overflow in function matrixMult(); you may wish to cast the matrices to float with asFloat() before multiplying." << EidosTerminate(nullptr);
-						
-						summation_result = add_result;
-					}
-					
-					result->set_int_no_check(summation_result, result_index);
-				}
-			}
+			Eidos_MatrixMult_Int(x_value->IntVector()->data(), y_value->IntVector()->data(), result->data(), x_rows, x_cols, y_cols);
 		}
 		else // (x_type == EidosValueType::kValueFloat)
 		{
-			const double *x_data = x_value->FloatVector()->data();
-			const double *y_data = y_value->FloatVector()->data();
 			EidosValue_Float_vector *result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(result_length);
 			result_SP = EidosValue_SP(result);
 			
-			for (int64_t result_col_index = 0; result_col_index < result_cols; ++result_col_index)
-			{
-				for (int64_t result_row_index = 0; result_row_index < result_rows; ++result_row_index)
-				{
-					int64_t result_index = result_col_index * result_rows + result_row_index;
-					double summation_result = 0;
-					
-					for (int64_t product_index = 0; product_index < x_cols; ++product_index)	// x_cols == y_rows; this is the dimension that matches, n x m * m x p
-					{
-						int64_t x_row = result_row_index;
-						int64_t x_col = product_index;
-						int64_t x_index = x_col * x_rows + x_row;
-						int64_t y_row = product_index;
-						int64_t y_col = result_col_index;
-						int64_t y_index = y_col * y_rows + y_row;
-						double x_operand = x_data[x_index];
-						double y_operand = y_data[y_index];
-						
-						summation_result += x_operand * y_operand;
-					}
-					
-					result->set_float_no_check(summation_result, result_index);
-				}
-			}
+			Eidos_MatrixMult_Float(x_value->FloatVector()->data(), y_value->FloatVector()->data(), result->data(), x_rows, x_cols, y_cols);
 		}
 	}
 	
@@ -10883,48 +11316,70 @@ EidosValue_SP Eidos_ExecuteFunction_rbind(const std::vector<EidosValue_SP> &p_ar
 		result_length += arg_length;
 	}
 	
-	// Construct our result; for each column, we scan through our arguments and append rows from that column; not very efficient, but general...
+	// Construct our result; for logical, integer, and float we copy column segments of each argument straight into place.
+	// Otherwise, for each column, we scan through our arguments and append rows from that column; not very efficient, but general...
 	EidosValue_SP result_SP(nullptr);
 	
 	switch (result_type)
 	{
 		case EidosValueType::kValueVOID:	break;		// never hit
 		case EidosValueType::kValueNULL:	break;		// never hit
-		case EidosValueType::kValueLogical:	result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Logical())->reserve(result_length)); break;
-		case EidosValueType::kValueInt:		result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector())->reserve(result_length)); break;
-		case EidosValueType::kValueFloat:	result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->reserve(result_length)); break;
+		case EidosValueType::kValueLogical:
+		{
+			EidosValue_Logical *logical_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Logical())->resize_no_initialize(result_length);
+			result_SP = EidosValue_SP(logical_result);
+			Eidos_MatrixBindRows(p_arguments, logical_result->data(), result_rows, result_cols);
+			break;
+		}
+		case EidosValueType::kValueInt:
+		{
+			EidosValue_Int_vector *int_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector())->resize_no_initialize(result_length);
+			result_SP = EidosValue_SP(int_result);
+			Eidos_MatrixBindRows(p_arguments, int_result->data(), result_rows, result_cols);
+			break;
+		}
+		case EidosValueType::kValueFloat:
+		{
+			EidosValue_Float_vector *float_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(result_length);
+			result_SP = EidosValue_SP(float_result);
+			Eidos_MatrixBindRows(p_arguments, float_result->data(), result_rows, result_cols);
+			break;
+		}
 		case EidosValueType::kValueString:	result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_String_vector()); break;
 		case EidosValueType::kValueObject:	result_SP = EidosValue_SP((new (gEidosValuePool->AllocateChunk()) EidosValue_Object_vector(result_class))->reserve(result_length)); break;
 	}
 	
 	EidosValue *result = result_SP.get();
 	
-	for (int col_index = 0; col_index < result_cols; ++col_index)
+	if ((result_type == EidosValueType::kValueString) || (result_type == EidosValueType::kValueObject))
 	{
-		for (int arg_index = 0; arg_index < argument_count; ++arg_index)
+		for (int col_index = 0; col_index < result_cols; ++col_index)
 		{
-			EidosValue *arg = p_arguments[arg_index].get();
-			int64_t arg_length = arg->Count();
-			
-			// skip over zero-length arguments, including NULL; zero-length vectors must match in type (above) but are otherwise ignored
-			if (arg_length == 0)
-				continue;
-			
-			int arg_dimcount = arg->DimensionCount();
-			
-			if (arg_dimcount == 1)
+			for (int arg_index = 0; arg_index < argument_count; ++arg_index)
 			{
-				// vector; take the nth value to fill the nth column in the result
-				result->PushValueFromIndexOfEidosValue(col_index, *arg, nullptr);
-			}
-			else
-			{
-				// matrix; take the whole nth column of the matrix to fill the nth column in the result
-				const int64_t *arg_dims = arg->Dimensions();
-				int64_t arg_nrow = arg_dims[0];
+				EidosValue *arg = p_arguments[arg_index].get();
+				int64_t arg_length = arg->Count();
+				
+				// skip over zero-length arguments, including NULL; zero-length vectors must match in type (above) but are otherwise ignored
+				if (arg_length == 0)
+					continue;
+				
+				int arg_dimcount = arg->DimensionCount();
 				
-				for (int64_t row_index = 0; row_index < arg_nrow; ++row_index)
-					result->PushValueFromIndexOfEidosValue((int)(col_index * arg_nrow + row_index), *arg, nullptr);
+				if (arg_dimcount == 1)
+				{
+					// vector; take the nth value to fill the nth column in the result
+					result->PushValueFromIndexOfEidosValue(col_index, *arg, nullptr);
+				}
+				else
+				{
+					// matrix; take the whole nth column of the matrix to fill the nth column in the result
+					const int64_t *arg_dims = arg->Dimensions();
+					int64_t arg_nrow = arg_dims[0];
+					
+					for (int64_t row_index = 0; row_index < arg_nrow; ++row_index)
+						result->PushValueFromIndexOfEidosValue((int)(col_index * arg_nrow + row_index), *arg, nullptr);
+				}
 			}
 		}
 	}
@@ -10951,23 +11406,55 @@ EidosValue_SP Eidos_ExecuteFunction_t(const std::vector<EidosValue_SP> &p_argume
 	int64_t dest_rows = source_cols;
 	int64_t dest_cols = source_rows;
 	
-	result_SP = x_value->NewMatchingType();
-	EidosValue *result = result_SP.get();
+	int64_t length = source_rows * source_cols;
+	EidosValueType x_type = x_value->Type();
 	
-	for (int64_t col_index = 0; col_index < dest_cols; ++col_index)
+	if (length <= 1)
+	{
+		// a 1x1 matrix is its own transpose
+		result_SP = x_value->CopyValues();
+	}
+	else if (x_type == EidosValueType::kValueLogical)
 	{
-		for (int64_t row_index = 0; row_index < dest_rows; ++row_index)
+		EidosValue_Logical *logical_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Logical())->resize_no_initialize(length);
+		result_SP = EidosValue_SP(logical_result);
+		
+		Eidos_MatrixTranspose(x_value->LogicalVector()->data(), logical_result->data(), source_rows, source_cols);
+	}
+	else if (x_type == EidosValueType::kValueInt)
+	{
+		EidosValue_Int_vector *int_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector())->resize_no_initialize(length);
+		result_SP = EidosValue_SP(int_result);
+		
+		Eidos_MatrixTranspose(x_value->IntVector()->data(), int_result->data(), source_rows, source_cols);
+	}
+	else if (x_type == EidosValueType::kValueFloat)
+	{
+		EidosValue_Float_vector *float_result = (new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector())->resize_no_initialize(length);
+		result_SP = EidosValue_SP(float_result);
+		
+		Eidos_MatrixTranspose(x_value->FloatVector()->data(), float_result->data(), source_rows, source_cols);
+	}
+	else
+	{
+		result_SP = x_value->NewMatchingType();
+		EidosValue *result = result_SP.get();
+		
+		for (int64_t col_index = 0; col_index < dest_cols; ++col_index)
 		{
-			//int64_t dest_index = col_index * dest_rows + row_index;
-			int64_t source_index = row_index * source_rows + col_index;
-			
-			result->PushValueFromIndexOfEidosValue((int)source_index, *x_value, nullptr);
+			for (int64_t row_index = 0; row_index < dest_rows; ++row_index)
+			{
+				//int64_t dest_index = col_index * dest_rows + row_index;
+				int64_t source_index = row_index * source_rows + col_index;
+				
+				result->PushValueFromIndexOfEidosValue((int)source_index, *x_value, nullptr);
+			}
 		}
 	}
 	
 	const int64_t dim_buf[2] = {dest_rows, dest_cols};
 	
-	result->SetDimensions(2, dim_buf);
+	result_SP->SetDimensions(2, dim_buf);
 	
 	return result_SP;
 }
@@ -12575,12 +13062,81 @@ EidosValue_SP Eidos_ExecuteFunction_sapply(const std::vector<EidosValue_SP> &p_a
 		bool consistent_return_length = true;	// consistent except for any NULLs returned
 		int return_length = -1;					// what the consistent length is
 		
+		// If the lambda does not assign to applyValue (and does nothing unpredictable, like calling rm() or executeLambda()), we can
+		// use a single EidosValue for applyValue and stick new values into it, as Evaluate_For() does for its index variable, rather
+		// than allocating a new value for every element of x.  The lambda might return applyValue itself, though; see below.  The
+		// scan cannot see inside user-defined functions or defineGlobal(), so we keep our own reference to the reused value, and
+		// reuse it only while the symbol table still holds it and nothing else does; otherwise we fall back to a new value.
+		uint8_t references_apply_value = false, assigns_apply_value = false;
+		EidosValueType x_type = x_value->Type();
+		EidosValue_SP reused_apply_value;
+		const int64_t *x_int_data = nullptr;
+		const double *x_float_data = nullptr;
+		const std::vector<std::string> *x_string_vec = nullptr;
+		EidosObject * const *x_object_data = nullptr;
+		bool accumulating = true;				// integer or float singletons are being accumulated directly into a result vector
+		EidosValue_Int_vector_SP int_accumulator;
+		EidosValue_Float_vector_SP float_accumulator;
+		
+		script->AST()->_OptimizeForScan(gEidosStr_applyValue, &references_apply_value, &assigns_apply_value);
+		
+		if (!assigns_apply_value && (x_count > 1))
+		{
+			switch (x_type)
+			{
+				case EidosValueType::kValueInt:
+					x_int_data = x_value->IntVector()->data();
+					reused_apply_value = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Int_singleton(0));
+					break;
+				case EidosValueType::kValueFloat:
+					x_float_data = x_value->FloatVector()->data();
+					reused_apply_value = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(0));
+					break;
+				case EidosValueType::kValueString:
+					x_string_vec = x_value->StringVector();
+					reused_apply_value = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_String_singleton(gEidosStr_empty_string));
+					break;
+				case EidosValueType::kValueObject:
+					x_object_data = x_value->ObjectElementVector()->data();
+					reused_apply_value = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Object_singleton(nullptr, ((EidosValue_Object *)x_value)->Class()));
+					break;
+				default: break;		// logical values are shared static singletons anyway, so there is nothing to gain
+			}
+			
+			if (reused_apply_value)
+				symbols.SetValueForSymbolNoCopy(gEidosID_applyValue, EidosValue_SP(reused_apply_value));
+		}
+		
 		for (int value_index = 0; value_index < x_count; ++value_index)
 		{
-			EidosValue_SP apply_value = x_value->GetValueAtIndex(value_index, nullptr);
+			// Check that applyValue is still our reused value, referenced only by the symbol table and by us; if the previous
+			// iteration removed it, replaced it, or kept a reference to it elsewhere, we stop reusing it
+			if (reused_apply_value && (value_index > 0))
+			{
+				if ((reused_apply_value->UseCount() != 2) || !symbols.ContainsSymbol(gEidosID_applyValue) || (symbols.GetValueRawOrRaiseForSymbol(gEidosID_applyValue) != reused_apply_value.get()))
+					reused_apply_value.reset();
+			}
 			
 			// Set the iterator variable "applyValue" to the value
-			symbols.SetValueForSymbolNoCopy(gEidosID_applyValue, std::move(apply_value));
+			if (reused_apply_value)
+			{
+				EidosValue *apply_value = reused_apply_value.get();
+				
+				switch (x_type)
+				{
+					case EidosValueType::kValueInt:		((EidosValue_Int_singleton *)apply_value)->SetValue(x_int_data[value_index]); break;
+					case EidosValueType::kValueFloat:	((EidosValue_Float_singleton *)apply_value)->SetValue(x_float_data[value_index]); break;
+					case EidosValueType::kValueString:	((EidosValue_String_singleton *)apply_value)->SetValue((*x_string_vec)[value_index]); break;
+					case EidosValueType::kValueObject:	((EidosValue_Object_singleton *)apply_value)->SetValue(x_object_data[value_index]); break;
+					default: break;
+				}
+			}
+			else
+			{
+				EidosValue_SP apply_value = x_value->GetValueAtIndex(value_index, nullptr);
+				
+				symbols.SetValueForSymbolNoCopy(gEidosID_applyValue, std::move(apply_value));
+			}
 			
 			// Get the result.  BEWARE!  This calls causes re-entry into the Eidos interpreter, which is not usually
 			// possible since Eidos does not support multithreaded usage.  This is therefore a key failure point for
@@ -12590,28 +13146,72 @@ EidosValue_SP Eidos_ExecuteFunction_sapply(const std::vector<EidosValue_SP> &p_a
 			if (return_value_SP->Type() == EidosValueType::kValueVOID)
 				EIDOS_TERMINATION << "ERROR (Eidos_ExecuteFunction_sapply): each iteration within sapply() must return a non-void value." << EidosTerminate(nullptr);
 			
-			if (return_value_SP->Type() == EidosValueType::kValueNULL)
+			EidosValueType return_type = return_value_SP->Type();
+			int length = return_value_SP->Count();
+			
+			if (return_type == EidosValueType::kValueNULL)
 			{
 				null_included = true;
 			}
 			else if (consistent_return_length)
 			{
-				int length = return_value_SP->Count();
-				
 				if (return_length == -1)
 					return_length = length;
 				else if (length != return_length)
 					consistent_return_length = false;
 			}
 			
-			results.emplace_back(return_value_SP);
+			// Most lambdas return an integer or float singleton each time, so we accumulate those directly into a result vector;
+			// if anything else is returned, we put the accumulated vector into results and go on from there.  This produces the
+			// same concatenated result, since NULLs concatenate away and the accumulated values keep their place in the order.
+			if (accumulating)
+			{
+				if ((length == 1) && (return_type == EidosValueType::kValueInt) && !float_accumulator)
+				{
+					if (!int_accumulator)
+						int_accumulator = EidosValue_Int_vector_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Int_vector());
+					
+					int_accumulator->push_int(return_value_SP->IntAtIndex(0, nullptr));
+					continue;
+				}
+				else if ((length == 1) && (return_type == EidosValueType::kValueFloat) && !int_accumulator)
+				{
+					if (!float_accumulator)
+						float_accumulator = EidosValue_Float_vector_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_vector());
+					
+					float_accumulator->push_float(return_value_SP->FloatAtIndex(0, nullptr));
+					continue;
+				}
+				else if (return_type != EidosValueType::kValueNULL)
+				{
+					if (int_accumulator)
+						results.emplace_back(int_accumulator);
+					else if (float_accumulator)
+						results.emplace_back(float_accumulator);
+					
+					int_accumulator.reset();
+					float_accumulator.reset();
+					accumulating = false;
+				}
+			}
+			
+			// If the lambda returned our reused applyValue, we need to keep a copy of it, since we will change its value
+			if (reused_apply_value && (return_value_SP.get() == reused_apply_value.get()))
+				results.emplace_back(reused_apply_value->CopyValues());
+			else
+				results.emplace_back(return_value_SP);
 		}
 		
 		// We do not want a leftover applyValue symbol in the symbol table, so we remove it now
 		symbols.RemoveValueForSymbol(gEidosID_applyValue);
 		
 		// Assemble all the individual results together, just as c() does
-		result_SP = ConcatenateEidosValues(results, true, false);	// allow NULL but not VOID
+		if (int_accumulator)
+			result_SP = std::move(int_accumulator);
+		else if (float_accumulator)
+			result_SP = std::move(float_accumulator);
+		else
+			result_SP = ConcatenateEidosValues(results, true, false);	// allow NULL but not VOID
 		
 		// Finally, we restructure the results:
 		//
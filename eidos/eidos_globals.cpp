@@ -2310,6 +2310,215 @@ std::string Eidos_string_escaped_CSV(const std::string &unescapedString)
 	return result;
 }*/
 
+// Radix sorting.  Integer and float values are mapped to unsigned 64-bit keys whose unsigned order matches the
+// value order (with all NaNs mapped to the largest key, so they sort to the end), and the keys are then sorted
+// with an LSD radix sort, one byte per pass.  Passes in which every key has the same byte are skipped, which
+// makes sorting small non-negative integers (such as pedigree IDs) considerably faster than a full eight passes.
+static inline uint64_t Eidos_RadixKeyForInt(int64_t p_value)
+{
+	return (uint64_t)p_value ^ 0x8000000000000000ULL;
+}
+
+static inline int64_t Eidos_IntForRadixKey(uint64_t p_key)
+{
+	return (int64_t)(p_key ^ 0x8000000000000000ULL);
+}
+
+static inline uint64_t Eidos_RadixKeyForFloat(double p_value)
+{
+	if (std::isnan(p_value))
+		return UINT64_MAX;
+	
+	uint64_t bits;
+	
+	memcpy(&bits, &p_value, sizeof(bits));
+	
+	return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+static inline double Eidos_FloatForRadixKey(uint64_t p_key)
+{
+	uint64_t bits = (p_key & 0x8000000000000000ULL) ? (p_key & ~0x8000000000000000ULL) : ~p_key;
+	double value;
+	
+	memcpy(&value, &bits, sizeof(value));
+	
+	return value;
+}
+
+// Stable LSD radix sort of p_keys; if p_payload is non-null, it is permuted along with the keys
+static void Eidos_RadixSortKeys(uint64_t *p_keys, int64_t *p_payload, size_t p_count)
+{
+	if (p_count < 2)
+		return;
+	
+	// tally the digit counts for all eight passes in a single scan
+	std::vector<size_t> counts(8 * 256, 0);
+	size_t *counts_data = counts.data();
+	
+	for (size_t index = 0; index < p_count; ++index)
+	{
+		uint64_t key = p_keys[index];
+		
+		for (int pass = 0; pass < 8; ++pass)
+			counts_data[pass * 256 + ((key >> (pass * 8)) & 0xFF)]++;
+	}
+	
+	std::vector<uint64_t> key_buffer(p_count);
+	std::vector<int64_t> payload_buffer(p_payload ? p_count : 0);
+	uint64_t *key_src = p_keys, *key_dst = key_buffer.data();
+	int64_t *payload_src = p_payload, *payload_dst = payload_buffer.data();
+	
+	for (int pass = 0; pass < 8; ++pass)
+	{
+		size_t *pass_counts = counts_data + pass * 256;
+		int shift = pass * 8;
+		
+		// if every key has the same digit in this pass, the pass would not change the order
+		if (pass_counts[(key_src[0] >> shift) & 0xFF] == p_count)
+			continue;
+		
+		size_t offset = 0;
+		
+		for (int digit = 0; digit < 256; ++digit)
+		{
+			size_t digit_count = pass_counts[digit];
+			
+			pass_counts[digit] = offset;
+			offset += digit_count;
+		}
+		
+		if (payload_src)
+		{
+			for (size_t index = 0; index < p_count; ++index)
+			{
+				uint64_t key = key_src[index];
+				size_t dest = pass_counts[(key >> shift) & 0xFF]++;
+				
+				key_dst[dest] = key;
+				payload_dst[dest] = payload_src[index];
+			}
+			
+			std::swap(payload_src, payload_dst);
+		}
+		else
+		{
+			for (size_t index = 0; index < p_count; ++index)
+			{
+				uint64_t key = key_src[index];
+				
+				key_dst[pass_counts[(key >> shift) & 0xFF]++] = key;
+			}
+		}
+		
+		std::swap(key_src, key_dst);
+	}
+	
+	// after an odd number of executed passes the sorted data is in our buffers, so copy it back
+	if (key_src != p_keys)
+	{
+		memcpy(p_keys, key_src, p_count * sizeof(uint64_t));
+		
+		if (p_payload)
+			memcpy(p_payload, payload_src, p_count * sizeof(int64_t));
+	}
+}
+
+void Eidos_RadixSort(int64_t *p_data, size_t p_count, bool p_ascending)
+{
+	std::vector<uint64_t> keys(p_count);
+	uint64_t *keys_data = keys.data();
+	
+	for (size_t index = 0; index < p_count; ++index)
+		keys_data[index] = Eidos_RadixKeyForInt(p_data[index]);
+	
+	Eidos_RadixSortKeys(keys_data, nullptr, p_count);
+	
+	if (p_ascending)
+	{
+		for (size_t index = 0; index < p_count; ++index)
+			p_data[index] = Eidos_IntForRadixKey(keys_data[index]);
+	}
+	else
+	{
+		for (size_t index = 0; index < p_count; ++index)
+			p_data[p_count - 1 - index] = Eidos_IntForRadixKey(keys_data[index]);
+	}
+}
+
+void Eidos_RadixSort(double *p_data, size_t p_count, bool p_ascending)
+{
+	std::vector<uint64_t> keys(p_count);
+	uint64_t *keys_data = keys.data();
+	
+	for (size_t index = 0; index < p_count; ++index)
+		keys_data[index] = Eidos_RadixKeyForFloat(p_data[index]);
+	
+	Eidos_RadixSortKeys(keys_data, nullptr, p_count);
+	
+	// NaNs are at the end of the sorted keys; they stay at the end for a descending sort too
+	size_t nan_start = p_count;
+	
+	while ((nan_start > 0) && (keys_data[nan_start - 1] == UINT64_MAX))
+		--nan_start;
+	
+	if (p_ascending)
+	{
+		for (size_t index = 0; index < nan_start; ++index)
+			p_data[index] = Eidos_FloatForRadixKey(keys_data[index]);
+	}
+	else
+	{
+		for (size_t index = 0; index < nan_start; ++index)
+			p_data[nan_start - 1 - index] = Eidos_FloatForRadixKey(keys_data[index]);
+	}
+	
+	for (size_t index = nan_start; index < p_count; ++index)
+		p_data[index] = std::numeric_limits<double>::quiet_NaN();
+}
+
+std::vector<int64_t> Eidos_RadixSortIndexes(const int64_t *p_data, size_t p_count, bool p_ascending)
+{
+	std::vector<uint64_t> keys(p_count);
+	std::vector<int64_t> idx(p_count);
+	uint64_t *keys_data = keys.data();
+	
+	// a descending sort inverts the keys, so that tied values still keep their original order
+	for (size_t index = 0; index < p_count; ++index)
+	{
+		uint64_t key = Eidos_RadixKeyForInt(p_data[index]);
+		
+		keys_data[index] = (p_ascending ? key : ~key);
+	}
+	
+	std::iota(idx.begin(), idx.end(), 0);
+	Eidos_RadixSortKeys(keys_data, idx.data(), p_count);
+	
+	return idx;
+}
+
+std::vector<int64_t> Eidos_RadixSortIndexes(const double *p_data, size_t p_count, bool p_ascending)
+{
+	std::vector<uint64_t> keys(p_count);
+	std::vector<int64_t> idx(p_count);
+	uint64_t *keys_data = keys.data();
+	
+	// a descending sort inverts the keys of non-NaN values, so that NaNs still sort to the end; -0.0 and 0.0
+	// get the same key, since they compare equal, so that they are treated as ties
+	for (size_t index = 0; index < p_count; ++index)
+	{
+		double value = p_data[index];
+		uint64_t key = Eidos_RadixKeyForFloat((value == 0.0) ? 0.0 : value);
+		
+		keys_data[index] = ((p_ascending || (key == UINT64_MAX)) ? key : ~key);
+	}
+	
+	std::iota(idx.begin(), idx.end(), 0);
+	Eidos_RadixSortKeys(keys_data, idx.data(), p_count);
+	
+	return idx;
+}
+
 std::string EidosStringForFloat(double p_value)
 {
 	// Customize our output a bit to look like Eidos, not C++
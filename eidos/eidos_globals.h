@@ -58,6 +58,16 @@ class EidosToken;
 
 
 // These should be called once at startup to give Eidos an opportunity to initialize static state
+//
+// Note that Eidos is single-threaded by design, and only one interpreter may be running at a time in a given process.  The
+// state set up here is process-wide: the string registry (whose ids are baked into the ASTs, symbol tables, and signatures of
+// every interpreter), the EidosValue and AST node pools, the intrinsic constants table, the static EidosValues, and the class
+// objects.  Other state is process-wide but belongs to the running model: gEidos_RNG, gEidosSuppressWarnings, the error context
+// and gEidosTermination, and the Context's own globals (such as SLiM's pedigree and mutation id counters).  A Context that runs
+// several independent models in one process must swap that per-model state in before executing script and out afterwards, as
+// SLiMgui does in willExecuteScript() / didExecuteScript().  Evaluating script concurrently would require all of this state,
+// including the value pools and the refcounts of shared values, to be made per-thread or synchronized, which has been considered
+// and not done; work that needs to be parallel should be done in C++ below the interpreter, with Eidos_RNG_Stream for its draws.
 void Eidos_WarmUp(void);
 
 // This can be called at startup, after Eidos_WarmUp(), to define global constants from the command line
@@ -557,6 +567,16 @@ inline std::vector<int64_t> EidosSortIndexes<double>(const double *p_v, size_t p
 	return idx;
 }
 
+// Radix sorting of integer and float data, for large vectors; below EIDOS_RADIX_SORT_THRESHOLD elements std::sort is
+// faster.  Float NaNs sort to the end for both ascending and descending sorts, as with EidosSortIndexes() above.  Unlike
+// EidosSortIndexes(), Eidos_RadixSortIndexes() is stable: tied values keep their original relative order.
+#define EIDOS_RADIX_SORT_THRESHOLD	1000
+
+void Eidos_RadixSort(int64_t *p_data, size_t p_count, bool p_ascending);
+void Eidos_RadixSort(double *p_data, size_t p_count, bool p_ascending);
+std::vector<int64_t> Eidos_RadixSortIndexes(const int64_t *p_data, size_t p_count, bool p_ascending);
+std::vector<int64_t> Eidos_RadixSortIndexes(const double *p_data, size_t p_count, bool p_ascending);
+
 extern int gEidosFloatOutputPrecision;		// precision used for output of float values in Eidos; not user-visible at present
 
 std::string EidosStringForFloat(double p_value);
@@ -101,6 +101,158 @@ bool TypeCheckAssignmentOfEidosValueIntoEidosValue(const EidosValue &p_base_valu
 	return (dest_type > base_type);
 }
 
+// Scalar temporaries: an operand that nothing else refers to (a fresh result from a child node, as opposed to a value held by a symbol
+// table or cached in the AST) can be overwritten in place with an operator's result, so that a chain of scalar arithmetic like
+// "a * b + c * d" allocates one value rather than one value per node.  A use count of 1 means that only our own smart pointer refers
+// to the value; stack-allocated values are always retained by an extra count (see StackAllocated()), so they never qualify.
+static inline __attribute__((always_inline)) bool Eidos_IsReusableTemporary(const EidosValue_SP &p_value, EidosValueType p_type)
+{
+	const EidosValue *value = p_value.get();
+	
+	return ((value->UseCount() == 1) && (value->Type() == p_type) && value->IsSingleton() && !value->Invisible() && (value->DimensionCount() == 1));
+}
+
+static inline __attribute__((always_inline)) EidosValue_SP Eidos_FloatSingletonResult(EidosValue_SP &p_first_operand, EidosValue_SP &p_second_operand, double p_result)
+{
+	if (Eidos_IsReusableTemporary(p_first_operand, EidosValueType::kValueFloat))
+	{
+		static_cast<EidosValue_Float_singleton *>(p_first_operand.get())->SetValue(p_result);
+		return std::move(p_first_operand);
+	}
+	if (Eidos_IsReusableTemporary(p_second_operand, EidosValueType::kValueFloat))
+	{
+		static_cast<EidosValue_Float_singleton *>(p_second_operand.get())->SetValue(p_result);
+		return std::move(p_second_operand);
+	}
+	
+	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(p_result));
+}
+
+static inline __attribute__((always_inline)) EidosValue_SP Eidos_IntSingletonResult(EidosValue_SP &p_first_operand, EidosValue_SP &p_second_operand, int64_t p_result)
+{
+	if (Eidos_IsReusableTemporary(p_first_operand, EidosValueType::kValueInt))
+	{
+		static_cast<EidosValue_Int_singleton *>(p_first_operand.get())->SetValue(p_result);
+		return std::move(p_first_operand);
+	}
+	if (Eidos_IsReusableTemporary(p_second_operand, EidosValueType::kValueInt))
+	{
+		static_cast<EidosValue_Int_singleton *>(p_second_operand.get())->SetValue(p_result);
+		return std::move(p_second_operand);
+	}
+	
+	return EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Int_singleton(p_result));
+}
+
+
+// Vectorized comparison kernels: the comparison operators' general case dispatches on type per element through virtual accessors,
+// which is very slow for the common numeric cases.  Eidos_FastVectorCompare() handles int/int, float/float, and mixed int/float
+// operands (vector-vector, or with one singleton broadcast across the other operand) with tight loops over raw buffers, which the
+// compiler can auto-vectorize.  Mixed int/float operands are compared after promotion to float, exactly as FloatAtIndex() would
+// promote them, so the results are identical to the general case.  Eidos_FastVectorCompareApplies() says whether it can be used.
+struct Eidos_CompareEq { template <typename T> inline bool operator()(T p_a, T p_b) const { return (p_a == p_b); } };
+struct Eidos_CompareNotEq { template <typename T> inline bool operator()(T p_a, T p_b) const { return (p_a != p_b); } };
+struct Eidos_CompareLt { template <typename T> inline bool operator()(T p_a, T p_b) const { return (p_a < p_b); } };
+struct Eidos_CompareLtEq { template <typename T> inline bool operator()(T p_a, T p_b) const { return (p_a <= p_b); } };
+struct Eidos_CompareGt { template <typename T> inline bool operator()(T p_a, T p_b) const { return (p_a > p_b); } };
+struct Eidos_CompareGtEq { template <typename T> inline bool operator()(T p_a, T p_b) const { return (p_a >= p_b); } };
+
+template <typename PROMOTED, typename T1, typename T2, typename COMPARE>
+static void Eidos_CompareKernel_VV(const T1 * __restrict__ p_data1, const T2 * __restrict__ p_data2, eidos_logical_t * __restrict__ p_result, int p_count)
+{
+	COMPARE compare;
+	
+	for (int value_index = 0; value_index < p_count; ++value_index)
+		p_result[value_index] = compare((PROMOTED)p_data1[value_index], (PROMOTED)p_data2[value_index]);
+}
+
+template <typename PROMOTED, typename T2, typename COMPARE>
+static void Eidos_CompareKernel_SV(PROMOTED p_value1, const T2 * __restrict__ p_data2, eidos_logical_t * __restrict__ p_result, int p_count)
+{
+	COMPARE compare;
+	
+	for (int value_index = 0; value_index < p_count; ++value_index)
+		p_result[value_index] = compare(p_value1, (PROMOTED)p_data2[value_index]);
+}
+
+template <typename PROMOTED, typename T1, typename COMPARE>
+static void Eidos_CompareKernel_VS(const T1 * __restrict__ p_data1, PROMOTED p_value2, eidos_logical_t * __restrict__ p_result, int p_count)
+{
+	COMPARE compare;
+	
+	for (int value_index = 0; value_index < p_count; ++value_index)
+		p_result[value_index] = compare((PROMOTED)p_data1[value_index], p_value2);
+}
+
+template <typename PROMOTED, typename T1, typename T2, typename COMPARE>
+static inline void Eidos_CompareDispatch(const T1 *p_data1, int p_first_count, const T2 *p_data2, int p_second_count, eidos_logical_t *p_result)
+{
+	if (p_first_count == p_second_count)
+		Eidos_CompareKernel_VV<PROMOTED, T1, T2, COMPARE>(p_data1, p_data2, p_result, p_first_count);
+	else if (p_first_count == 1)
+		Eidos_CompareKernel_SV<PROMOTED, T2, COMPARE>((PROMOTED)p_data1[0], p_data2, p_result, p_second_count);
+	else
+		Eidos_CompareKernel_VS<PROMOTED, T1, COMPARE>(p_data1, (PROMOTED)p_data2[0], p_result, p_first_count);
+}
+
+static inline bool Eidos_FastVectorCompareApplies(const EidosValue *p_first, int p_first_count, const EidosValue *p_second, int p_second_count)
+{
+	EidosValueType first_type = p_first->Type();
+	EidosValueType second_type = p_second->Type();
+	
+	if (((first_type != EidosValueType::kValueInt) && (first_type != EidosValueType::kValueFloat)) || ((second_type != EidosValueType::kValueInt) && (second_type != EidosValueType::kValueFloat)))
+		return false;
+	
+	// the 1-to-1 case returns a statically allocated logical value, and non-conformable counts are an error; both are left to the caller
+	if (p_first_count == p_second_count)
+		return (p_first_count != 1);
+	
+	return ((p_first_count == 1) || (p_second_count == 1));
+}
+
+template <typename COMPARE>
+static void Eidos_FastVectorCompare(const EidosValue *p_first, int p_first_count, const EidosValue *p_second, int p_second_count, EidosValueType p_promotion_type, eidos_logical_t *p_result)
+{
+	EidosValueType first_type = p_first->Type();
+	EidosValueType second_type = p_second->Type();
+	
+	// singletons are not vectors, so we fetch their data by pointer from a local; the counts have been checked by the caller
+	int64_t int1 = 0, int2 = 0;
+	double float1 = 0.0, float2 = 0.0;
+	const int64_t *int1_data = nullptr, *int2_data = nullptr;
+	const double *float1_data = nullptr, *float2_data = nullptr;
+	
+	if (first_type == EidosValueType::kValueInt)
+	{
+		if (p_first->IsSingleton()) { int1 = p_first->IntAtIndex(0, nullptr); int1_data = &int1; }
+		else int1_data = p_first->IntVector()->data();
+	}
+	else
+	{
+		if (p_first->IsSingleton()) { float1 = p_first->FloatAtIndex(0, nullptr); float1_data = &float1; }
+		else float1_data = p_first->FloatVector()->data();
+	}
+	
+	if (second_type == EidosValueType::kValueInt)
+	{
+		if (p_second->IsSingleton()) { int2 = p_second->IntAtIndex(0, nullptr); int2_data = &int2; }
+		else int2_data = p_second->IntVector()->data();
+	}
+	else
+	{
+		if (p_second->IsSingleton()) { float2 = p_second->FloatAtIndex(0, nullptr); float2_data = &float2; }
+		else float2_data = p_second->FloatVector()->data();
+	}
+	
+	if (p_promotion_type == EidosValueType::kValueInt)
+		Eidos_CompareDispatch<int64_t, int64_t, int64_t, COMPARE>(int1_data, p_first_count, int2_data, p_second_count, p_result);
+	else if (int1_data && float2_data)
+		Eidos_CompareDispatch<double, int64_t, double, COMPARE>(int1_data, p_first_count, float2_data, p_second_count, p_result);
+	else if (float1_data && int2_data)
+		Eidos_CompareDispatch<double, double, int64_t, COMPARE>(float1_data, p_first_count, int2_data, p_second_count, p_result);
+	else
+		Eidos_CompareDispatch<double, double, double, COMPARE>(float1_data, p_first_count, float2_data, p_second_count, p_result);
+}
 
 //
 //	EidosInterpreter
@@ -626,9 +778,17 @@ void EidosInterpreter::_ProcessSubsetAssignment(EidosValue_SP *p_base_value_ptr,
 			{
 				identifier_value_SP = identifier_value->VectorBasedCopy();
 				identifier_value = identifier_value_SP.get();
+				identifier_value->SetCopyOnWrite();
 				
 				global_symbols_->SetValueForSymbolNoCopy(p_parent_node->cached_stringID_, identifier_value_SP);
 			}
+			else
+			{
+				// We will modify the value in place, so if it is shared copy-on-write with another variable or Dictionary, the
+				// symbol needs its own copy first; this is where the copy that an assignment like y = x; skipped happens.
+				global_symbols_->UnshareValueForSymbol(p_parent_node->cached_stringID_, identifier_value_SP);
+				identifier_value = identifier_value_SP.get();
+			}
 			
 			*p_base_value_ptr = std::move(identifier_value_SP);
 			
@@ -1406,6 +1566,444 @@ void EidosInterpreter::_LogCallArguments(const EidosCallSignature *call_signatur
 }
 #endif
 
+// Fused reductions: sum(), mean(), max(), min(), any(), and all() applied to an elementwise expression, like sum(exp(-(x - m)^2 / s)),
+// would normally allocate and fill a full-length temporary vector at every operator node.  For call nodes marked by
+// EidosASTNode::_OptimizeFusedReductions(), _EvaluateFusedReduction() looks up the leaves (identifiers and numeric constants only, so
+// looking them up has no side effects) and then evaluates the expression in blocks of EIDOS_FUSED_BLOCK_SIZE elements, keeping each
+// node's values for the current block in a stack buffer and reducing each block as it is produced.  Every element goes through the same
+// operations, in the same order and precision, as in normal evaluation, so the results are identical.  Integer arithmetic (which must
+// check for overflow), matrices and arrays, and mismatched or zero-length operands are not handled; in those cases it returns false
+// and the call is evaluated normally, producing whatever result or error it would have produced anyway.
+#define EIDOS_FUSED_BLOCK_SIZE		256
+
+enum class EidosFusedOp : uint8_t {
+	kLeaf = 0,
+	kPlus,
+	kMinus,
+	kMult,
+	kDiv,
+	kPow,
+	kNegate,
+	kExp,
+	kLog,
+	kLog10,
+	kSqrt,
+	kAbs
+};
+
+struct EidosFusedNode {
+	EidosFusedOp op_;
+	bool is_int_;						// true only for integer leaves; operator nodes always produce float
+	bool is_scalar_;					// true if the node has a single value, broadcast across the vector operands
+	int child_[2];						// indices of child nodes, for operator nodes
+	const double *float_data_;			// the data for float vector leaves
+	const int64_t *int_data_;			// the data for integer vector leaves
+	double scalar_;						// the value of scalar nodes, as float
+	int64_t int_scalar_;				// the value of integer scalar leaves, for integer comparisons
+};
+
+struct Eidos_FusedPlus { inline double operator()(double p_a, double p_b) const { return p_a + p_b; } };
+struct Eidos_FusedMinus { inline double operator()(double p_a, double p_b) const { return p_a - p_b; } };
+struct Eidos_FusedMult { inline double operator()(double p_a, double p_b) const { return p_a * p_b; } };
+struct Eidos_FusedDiv { inline double operator()(double p_a, double p_b) const { return p_a / p_b; } };
+struct Eidos_FusedPow { inline double operator()(double p_a, double p_b) const { return pow(p_a, p_b); } };
+
+template <typename OPERATOR>
+static void Eidos_FusedBinaryKernel(const EidosFusedNode &p_first, const double *p_first_data, const EidosFusedNode &p_second, const double *p_second_data, double * __restrict__ p_result, int p_count)
+{
+	OPERATOR op;
+	
+	if (p_first.is_scalar_)
+	{
+		double first_scalar = p_first.scalar_;
+		const double * __restrict__ second_data = p_second_data;
+		
+		for (int value_index = 0; value_index < p_count; ++value_index)
+			p_result[value_index] = op(first_scalar, second_data[value_index]);
+	}
+	else if (p_second.is_scalar_)
+	{
+		const double * __restrict__ first_data = p_first_data;
+		double second_scalar = p_second.scalar_;
+		
+		for (int value_index = 0; value_index < p_count; ++value_index)
+			p_result[value_index] = op(first_data[value_index], second_scalar);
+	}
+	else
+	{
+		const double * __restrict__ first_data = p_first_data;
+		const double * __restrict__ second_data = p_second_data;
+		
+		for (int value_index = 0; value_index < p_count; ++value_index)
+			p_result[value_index] = op(first_data[value_index], second_data[value_index]);
+	}
+}
+
+// Returns the values of a non-scalar node for the block [p_start, p_start + p_count), evaluating its children as needed; vector float
+// leaves are used in place, and everything else is placed in the node's buffer.  Scalar children are broadcast, not filled.
+static const double *Eidos_FusedEvaluateBlock(const EidosFusedNode *p_nodes, int p_index, int p_start, int p_count, double (*p_buffers)[EIDOS_FUSED_BLOCK_SIZE])
+{
+	const EidosFusedNode &node = p_nodes[p_index];
+	double * __restrict__ result = p_buffers[p_index];
+	
+	if (node.op_ == EidosFusedOp::kLeaf)
+	{
+		if (!node.is_int_)
+			return node.float_data_ + p_start;
+		
+		const int64_t * __restrict__ int_data = node.int_data_ + p_start;
+		
+		for (int value_index = 0; value_index < p_count; ++value_index)
+			result[value_index] = int_data[value_index];
+		
+		return result;
+	}
+	
+	const EidosFusedNode &first = p_nodes[node.child_[0]];
+	const double *first_data = (first.is_scalar_ ? nullptr : Eidos_FusedEvaluateBlock(p_nodes, node.child_[0], p_start, p_count, p_buffers));
+	
+	switch (node.op_)
+	{
+		case EidosFusedOp::kNegate:
+			for (int value_index = 0; value_index < p_count; ++value_index)
+				result[value_index] = -first_data[value_index];
+			return result;
+		case EidosFusedOp::kExp:
+			for (int value_index = 0; value_index < p_count; ++value_index)
+				result[value_index] = exp(first_data[value_index]);
+			return result;
+		case EidosFusedOp::kLog:
+			for (int value_index = 0; value_index < p_count; ++value_index)
+				result[value_index] = log(first_data[value_index]);
+			return result;
+		case EidosFusedOp::kLog10:
+			for (int value_index = 0; value_index < p_count; ++value_index)
+				result[value_index] = log10(first_data[value_index]);
+			return result;
+		case EidosFusedOp::kSqrt:
+			for (int value_index = 0; value_index < p_count; ++value_index)
+				result[value_index] = sqrt(first_data[value_index]);
+			return result;
+		case EidosFusedOp::kAbs:
+			for (int value_index = 0; value_index < p_count; ++value_index)
+				result[value_index] = fabs(first_data[value_index]);
+			return result;
+		default:
+			break;
+	}
+	
+	const EidosFusedNode &second = p_nodes[node.child_[1]];
+	const double *second_data = (second.is_scalar_ ? nullptr : Eidos_FusedEvaluateBlock(p_nodes, node.child_[1], p_start, p_count, p_buffers));
+	
+	switch (node.op_)
+	{
+		case EidosFusedOp::kPlus:	Eidos_FusedBinaryKernel<Eidos_FusedPlus>(first, first_data, second, second_data, result, p_count); break;
+		case EidosFusedOp::kMinus:	Eidos_FusedBinaryKernel<Eidos_FusedMinus>(first, first_data, second, second_data, result, p_count); break;
+		case EidosFusedOp::kMult:	Eidos_FusedBinaryKernel<Eidos_FusedMult>(first, first_data, second, second_data, result, p_count); break;
+		case EidosFusedOp::kDiv:	Eidos_FusedBinaryKernel<Eidos_FusedDiv>(first, first_data, second, second_data, result, p_count); break;
+		case EidosFusedOp::kPow:	Eidos_FusedBinaryKernel<Eidos_FusedPow>(first, first_data, second, second_data, result, p_count); break;
+		default: break;		// never hit
+	}
+	
+	return result;
+}
+
+// Evaluates a comparison between two fused nodes, at least one of which is not scalar, for one block; integer operands are compared as
+// integer only if both are integer, as with the comparison operators themselves.  This uses the same kernels as those operators.
+template <typename COMPARE>
+static void Eidos_FusedCompareBlock(const EidosFusedNode *p_nodes, int p_first_index, int p_second_index, int p_start, int p_count, double (*p_buffers)[EIDOS_FUSED_BLOCK_SIZE], eidos_logical_t *p_result)
+{
+	const EidosFusedNode &first = p_nodes[p_first_index];
+	const EidosFusedNode &second = p_nodes[p_second_index];
+	
+	if (first.is_int_ && second.is_int_)
+	{
+		if (first.is_scalar_)
+			Eidos_CompareKernel_SV<int64_t, int64_t, COMPARE>(first.int_scalar_, second.int_data_ + p_start, p_result, p_count);
+		else if (second.is_scalar_)
+			Eidos_CompareKernel_VS<int64_t, int64_t, COMPARE>(first.int_data_ + p_start, second.int_scalar_, p_result, p_count);
+		else
+			Eidos_CompareKernel_VV<int64_t, int64_t, int64_t, COMPARE>(first.int_data_ + p_start, second.int_data_ + p_start, p_result, p_count);
+		return;
+	}
+	
+	if (first.is_scalar_)
+		Eidos_CompareKernel_SV<double, double, COMPARE>(first.scalar_, Eidos_FusedEvaluateBlock(p_nodes, p_second_index, p_start, p_count, p_buffers), p_result, p_count);
+	else if (second.is_scalar_)
+		Eidos_CompareKernel_VS<double, double, COMPARE>(Eidos_FusedEvaluateBlock(p_nodes, p_first_index, p_start, p_count, p_buffers), second.scalar_, p_result, p_count);
+	else
+		Eidos_CompareKernel_VV<double, double, double, COMPARE>(Eidos_FusedEvaluateBlock(p_nodes, p_first_index, p_start, p_count, p_buffers), Eidos_FusedEvaluateBlock(p_nodes, p_second_index, p_start, p_count, p_buffers), p_result, p_count);
+}
+
+int EidosInterpreter::_BuildFusedNode(const EidosASTNode *p_node, EidosFusedNode *p_nodes, int *p_node_count, EidosValue_SP *p_leaf_values, int *p_length)
+{
+	// Adds a fused node for p_node and its children to p_nodes, evaluating the leaves in the same order as normal evaluation would; returns
+	// the index of the new node, or -1 if something not handled by fused evaluation is found.  p_length accumulates the vector length.
+	int node_index = (*p_node_count)++;
+	EidosFusedNode &node = p_nodes[node_index];
+	EidosTokenType token_type = p_node->token_->token_type_;
+	const std::vector<EidosASTNode *> &children = p_node->children_;
+	
+	node.is_int_ = false;
+	
+	if ((token_type == EidosTokenType::kTokenIdentifier) || (token_type == EidosTokenType::kTokenNumber))
+	{
+		EidosValue_SP leaf_value = FastEvaluateNode(p_node);
+		EidosValue *leaf = leaf_value.get();
+		EidosValueType leaf_type = leaf->Type();
+		int leaf_count = leaf->Count();
+		
+		if (((leaf_type != EidosValueType::kValueInt) && (leaf_type != EidosValueType::kValueFloat)) || (leaf->DimensionCount() != 1))
+			return -1;
+		
+		node.op_ = EidosFusedOp::kLeaf;
+		node.is_int_ = (leaf_type == EidosValueType::kValueInt);
+		node.is_scalar_ = (leaf_count == 1);
+		
+		if (leaf_count == 1)
+		{
+			node.scalar_ = leaf->FloatAtIndex(0, nullptr);
+			node.int_scalar_ = (node.is_int_ ? leaf->IntAtIndex(0, nullptr) : 0);
+		}
+		else
+		{
+			if (leaf_count == 0)
+				return -1;
+			if (*p_length == -1)
+				*p_length = leaf_count;
+			else if (*p_length != leaf_count)
+				return -1;
+			
+			if (node.is_int_)
+				node.int_data_ = leaf->IntVector()->data();
+			else
+				node.float_data_ = leaf->FloatVector()->data();
+		}
+		
+		p_leaf_values[node_index] = std::move(leaf_value);
+		return node_index;
+	}
+	
+	if (token_type == EidosTokenType::kTokenLParen)
+	{
+		EidosInternalFunctionPtr function = children[0]->cached_signature_->internal_function_;
+		int child_index = _BuildFusedNode(children[1], p_nodes, p_node_count, p_leaf_values, p_length);
+		
+		if (child_index == -1)
+			return -1;
+		
+		const EidosFusedNode &child = p_nodes[child_index];
+		
+		if (function == &Eidos_ExecuteFunction_exp)			node.op_ = EidosFusedOp::kExp;
+		else if (function == &Eidos_ExecuteFunction_log)	node.op_ = EidosFusedOp::kLog;
+		else if (function == &Eidos_ExecuteFunction_log10)	node.op_ = EidosFusedOp::kLog10;
+		else if (function == &Eidos_ExecuteFunction_sqrt)	node.op_ = EidosFusedOp::kSqrt;
+		else if ((function == &Eidos_ExecuteFunction_abs) && !child.is_int_)	node.op_ = EidosFusedOp::kAbs;		// abs() of integer is integer
+		else return -1;
+		
+		node.child_[0] = child_index;
+		node.is_scalar_ = child.is_scalar_;
+		
+		if (node.is_scalar_)
+		{
+			switch (node.op_)
+			{
+				case EidosFusedOp::kExp:	node.scalar_ = exp(child.scalar_); break;
+				case EidosFusedOp::kLog:	node.scalar_ = log(child.scalar_); break;
+				case EidosFusedOp::kLog10:	node.scalar_ = log10(child.scalar_); break;
+				case EidosFusedOp::kSqrt:	node.scalar_ = sqrt(child.scalar_); break;
+				default:					node.scalar_ = fabs(child.scalar_); break;
+			}
+		}
+		
+		return node_index;
+	}
+	
+	if (children.size() == 1)
+	{
+		// unary minus; negating an integer is integer arithmetic, which is not handled
+		int child_index = _BuildFusedNode(children[0], p_nodes, p_node_count, p_leaf_values, p_length);
+		
+		if ((child_index == -1) || p_nodes[child_index].is_int_)
+			return -1;
+		
+		node.op_ = EidosFusedOp::kNegate;
+		node.child_[0] = child_index;
+		node.is_scalar_ = p_nodes[child_index].is_scalar_;
+		
+		if (node.is_scalar_)
+			node.scalar_ = -p_nodes[child_index].scalar_;
+		
+		return node_index;
+	}
+	
+	int first_index = _BuildFusedNode(children[0], p_nodes, p_node_count, p_leaf_values, p_length);
+	
+	if (first_index == -1)
+		return -1;
+	
+	int second_index = _BuildFusedNode(children[1], p_nodes, p_node_count, p_leaf_values, p_length);
+	
+	if (second_index == -1)
+		return -1;
+	
+	const EidosFusedNode &first = p_nodes[first_index];
+	const EidosFusedNode &second = p_nodes[second_index];
+	
+	switch (token_type)
+	{
+		case EidosTokenType::kTokenPlus:	node.op_ = EidosFusedOp::kPlus; break;
+		case EidosTokenType::kTokenMinus:	node.op_ = EidosFusedOp::kMinus; break;
+		case EidosTokenType::kTokenMult:	node.op_ = EidosFusedOp::kMult; break;
+		case EidosTokenType::kTokenDiv:		node.op_ = EidosFusedOp::kDiv; break;
+		case EidosTokenType::kTokenExp:		node.op_ = EidosFusedOp::kPow; break;
+		default:							return -1;
+	}
+	
+	// +, -, and * with two integer operands are integer arithmetic, which is not handled; / and ^ always produce float
+	if (first.is_int_ && second.is_int_ && ((node.op_ == EidosFusedOp::kPlus) || (node.op_ == EidosFusedOp::kMinus) || (node.op_ == EidosFusedOp::kMult)))
+		return -1;
+	
+	node.child_[0] = first_index;
+	node.child_[1] = second_index;
+	node.is_scalar_ = (first.is_scalar_ && second.is_scalar_);
+	
+	if (node.is_scalar_)
+	{
+		switch (node.op_)
+		{
+			case EidosFusedOp::kPlus:	node.scalar_ = first.scalar_ + second.scalar_; break;
+			case EidosFusedOp::kMinus:	node.scalar_ = first.scalar_ - second.scalar_; break;
+			case EidosFusedOp::kMult:	node.scalar_ = first.scalar_ * second.scalar_; break;
+			case EidosFusedOp::kDiv:	node.scalar_ = first.scalar_ / second.scalar_; break;
+			default:					node.scalar_ = pow(first.scalar_, second.scalar_); break;
+		}
+	}
+	
+	return node_index;
+}
+
+bool EidosInterpreter::_EvaluateFusedReduction(const EidosASTNode *p_node, const EidosFunctionSignature *p_function_signature, EidosValue_SP &p_result_SP)
+{
+#if DEBUG_POINTS_ENABLED
+	// When running under SLiMgui, skip fused evaluation if debug points are set, so that calls log their arguments
+	if (debug_points_ && debug_points_->set.size())
+		return false;
+#endif
+	
+	if (logging_execution_)
+		return false;
+	
+	EidosFusedNode nodes[EIDOS_FUSED_MAX_NODES];
+	EidosValue_SP leaf_values[EIDOS_FUSED_MAX_NODES];
+	int node_count = 0;
+	int length = -1;
+	EidosInternalFunctionPtr function = p_function_signature->internal_function_;
+	const EidosASTNode *argument_node = p_node->children_[1];
+	double buffers[EIDOS_FUSED_MAX_NODES][EIDOS_FUSED_BLOCK_SIZE];
+	
+	if ((function == &Eidos_ExecuteFunction_any) || (function == &Eidos_ExecuteFunction_all))
+	{
+		int first_index = _BuildFusedNode(argument_node->children_[0], nodes, &node_count, leaf_values, &length);
+		
+		if (first_index == -1)
+			return false;
+		
+		int second_index = _BuildFusedNode(argument_node->children_[1], nodes, &node_count, leaf_values, &length);
+		
+		if ((second_index == -1) || (length < 2))
+			return false;
+		
+		EidosTokenType compare_token_type = argument_node->token_->token_type_;
+		bool is_any = (function == &Eidos_ExecuteFunction_any);
+		eidos_logical_t logical_buffer[EIDOS_FUSED_BLOCK_SIZE];
+		
+		for (int block_start = 0; block_start < length; block_start += EIDOS_FUSED_BLOCK_SIZE)
+		{
+			int block_count = std::min(length - block_start, EIDOS_FUSED_BLOCK_SIZE);
+			
+			switch (compare_token_type)
+			{
+				case EidosTokenType::kTokenEq:		Eidos_FusedCompareBlock<Eidos_CompareEq>(nodes, first_index, second_index, block_start, block_count, buffers, logical_buffer); break;
+				case EidosTokenType::kTokenNotEq:	Eidos_FusedCompareBlock<Eidos_CompareNotEq>(nodes, first_index, second_index, block_start, block_count, buffers, logical_buffer); break;
+				case EidosTokenType::kTokenLt:		Eidos_FusedCompareBlock<Eidos_CompareLt>(nodes, first_index, second_index, block_start, block_count, buffers, logical_buffer); break;
+				case EidosTokenType::kTokenLtEq:	Eidos_FusedCompareBlock<Eidos_CompareLtEq>(nodes, first_index, second_index, block_start, block_count, buffers, logical_buffer); break;
+				case EidosTokenType::kTokenGt:		Eidos_FusedCompareBlock<Eidos_CompareGt>(nodes, first_index, second_index, block_start, block_count, buffers, logical_buffer); break;
+				default:							Eidos_FusedCompareBlock<Eidos_CompareGtEq>(nodes, first_index, second_index, block_start, block_count, buffers, logical_buffer); break;
+			}
+			
+			// stop at the first T for any(), or the first F for all(); nothing that remains has side effects
+			for (int value_index = 0; value_index < block_count; ++value_index)
+				if ((bool)logical_buffer[value_index] == is_any)
+				{
+					p_result_SP = (is_any ? gStaticEidosValue_LogicalT : gStaticEidosValue_LogicalF);
+					return true;
+				}
+		}
+		
+		p_result_SP = (is_any ? gStaticEidosValue_LogicalF : gStaticEidosValue_LogicalT);
+		return true;
+	}
+	
+	int root_index = _BuildFusedNode(argument_node, nodes, &node_count, leaf_values, &length);
+	
+	if ((root_index == -1) || (length < 2))
+		return false;
+	
+	if ((function == &Eidos_ExecuteFunction_sum) || (function == &Eidos_ExecuteFunction_mean))
+	{
+		// this sums sequentially, exactly as sum() and mean() do
+		double sum = 0;
+		
+		for (int block_start = 0; block_start < length; block_start += EIDOS_FUSED_BLOCK_SIZE)
+		{
+			int block_count = std::min(length - block_start, EIDOS_FUSED_BLOCK_SIZE);
+			const double *block_data = Eidos_FusedEvaluateBlock(nodes, root_index, block_start, block_count, buffers);
+			
+			for (int value_index = 0; value_index < block_count; ++value_index)
+				sum += block_data[value_index];
+		}
+		
+		if (function == &Eidos_ExecuteFunction_mean)
+			sum = sum / length;
+		
+		p_result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(sum));
+		return true;
+	}
+	else
+	{
+		// this follows max() and min(), including their handling of NAN
+		bool is_max = (function == &Eidos_ExecuteFunction_max);
+		double extreme = 0;
+		
+		for (int block_start = 0; block_start < length; block_start += EIDOS_FUSED_BLOCK_SIZE)
+		{
+			int block_count = std::min(length - block_start, EIDOS_FUSED_BLOCK_SIZE);
+			const double *block_data = Eidos_FusedEvaluateBlock(nodes, root_index, block_start, block_count, buffers);
+			
+			if (block_start == 0)
+				extreme = block_data[0];
+			
+			for (int value_index = 0; value_index < block_count; ++value_index)
+			{
+				double temp = block_data[value_index];
+				
+				if (std::isnan(temp))
+				{
+					p_result_SP = gStaticEidosValue_FloatNAN;
+					return true;
+				}
+				
+				if (is_max ? (extreme < temp) : (extreme > temp))
+					extreme = temp;
+			}
+		}
+		
+		p_result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(extreme));
+		return true;
+	}
+}
+
 EidosValue_SP EidosInterpreter::Evaluate_Call(const EidosASTNode *p_node)
 {
 	EIDOS_ENTRY_EXECUTION_LOG("Evaluate_Call()");
@@ -1452,45 +2050,52 @@ EidosValue_SP EidosInterpreter::Evaluate_Call(const EidosASTNode *p_node)
 		// If an error occurs inside a function or method call, we want to highlight the call
 		EidosErrorPosition error_pos_save = PushErrorPositionFromToken(call_identifier_token);
 		
-		// Argument processing
-		std::vector<EidosValue_SP> *argument_buffer = _ProcessArgumentList(p_node, function_signature);
-		
-#if DEBUG_POINTS_ENABLED
-		// SLiMgui debugging point
-		EidosDebugPointIndent indenter;
-		
-		if (debug_points_ && debug_points_->set.size() && (call_identifier_token->token_line_ != -1) &&
-			(debug_points_->set.find(call_identifier_token->token_line_) != debug_points_->set.end()))
-		{
-			std::ostream &output_stream = ErrorOutputStream();
-			
-			output_stream << EidosDebugPointIndent::Indent() << "#DEBUG CALL (line " << (call_identifier_token->token_line_ + 1) << eidos_context_->DebugPointInfo() << "): call to function " <<
-				*function_name << "() with arguments:" << std::endl;
-			indenter.indent(2);
-			_LogCallArguments(function_signature, argument_buffer);
-			indenter.indent(2);
-		}
-#endif
-		
-		if (function_signature->internal_function_)
+		if (p_node->cached_fused_reduction_ && _EvaluateFusedReduction(p_node, function_signature, result_SP))
 		{
-			result_SP = function_signature->internal_function_(*argument_buffer, *this);
+			// the call was a reduction of an elementwise expression, evaluated without temporaries; see _EvaluateFusedReduction()
 		}
-		else if (function_signature->body_script_)
-		{
-			result_SP = DispatchUserDefinedFunction(*function_signature, *argument_buffer);
-		}
-		else if (!function_signature->delegate_name_.empty())
+		else
 		{
-			if (eidos_context_)
-				result_SP = eidos_context_->ContextDefinedFunctionDispatch(*function_name, *argument_buffer, *this);
+			// Argument processing
+			std::vector<EidosValue_SP> *argument_buffer = _ProcessArgumentList(p_node, function_signature);
+			
+#if DEBUG_POINTS_ENABLED
+			// SLiMgui debugging point
+			EidosDebugPointIndent indenter;
+			
+			if (debug_points_ && debug_points_->set.size() && (call_identifier_token->token_line_ != -1) &&
+				(debug_points_->set.find(call_identifier_token->token_line_) != debug_points_->set.end()))
+			{
+				std::ostream &output_stream = ErrorOutputStream();
+			
+				output_stream << EidosDebugPointIndent::Indent() << "#DEBUG CALL (line " << (call_identifier_token->token_line_ + 1) << eidos_context_->DebugPointInfo() << "): call to function " <<
+					*function_name << "() with arguments:" << std::endl;
+				indenter.indent(2);
+				_LogCallArguments(function_signature, argument_buffer);
+				indenter.indent(2);
+			}
+#endif
+			
+			if (function_signature->internal_function_)
+			{
+				result_SP = function_signature->internal_function_(*argument_buffer, *this);
+			}
+			else if (function_signature->body_script_)
+			{
+				result_SP = DispatchUserDefinedFunction(*function_signature, *argument_buffer);
+			}
+			else if (!function_signature->delegate_name_.empty())
+			{
+				if (eidos_context_)
+					result_SP = eidos_context_->ContextDefinedFunctionDispatch(*function_name, *argument_buffer, *this);
+				else
+					EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Call): function " << function_name << " is defined by the Context, but the Context is not defined." << EidosTerminate(nullptr);
+			}
 			else
-				EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Call): function " << function_name << " is defined by the Context, but the Context is not defined." << EidosTerminate(nullptr);
+				EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Call): unbound function " << *function_name << "." << EidosTerminate(call_identifier_token);
+			
+			_DeprocessArgumentList(p_node, argument_buffer);
 		}
-		else
-			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Call): unbound function " << *function_name << "." << EidosTerminate(call_identifier_token);
-		
-		_DeprocessArgumentList(p_node, argument_buffer);
 		
 		// If the code above supplied no return value, raise when in debug.  Not in debug, we crash.
 #if DEBUG
@@ -2030,7 +2635,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Plus(const EidosASTNode *p_node)
 					if (overflow)
 						EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Plus): integer addition overflow with the binary '+' operator." << EidosTerminate(operator_token);
 					
-					result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Int_singleton(add_result));
+					result_SP = Eidos_IntSingletonResult(first_child_value, second_child_value, add_result);
 				}
 				else
 				{
@@ -2121,7 +2726,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Plus(const EidosASTNode *p_node)
 			{
 				if (first_child_count == 1)
 				{
-					result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(first_child_value->FloatAtIndex(0, operator_token) + second_child_value->FloatAtIndex(0, operator_token)));
+					result_SP = Eidos_FloatSingletonResult(first_child_value, second_child_value, first_child_value->FloatAtIndex(0, operator_token) + second_child_value->FloatAtIndex(0, operator_token));
 				}
 				else
 				{
@@ -2279,7 +2884,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Minus(const EidosASTNode *p_node)
 		{
 			if (first_child_count == 1)
 			{
-				result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(-first_child_value->FloatAtIndex(0, operator_token)));
+				result_SP = Eidos_FloatSingletonResult(first_child_value, first_child_value, -first_child_value->FloatAtIndex(0, operator_token));
 			}
 			else
 			{
@@ -2294,7 +2899,9 @@ EidosValue_SP EidosInterpreter::Evaluate_Minus(const EidosASTNode *p_node)
 			}
 		}
 		
-		result_SP->CopyDimensionsFromValue(first_child_value.get());
+		// if the operand was reused as a scalar temporary it has been moved into result_SP, and has no dimensions to copy
+		if (first_child_value)
+			result_SP->CopyDimensionsFromValue(first_child_value.get());
 	}
 	else
 	{
@@ -2333,7 +2940,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Minus(const EidosASTNode *p_node)
 					if (overflow)
 						EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Minus): integer subtraction overflow with the binary '-' operator." << EidosTerminate(operator_token);
 					
-					result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Int_singleton(subtract_result));
+					result_SP = Eidos_IntSingletonResult(first_child_value, second_child_value, subtract_result);
 				}
 				else
 				{
@@ -2421,7 +3028,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Minus(const EidosASTNode *p_node)
 			{
 				if (first_child_count == 1)
 				{
-					result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(first_child_value->FloatAtIndex(0, operator_token) - second_child_value->FloatAtIndex(0, operator_token)));
+					result_SP = Eidos_FloatSingletonResult(first_child_value, second_child_value, first_child_value->FloatAtIndex(0, operator_token) - second_child_value->FloatAtIndex(0, operator_token));
 				}
 				else
 				{
@@ -2555,7 +3162,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Mod(const EidosASTNode *p_node)
 	{
 		if (first_child_count == 1)
 		{
-			result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(fmod(first_child_value->FloatAtIndex(0, operator_token), second_child_value->FloatAtIndex(0, operator_token))));
+			result_SP = Eidos_FloatSingletonResult(first_child_value, second_child_value, fmod(first_child_value->FloatAtIndex(0, operator_token), second_child_value->FloatAtIndex(0, operator_token)));
 		}
 		else
 		{
@@ -2705,7 +3312,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Mult(const EidosASTNode *p_node)
 				if (overflow)
 					EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Mult): integer multiplication overflow with the '*' operator." << EidosTerminate(operator_token);
 				
-				result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Int_singleton(multiply_result));
+				result_SP = Eidos_IntSingletonResult(first_child_value, second_child_value, multiply_result);
 			}
 			else
 			{
@@ -2737,7 +3344,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Mult(const EidosASTNode *p_node)
 		{
 			if (first_child_count == 1)
 			{
-				result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(first_child_value->FloatAtIndex(0, operator_token) * second_child_value->FloatAtIndex(0, operator_token)));
+				result_SP = Eidos_FloatSingletonResult(first_child_value, second_child_value, first_child_value->FloatAtIndex(0, operator_token) * second_child_value->FloatAtIndex(0, operator_token));
 			}
 			else
 			{
@@ -2900,7 +3507,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Div(const EidosASTNode *p_node)
 	{
 		if (first_child_count == 1)
 		{
-			result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(first_child_value->FloatAtIndex(0, operator_token) / second_child_value->FloatAtIndex(0, operator_token)));
+			result_SP = Eidos_FloatSingletonResult(first_child_value, second_child_value, first_child_value->FloatAtIndex(0, operator_token) / second_child_value->FloatAtIndex(0, operator_token));
 		}
 		else
 		{
@@ -3077,7 +3684,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Exp(const EidosASTNode *p_node)
 	{
 		if (first_child_count == 1)
 		{
-			result_SP = EidosValue_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Float_singleton(pow(first_child_value->FloatAtIndex(0, operator_token), second_child_value->FloatAtIndex(0, operator_token))));
+			result_SP = Eidos_FloatSingletonResult(first_child_value, second_child_value, pow(first_child_value->FloatAtIndex(0, operator_token), second_child_value->FloatAtIndex(0, operator_token)));
 		}
 		else
 		{
@@ -3720,13 +4327,15 @@ EidosValue_SP EidosInterpreter::Evaluate_Assign(const EidosASTNode *p_node)
 		if (is_const)
 			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Assign): identifier '" << lvalue_node->token_->token_string_ << "' cannot be redefined because it is a constant." << EidosTerminate(p_node->token_);
 		
+		global_symbols_->UnshareValueForSymbol(lvalue_node->cached_stringID_, lvalue_SP);
+		
 		EidosValue *lvalue = lvalue_SP.get();
 		int lvalue_count = lvalue->Count();
 		
 		// somewhat unusually, we will now modify the lvalue in place, for speed; this is legal since we just got
 		// it from the symbol table (we want to modify it in the symbol table, and others should not have a
-		// reference to the object that they expect to be constant), but doing it right requires care given
-		// different value subclasses, singletons, etc.
+		// reference to the object that they expect to be constant, which UnshareValueForSymbol() ensured above
+		// for copy-on-write values), but doing it right requires care given different value subclasses, etc.
 		if (lvalue_count > 0)
 		{
 			EidosValueType lvalue_type = lvalue->Type();
@@ -4039,7 +4648,16 @@ EidosValue_SP EidosInterpreter::Evaluate_Eq(const EidosASTNode *p_node)
 		if ((first_child_dimcount > 1) && (second_child_dimcount > 1) && !EidosValue::MatchingDimensions(first_child_value.get(), second_child_value.get()))
 			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Eq): non-conformable array operands to the '==' operator." << EidosTerminate(operator_token);
 		
-		if (first_child_count == second_child_count)
+		if (Eidos_FastVectorCompareApplies(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count))
+		{
+			// int, float, and mixed int/float operands other than two singletons go to the vectorized comparison kernels
+			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
+			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize((first_child_count == 1) ? second_child_count : first_child_count);
+			
+			Eidos_FastVectorCompare<Eidos_CompareEq>(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count, promotion_type, logical_result->data());
+			result_SP = std::move(logical_result_SP);
+		}
+		else if (first_child_count == second_child_count)
 		{
 			if (first_child_count == 1)
 			{
@@ -4066,25 +4684,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Eq(const EidosASTNode *p_node)
 				EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
 				EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize(first_child_count);
 				
-				if ((first_child_type == EidosValueType::kValueFloat) && (second_child_type == EidosValueType::kValueFloat))
-				{
-					// Direct float-to-float compare can be optimized through vector access
-					const double *float1_data = first_child_value->FloatVector()->data();
-					const double *float2_data = second_child_value->FloatVector()->data();
-					
-					for (int value_index = 0; value_index < first_child_count; ++value_index)
-						logical_result->set_logical_no_check(float1_data[value_index] == float2_data[value_index], value_index);
-				}
-				else if ((first_child_type == EidosValueType::kValueInt) && (second_child_type == EidosValueType::kValueInt))
-				{
-					// Direct int-to-int compare can be optimized through vector access
-					const int64_t *int1_data = first_child_value->IntVector()->data();
-					const int64_t *int2_data = second_child_value->IntVector()->data();
-					
-					for (int value_index = 0; value_index < first_child_count; ++value_index)
-						logical_result->set_logical_no_check(int1_data[value_index] == int2_data[value_index], value_index);
-				}
-				else if ((first_child_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
+				if ((first_child_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
 				{
 					// Direct object-to-object compare can be optimized through vector access
 					EidosObject * const *obj1_vec = first_child_value->ObjectElementVector()->data();
@@ -4122,25 +4722,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Eq(const EidosASTNode *p_node)
 			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
 			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize(second_child_count);
 			
-			if ((promotion_type == EidosValueType::kValueFloat) && (second_child_type == EidosValueType::kValueFloat))
-			{
-				// Direct float-to-float compare can be optimized through vector access; note the singleton might get promoted to float
-				double float1 = first_child_value->FloatAtIndex(0, operator_token);
-				const double *float_data = second_child_value->FloatVector()->data();
-				
-				for (int value_index = 0; value_index < second_child_count; ++value_index)
-					logical_result->set_logical_no_check(float1 == float_data[value_index], value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueInt) && (second_child_type == EidosValueType::kValueInt))
-			{
-				// Direct int-to-int compare can be optimized through vector access; note the singleton might get promoted to int
-				int64_t int1 = first_child_value->IntAtIndex(0, operator_token);
-				const int64_t *int_data = second_child_value->IntVector()->data();
-				
-				for (int value_index = 0; value_index < second_child_count; ++value_index)
-					logical_result->set_logical_no_check(int1 == int_data[value_index], value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
+			if ((promotion_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
 			{
 				// Direct object-to-object compare can be optimized through vector access
 				EidosObject *obj1 = first_child_value->ObjectElementAtIndex(0, operator_token);
@@ -4177,25 +4759,7 @@ EidosValue_SP EidosInterpreter::Evaluate_Eq(const EidosASTNode *p_node)
 			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
 			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize(first_child_count);
 			
-			if ((promotion_type == EidosValueType::kValueFloat) && (first_child_type == EidosValueType::kValueFloat))
-			{
-				// Direct float-to-float compare can be optimized through vector access; note the singleton might get promoted to float
-				double float2 = second_child_value->FloatAtIndex(0, operator_token);
-				const double *float_data = first_child_value->FloatVector()->data();
-				
-				for (int value_index = 0; value_index < first_child_count; ++value_index)
-					logical_result->set_logical_no_check(float_data[value_index] == float2, value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueInt) && (first_child_type == EidosValueType::kValueInt))
-			{
-				// Direct int-to-int compare can be optimized through vector access; note the singleton might get promoted to int
-				int64_t int2 = second_child_value->IntAtIndex(0, operator_token);
-				const int64_t *int_data = first_child_value->IntVector()->data();
-				
-				for (int value_index = 0; value_index < first_child_count; ++value_index)
-					logical_result->set_logical_no_check(int_data[value_index] == int2, value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueObject) && (first_child_type == EidosValueType::kValueObject))
+			if ((promotion_type == EidosValueType::kValueObject) && (first_child_type == EidosValueType::kValueObject))
 			{
 				// Direct object-to-object compare can be optimized through vector access
 				EidosObject *obj2 = second_child_value->ObjectElementAtIndex(0, operator_token);
@@ -4278,7 +4842,16 @@ EidosValue_SP EidosInterpreter::Evaluate_Lt(const EidosASTNode *p_node)
 		if ((first_child_dimcount > 1) && (second_child_dimcount > 1) && !EidosValue::MatchingDimensions(first_child_value.get(), second_child_value.get()))
 			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Lt): non-conformable array operands to the '<' operator." << EidosTerminate(operator_token);
 		
-		if (first_child_count == second_child_count)
+		if (Eidos_FastVectorCompareApplies(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count))
+		{
+			// int, float, and mixed int/float operands other than two singletons go to the vectorized comparison kernels
+			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
+			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize((first_child_count == 1) ? second_child_count : first_child_count);
+			
+			Eidos_FastVectorCompare<Eidos_CompareLt>(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count, promotion_type, logical_result->data());
+			result_SP = std::move(logical_result_SP);
+		}
+		else if (first_child_count == second_child_count)
 		{
 			if (first_child_count == 1)
 			{
@@ -4425,7 +4998,16 @@ EidosValue_SP EidosInterpreter::Evaluate_LtEq(const EidosASTNode *p_node)
 		if ((first_child_dimcount > 1) && (second_child_dimcount > 1) && !EidosValue::MatchingDimensions(first_child_value.get(), second_child_value.get()))
 			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_LtEq): non-conformable array operands to the '<=' operator." << EidosTerminate(operator_token);
 		
-		if (first_child_count == second_child_count)
+		if (Eidos_FastVectorCompareApplies(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count))
+		{
+			// int, float, and mixed int/float operands other than two singletons go to the vectorized comparison kernels
+			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
+			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize((first_child_count == 1) ? second_child_count : first_child_count);
+			
+			Eidos_FastVectorCompare<Eidos_CompareLtEq>(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count, promotion_type, logical_result->data());
+			result_SP = std::move(logical_result_SP);
+		}
+		else if (first_child_count == second_child_count)
 		{
 			if (first_child_count == 1)
 			{
@@ -4572,7 +5154,16 @@ EidosValue_SP EidosInterpreter::Evaluate_Gt(const EidosASTNode *p_node)
 		if ((first_child_dimcount > 1) && (second_child_dimcount > 1) && !EidosValue::MatchingDimensions(first_child_value.get(), second_child_value.get()))
 			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_Gt): non-conformable array operands to the '>' operator." << EidosTerminate(operator_token);
 		
-		if (first_child_count == second_child_count)
+		if (Eidos_FastVectorCompareApplies(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count))
+		{
+			// int, float, and mixed int/float operands other than two singletons go to the vectorized comparison kernels
+			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
+			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize((first_child_count == 1) ? second_child_count : first_child_count);
+			
+			Eidos_FastVectorCompare<Eidos_CompareGt>(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count, promotion_type, logical_result->data());
+			result_SP = std::move(logical_result_SP);
+		}
+		else if (first_child_count == second_child_count)
 		{
 			if (first_child_count == 1)
 			{
@@ -4719,7 +5310,16 @@ EidosValue_SP EidosInterpreter::Evaluate_GtEq(const EidosASTNode *p_node)
 		if ((first_child_dimcount > 1) && (second_child_dimcount > 1) && !EidosValue::MatchingDimensions(first_child_value.get(), second_child_value.get()))
 			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_GtEq): non-conformable array operands to the '>=' operator." << EidosTerminate(operator_token);
 		
-		if (first_child_count == second_child_count)
+		if (Eidos_FastVectorCompareApplies(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count))
+		{
+			// int, float, and mixed int/float operands other than two singletons go to the vectorized comparison kernels
+			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
+			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize((first_child_count == 1) ? second_child_count : first_child_count);
+			
+			Eidos_FastVectorCompare<Eidos_CompareGtEq>(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count, promotion_type, logical_result->data());
+			result_SP = std::move(logical_result_SP);
+		}
+		else if (first_child_count == second_child_count)
 		{
 			if (first_child_count == 1)
 			{
@@ -4864,7 +5464,16 @@ EidosValue_SP EidosInterpreter::Evaluate_NotEq(const EidosASTNode *p_node)
 		if ((first_child_dimcount > 1) && (second_child_dimcount > 1) && !EidosValue::MatchingDimensions(first_child_value.get(), second_child_value.get()))
 			EIDOS_TERMINATION << "ERROR (EidosInterpreter::Evaluate_NotEq): non-conformable array operands to the '!=' operator." << EidosTerminate(operator_token);
 		
-		if (first_child_count == second_child_count)
+		if (Eidos_FastVectorCompareApplies(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count))
+		{
+			// int, float, and mixed int/float operands other than two singletons go to the vectorized comparison kernels
+			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
+			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize((first_child_count == 1) ? second_child_count : first_child_count);
+			
+			Eidos_FastVectorCompare<Eidos_CompareNotEq>(first_child_value.get(), first_child_count, second_child_value.get(), second_child_count, promotion_type, logical_result->data());
+			result_SP = std::move(logical_result_SP);
+		}
+		else if (first_child_count == second_child_count)
 		{
 			if (first_child_count == 1)
 			{
@@ -4892,25 +5501,7 @@ EidosValue_SP EidosInterpreter::Evaluate_NotEq(const EidosASTNode *p_node)
 				EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
 				EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize(first_child_count);
 				
-				if ((first_child_type == EidosValueType::kValueFloat) && (second_child_type == EidosValueType::kValueFloat))
-				{
-					// Direct float-to-float compare can be optimized through vector access
-					const double *float1_data = first_child_value->FloatVector()->data();
-					const double *float2_data = second_child_value->FloatVector()->data();
-					
-					for (int value_index = 0; value_index < first_child_count; ++value_index)
-						logical_result->set_logical_no_check(float1_data[value_index] != float2_data[value_index], value_index);
-				}
-				else if ((first_child_type == EidosValueType::kValueInt) && (second_child_type == EidosValueType::kValueInt))
-				{
-					// Direct int-to-int compare can be optimized through vector access
-					const int64_t *int1_data = first_child_value->IntVector()->data();
-					const int64_t *int2_data = second_child_value->IntVector()->data();
-					
-					for (int value_index = 0; value_index < first_child_count; ++value_index)
-						logical_result->set_logical_no_check(int1_data[value_index] != int2_data[value_index], value_index);
-				}
-				else if ((first_child_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
+				if ((first_child_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
 				{
 					// Direct object-to-object compare can be optimized through vector access
 					EidosObject * const *obj1_vec = first_child_value->ObjectElementVector()->data();
@@ -4948,25 +5539,7 @@ EidosValue_SP EidosInterpreter::Evaluate_NotEq(const EidosASTNode *p_node)
 			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
 			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize(second_child_count);
 			
-			if ((promotion_type == EidosValueType::kValueFloat) && (second_child_type == EidosValueType::kValueFloat))
-			{
-				// Direct float-to-float compare can be optimized through vector access; note the singleton might get promoted to float
-				double float1 = first_child_value->FloatAtIndex(0, operator_token);
-				const double *float_data = second_child_value->FloatVector()->data();
-				
-				for (int value_index = 0; value_index < second_child_count; ++value_index)
-					logical_result->set_logical_no_check(float1 != float_data[value_index], value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueInt) && (second_child_type == EidosValueType::kValueInt))
-			{
-				// Direct int-to-int compare can be optimized through vector access; note the singleton might get promoted to int
-				int64_t int1 = first_child_value->IntAtIndex(0, operator_token);
-				const int64_t *int_data = second_child_value->IntVector()->data();
-				
-				for (int value_index = 0; value_index < second_child_count; ++value_index)
-					logical_result->set_logical_no_check(int1 != int_data[value_index], value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
+			if ((promotion_type == EidosValueType::kValueObject) && (second_child_type == EidosValueType::kValueObject))
 			{
 				// Direct object-to-object compare can be optimized through vector access
 				EidosObject *obj1 = first_child_value->ObjectElementAtIndex(0, operator_token);
@@ -5003,25 +5576,7 @@ EidosValue_SP EidosInterpreter::Evaluate_NotEq(const EidosASTNode *p_node)
 			EidosValue_Logical_SP logical_result_SP = EidosValue_Logical_SP(new (gEidosValuePool->AllocateChunk()) EidosValue_Logical());
 			EidosValue_Logical *logical_result = logical_result_SP->resize_no_initialize(first_child_count);
 			
-			if ((promotion_type == EidosValueType::kValueFloat) && (first_child_type == EidosValueType::kValueFloat))
-			{
-				// Direct float-to-float compare can be optimized through vector access; note the singleton might get promoted to float
-				double float2 = second_child_value->FloatAtIndex(0, operator_token);
-				const double *float_data = first_child_value->FloatVector()->data();
-				
-				for (int value_index = 0; value_index < first_child_count; ++value_index)
-					logical_result->set_logical_no_check(float_data[value_index] != float2, value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueInt) && (first_child_type == EidosValueType::kValueInt))
-			{
-				// Direct int-to-int compare can be optimized through vector access; note the singleton might get promoted to int
-				int64_t int2 = second_child_value->IntAtIndex(0, operator_token);
-				const int64_t *int_data = first_child_value->IntVector()->data();
-				
-				for (int value_index = 0; value_index < first_child_count; ++value_index)
-					logical_result->set_logical_no_check(int_data[value_index] != int2, value_index);
-			}
-			else if ((promotion_type == EidosValueType::kValueObject) && (first_child_type == EidosValueType::kValueObject))
+			if ((promotion_type == EidosValueType::kValueObject) && (first_child_type == EidosValueType::kValueObject))
 			{
 				// Direct object-to-object compare can be optimized through vector access
 				EidosObject *obj2 = second_child_value->ObjectElementAtIndex(0, operator_token);
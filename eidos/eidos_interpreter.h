@@ -39,6 +39,10 @@
 #include "eidos_ast_node.h"
 
 class EidosCallSignature;
+struct EidosFusedNode;
+
+// The maximum number of nodes, including leaves, in an expression evaluated by EidosInterpreter::_EvaluateFusedReduction()
+#define EIDOS_FUSED_MAX_NODES		16
 
 
 // EidosInterpreter keeps track of the EidosContext object that is in charge of the whole show.  This should
@@ -248,6 +252,11 @@ public:
 	void _LogCallArguments(const EidosCallSignature *call_signature, std::vector<EidosValue_SP> *argument_buffer);
 #endif
 	
+	// Fused evaluation of reductions like sum(x * y), for call nodes marked by EidosASTNode::_OptimizeFusedReductions(); returns false
+	// if the operands turn out not to be handled, in which case the call should be evaluated normally
+	bool _EvaluateFusedReduction(const EidosASTNode *p_node, const EidosFunctionSignature *p_function_signature, EidosValue_SP &p_result_SP);
+	int _BuildFusedNode(const EidosASTNode *p_node, EidosFusedNode *p_nodes, int *p_node_count, EidosValue_SP *p_leaf_values, int *p_length);
+	
 	EidosValue_SP DispatchUserDefinedFunction(const EidosFunctionSignature &p_function_signature, const std::vector<EidosValue_SP> &p_arguments);
 	
 	void NullReturnRaiseForNode(const EidosASTNode *p_node);
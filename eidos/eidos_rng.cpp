@@ -124,6 +124,51 @@ double Eidos_FastRandomPoisson_PRECALCULATE(double p_mu)
 #endif
 
 
+#pragma mark -
+#pragma mark Counter-based keyed streams
+#pragma mark -
+
+// The SplitMix64 finalizer (Steele, Lea & Flood 2014), a bijection on 64-bit values with good avalanche behavior; we use it
+// to turn seeds and generation numbers into Philox keys, so that nearby seeds do not produce related keys.
+static inline uint64_t Eidos_SplitMix64(uint64_t p_x)
+{
+	p_x += 0x9E3779B97F4A7C15ULL;
+	p_x = (p_x ^ (p_x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	p_x = (p_x ^ (p_x >> 27)) * 0x94D049BB133111EBULL;
+	return p_x ^ (p_x >> 31);
+}
+
+static void _Eidos_SetRNGStreamKeyAndID(Eidos_RNG_Stream &p_stream, uint64_t p_key, uint64_t p_stream_id)
+{
+	p_stream.key_.v[0] = (uint32_t)p_key;
+	p_stream.key_.v[1] = (uint32_t)(p_key >> 32);
+	
+	p_stream.counter_.v[0] = 0;
+	p_stream.counter_.v[1] = 0;
+	p_stream.counter_.v[2] = (uint32_t)p_stream_id;
+	p_stream.counter_.v[3] = (uint32_t)(p_stream_id >> 32);
+	
+	p_stream.block_index_ = 4;		// no block generated yet
+	
+	p_stream.random_bool_bit_counter_ = 0;
+	p_stream.random_bool_bit_buffer_ = 0;
+}
+
+void Eidos_InitializeRNGStream(Eidos_RNG_Stream &p_stream, uint64_t p_seed, uint64_t p_stream_id)
+{
+	_Eidos_SetRNGStreamKeyAndID(p_stream, Eidos_SplitMix64(p_seed), p_stream_id);
+}
+
+void Eidos_InitializeRNGStreamForIndividual(Eidos_RNG_Stream &p_stream, uint64_t p_seed, int64_t p_generation, int32_t p_subpop_id, int32_t p_index)
+{
+	// SplitMix64 is a bijection, so for a given seed every generation gets a distinct key
+	uint64_t key = Eidos_SplitMix64(p_seed ^ Eidos_SplitMix64((uint64_t)p_generation));
+	uint64_t stream_id = ((uint64_t)(uint32_t)p_subpop_id << 32) | (uint64_t)(uint32_t)p_index;
+	
+	_Eidos_SetRNGStreamKeyAndID(p_stream, key, stream_id);
+}
+
+
 #pragma mark -
 #pragma mark 64-bit MT
 #pragma mark -
@@ -450,6 +450,219 @@ static inline __attribute__((always_inline)) bool Eidos_RandomBool()
 }
 
 
+#pragma mark -
+#pragma mark Counter-based keyed streams
+#pragma mark -
+
+// The generators above are sequential: each draw advances one shared state, so the result of any given draw depends upon
+// every draw that came before it, in every part of the program.  That makes it impossible to hand out draws to independent
+// pieces of work (individuals, subpopulations, worker threads) without the outcome depending upon the order in which the
+// work is done.  Counter-based generators solve that problem: a draw is a pure function of a key and a counter, so any
+// number of independent streams can be derived from a single seed, each reproducible regardless of what other streams do.
+// We use Philox4x32-10 from Salmon, Moraes, Dror & Shaw (2011), "Parallel random numbers: as easy as 1, 2, 3" (SC11),
+// which passes BigCrush and is cheap enough to use in inner loops; this implementation is checked against the known-answer
+// vectors distributed with their Random123 library (see _RunRNGStreamTests()).  These streams are entirely separate from
+// gEidos_RNG; using them does not advance or otherwise disturb the main RNG state.
+
+typedef struct
+{
+	uint32_t v[4];
+} Eidos_Philox4x32_ctr_t;
+
+typedef struct
+{
+	uint32_t v[2];
+} Eidos_Philox4x32_key_t;
+
+#define Eidos_PHILOX_M4x32_0	((uint32_t)0xD2511F53)
+#define Eidos_PHILOX_M4x32_1	((uint32_t)0xCD9E8D57)
+#define Eidos_PHILOX_W32_0		((uint32_t)0x9E3779B9)
+#define Eidos_PHILOX_W32_1		((uint32_t)0xBB67AE85)
+
+inline __attribute__((always_inline)) void _Eidos_Philox4x32_round(Eidos_Philox4x32_ctr_t &p_ctr, const Eidos_Philox4x32_key_t &p_key)
+{
+	uint64_t product0 = (uint64_t)Eidos_PHILOX_M4x32_0 * p_ctr.v[0];
+	uint64_t product1 = (uint64_t)Eidos_PHILOX_M4x32_1 * p_ctr.v[2];
+	uint32_t hi0 = (uint32_t)(product0 >> 32), lo0 = (uint32_t)product0;
+	uint32_t hi1 = (uint32_t)(product1 >> 32), lo1 = (uint32_t)product1;
+	
+	p_ctr.v[0] = hi1 ^ p_ctr.v[1] ^ p_key.v[0];
+	p_ctr.v[1] = lo1;
+	p_ctr.v[2] = hi0 ^ p_ctr.v[3] ^ p_key.v[1];
+	p_ctr.v[3] = lo0;
+}
+
+// the Philox4x32-10 bijection: encrypt p_ctr under p_key, producing 128 random bits
+inline __attribute__((always_inline)) Eidos_Philox4x32_ctr_t Eidos_Philox4x32_10(Eidos_Philox4x32_ctr_t p_ctr, Eidos_Philox4x32_key_t p_key)
+{
+	_Eidos_Philox4x32_round(p_ctr, p_key);
+	
+	for (int round = 1; round < 10; ++round)
+	{
+		p_key.v[0] += Eidos_PHILOX_W32_0;
+		p_key.v[1] += Eidos_PHILOX_W32_1;
+		_Eidos_Philox4x32_round(p_ctr, p_key);
+	}
+	
+	return p_ctr;
+}
+
+// An Eidos_RNG_Stream is one keyed stream of random numbers.  The key is derived from the seed; the high 64 bits of the
+// counter hold the stream identifier, and the low 64 bits count the 128-bit blocks drawn so far, so 2^64 distinct streams
+// with 2^68 bits each can be drawn under a single seed without any overlap.  Streams are small plain structs; they can be
+// created on the stack in large numbers, copied, and used from any thread, since each one owns all of its state.
+typedef struct Eidos_RNG_Stream
+{
+	Eidos_Philox4x32_key_t key_;
+	Eidos_Philox4x32_ctr_t counter_;
+	uint32_t block_[4];					// the most recently generated block of output
+	int block_index_;					// the next unused word in block_; 4 means the block is used up
+	
+	// random coin-flip bits, as for the main RNG; see Eidos_RandomBool()
+	int random_bool_bit_counter_;
+	uint64_t random_bool_bit_buffer_;
+} Eidos_RNG_Stream;
+
+// Set up p_stream as stream number p_stream_id under p_seed; any two streams with different ids are independent
+void Eidos_InitializeRNGStream(Eidos_RNG_Stream &p_stream, uint64_t p_seed, uint64_t p_stream_id);
+
+// Set up p_stream for the work associated with a particular individual: index p_index within subpopulation p_subpop_id, in
+// generation p_generation, under p_seed.  The generation is mixed into the key, and the subpopulation and index form the
+// stream identifier, so the streams of distinct individuals within a generation are guaranteed never to overlap.  Any
+// of the three may be -1 (or any other fixed value) to derive streams for coarser units of work, such as a whole subpop.
+void Eidos_InitializeRNGStreamForIndividual(Eidos_RNG_Stream &p_stream, uint64_t p_seed, int64_t p_generation, int32_t p_subpop_id, int32_t p_index);
+
+inline __attribute__((always_inline)) uint32_t Eidos_RNGStream_uint32(Eidos_RNG_Stream &p_stream)
+{
+	if (p_stream.block_index_ >= 4)
+	{
+		Eidos_Philox4x32_ctr_t block = Eidos_Philox4x32_10(p_stream.counter_, p_stream.key_);
+		
+		p_stream.block_[0] = block.v[0];
+		p_stream.block_[1] = block.v[1];
+		p_stream.block_[2] = block.v[2];
+		p_stream.block_[3] = block.v[3];
+		p_stream.block_index_ = 0;
+		
+		// advance the 64-bit block counter in the low words; the stream identifier in the high words is untouched
+		if (++p_stream.counter_.v[0] == 0)
+			++p_stream.counter_.v[1];
+	}
+	
+	return p_stream.block_[p_stream.block_index_++];
+}
+
+inline __attribute__((always_inline)) uint64_t Eidos_RNGStream_uint64(Eidos_RNG_Stream &p_stream)
+{
+	uint64_t hi = Eidos_RNGStream_uint32(p_stream);
+	uint64_t lo = Eidos_RNGStream_uint32(p_stream);
+	
+	return (hi << 32) | lo;
+}
+
+// a draw in [0, 1), with the same 32-bit resolution as Eidos_rng_uniform()
+inline __attribute__((always_inline)) double Eidos_RNGStream_uniform(Eidos_RNG_Stream &p_stream)
+{
+	return Eidos_RNGStream_uint32(p_stream) / 4294967296.0;
+}
+
+// a draw in (0, 1), parallel to Eidos_rng_uniform_pos()
+inline __attribute__((always_inline)) double Eidos_RNGStream_uniform_pos(Eidos_RNG_Stream &p_stream)
+{
+	double x;
+	
+	do
+	{
+		x = Eidos_RNGStream_uint32(p_stream) / 4294967296.0;
+	}
+	while (x == 0);
+	
+	return x;
+}
+
+// an unbiased draw in [0, p_n - 1], using the same rejection scheme as Eidos_rng_uniform_int()
+inline __attribute__((always_inline)) uint32_t Eidos_RNGStream_uniform_int(Eidos_RNG_Stream &p_stream, uint32_t p_n)
+{
+	uint32_t scale = UINT32_MAX / p_n;
+	uint32_t k;
+	
+	do
+	{
+		k = Eidos_RNGStream_uint32(p_stream) / scale;
+	}
+	while (k >= p_n);
+	
+	return k;
+}
+
+// a coin flip, using each bit of the stream's output once; parallel to Eidos_RandomBool()
+inline __attribute__((always_inline)) bool Eidos_RNGStream_RandomBool(Eidos_RNG_Stream &p_stream)
+{
+	if (p_stream.random_bool_bit_counter_ > 0)
+	{
+		p_stream.random_bool_bit_counter_--;
+		p_stream.random_bool_bit_buffer_ >>= 1;
+	}
+	else
+	{
+		p_stream.random_bool_bit_buffer_ = Eidos_RNGStream_uint64(p_stream);
+		p_stream.random_bool_bit_counter_ = 63;
+	}
+	
+	return p_stream.random_bool_bit_buffer_ & 0x01;
+}
+
+#ifndef USE_GSL_POISSON
+// a Poisson draw given a precalculated exp(-mu); the same algorithm as Eidos_FastRandomPoisson(), except that for mu > 250
+// we use the PTRS transformed rejection sampler of Hörmann (1993) rather than deferring to the GSL, which can only draw from
+// gEidos_RNG; like the inversion below, PTRS is exact, not an approximation.  The constants are from Hörmann's paper.
+inline unsigned int Eidos_RNGStream_FastRandomPoisson(Eidos_RNG_Stream &p_stream, double p_mu, double p_exp_neg_mu)
+{
+	if (p_mu > 250)
+	{
+		double sqrt_mu = sqrt(p_mu);
+		double log_mu = log(p_mu);
+		double b = 0.931 + 2.53 * sqrt_mu;
+		double a = -0.059 + 0.02483 * b;
+		double log_inv_alpha = log(1.1239 + 1.1328 / (b - 3.4));
+		double v_r = 0.9277 - 3.6224 / (b - 2);
+		
+		while (true)
+		{
+			double u = Eidos_RNGStream_uniform(p_stream) - 0.5;
+			double v = Eidos_RNGStream_uniform(p_stream);
+			double us = 0.5 - std::abs(u);
+			double k = floor((2 * a / us + b) * u + p_mu + 0.43);
+			
+			// the squeeze accepts most draws without evaluating the Poisson density
+			if ((us >= 0.07) && (v <= v_r))
+				return (unsigned int)k;
+			
+			if ((k < 0) || ((us < 0.013) && (v > us)))
+				continue;
+			
+			if (log(v) + log_inv_alpha - log(a / (us * us) + b) <= -p_mu + k * log_mu - std::lgamma(k + 1))
+				return (unsigned int)k;
+		}
+	}
+	
+	unsigned int x = 0;
+	double p = p_exp_neg_mu;
+	double s = p;
+	double u = Eidos_RNGStream_uniform(p_stream);
+	
+	while (u > s)
+	{
+		++x;
+		p *= (p_mu / x);
+		s += p;
+	}
+	
+	return x;
+}
+#endif // USE_GSL_POISSON
+
+
 #endif /* defined(__Eidos__eidos_rng__) */
 
 
@@ -48,6 +48,8 @@ size_t MemoryUsageForSymbolTables(EidosSymbolTable *p_currentTable)
 	
 	while (p_currentTable)
 	{
+		// each table has its compact slot storage inside the table object, whether or not it is in use, plus any pooled lookup table
+		usage += sizeof(p_currentTable->compact_slots_);
 		usage += p_currentTable->capacity_ * sizeof(EidosSymbolTableSlot);
 		p_currentTable = p_currentTable->parent_symbol_table_;
 	}
@@ -122,8 +124,17 @@ void FreeSymbolTablePool(void)
 EidosSymbolTable::EidosSymbolTable(EidosSymbolTableType p_table_type, EidosSymbolTable *p_parent_table) : table_type_(p_table_type),
 	table_type_is_constant_((p_table_type != EidosSymbolTableType::kGlobalVariablesTable) && (p_table_type != EidosSymbolTableType::kLocalVariablesTable))
 {
-	// allocate the lookup table
-	slots_ = GetZeroedTableFromPool(&capacity_);
+	// allocate the lookup table; local variables tables and context constants tables, which are typically small and
+	// short-lived (function calls and callbacks), start out compact instead and only get a lookup table if they need it
+	if ((table_type_ == EidosSymbolTableType::kLocalVariablesTable) || (table_type_ == EidosSymbolTableType::kContextConstantsTable))
+	{
+		slots_ = nullptr;
+		capacity_ = 0;
+	}
+	else
+	{
+		slots_ = GetZeroedTableFromPool(&capacity_);
+	}
 	
 	if (!p_parent_table)
 	{
@@ -194,19 +205,26 @@ EidosSymbolTable::~EidosSymbolTable(void)
 	
 	table_type_ = EidosSymbolTableType::kINVALID_TABLE_TYPE;
 	
-	// slots_ may have symbols defined in it, so we need to zero out the used slots for re-use.  Remember that
-	// the slot at index 0 never has a value defined, and its next_ value is the start of the linked list.
-	EidosSymbolTableSlot *slot = slots_;
-	
-	for (uint32_t index = slot->next_; index != 0; index = slot->next_)
+	if (slots_)
 	{
-		slot->next_ = 0;
-		slot = slots_ + index;
-		slot->symbol_value_SP_.reset();
+		// slots_ may have symbols defined in it, so we need to zero out the used slots for re-use.  Remember that
+		// the slot at index 0 never has a value defined, and its next_ value is the start of the linked list.
+		EidosSymbolTableSlot *slot = slots_;
+		
+		for (uint32_t index = slot->next_; index != 0; index = slot->next_)
+		{
+			slot->next_ = 0;
+			slot = slots_ + index;
+			slot->symbol_value_SP_.reset();
+		}
+		
+		// then return the table to the pools for reuse
+		FreeZeroedTableToPool(slots_, capacity_);
 	}
 	
-	// then return the table to the pools for reuse
-	FreeZeroedTableToPool(slots_, capacity_);
+	// compact_slots_ is constructed only as it is used, so we destruct the used slots ourselves
+	for (uint32_t index = 0; index < compact_count_; ++index)
+		compact_slots_[index].symbol_value_SP_.~EidosValue_SP();
 	
 	// In general, every symbol table has its own lifetime, and a single table might be the parent table for many other
 	// symbol tables (in the way that the intrinsic constants table is used as the root parent for all symbol table
@@ -238,8 +256,17 @@ std::vector<std::string> EidosSymbolTable::_SymbolNames(bool p_include_constants
 	if ((p_include_constants && table_type_is_constant_) ||
 		(p_include_variables && !table_type_is_constant_))
 	{
-		for (EidosGlobalStringID symbol = slots_->next_; symbol != 0; symbol = (slots_ + symbol)->next_)
-			symbol_names.emplace_back(EidosStringRegistry::StringForGlobalStringID(symbol));
+		if (slots_)
+		{
+			for (EidosGlobalStringID symbol = slots_->next_; symbol != 0; symbol = (slots_ + symbol)->next_)
+				symbol_names.emplace_back(EidosStringRegistry::StringForGlobalStringID(symbol));
+		}
+		else
+		{
+			// newest first, like the linked list of a lookup table
+			for (uint32_t index = compact_count_; index-- > 0; )
+				symbol_names.emplace_back(EidosStringRegistry::StringForGlobalStringID(compact_slots_[index].next_));
+		}
 	}
 	
 	return symbol_names;
@@ -254,8 +281,8 @@ bool EidosSymbolTable::ContainsSymbol(EidosGlobalStringID p_symbol_name) const
 	
 	do
 	{
-		// try the current table, if the symbol is within its capacity
-		if ((p_symbol_name < current_table->capacity_) && (current_table->slots_[p_symbol_name].symbol_value_SP_))
+		// try the current table
+		if (current_table->_SlotForSymbol(p_symbol_name))
 			return true;
 		
 		// We didn't get a hit, so try our chained table
@@ -273,8 +300,8 @@ bool EidosSymbolTable::ContainsSymbol_IsConstant(EidosGlobalStringID p_symbol_na
 	
 	do
 	{
-		// try the current table, if the symbol is within its capacity
-		if ((p_symbol_name < current_table->capacity_) && (current_table->slots_[p_symbol_name].symbol_value_SP_))
+		// try the current table
+		if (current_table->_SlotForSymbol(p_symbol_name))
 		{
 			*p_is_const = current_table->table_type_is_constant_;
 			return true;
@@ -296,8 +323,8 @@ bool EidosSymbolTable::SymbolDefinedAnywhere(EidosGlobalStringID p_symbol_name)
 	
 	do
 	{
-		// try the current table, if the symbol is within its capacity
-		if ((p_symbol_name < current_table->capacity_) && (current_table->slots_[p_symbol_name].symbol_value_SP_))
+		// try the current table
+		if (current_table->_SlotForSymbol(p_symbol_name))
 			return true;
 		
 		// We didn't get a hit, so try our parent table
@@ -316,14 +343,11 @@ EidosValue_SP EidosSymbolTable::_GetValue(EidosGlobalStringID p_symbol_name, con
 	
 	do
 	{
-		// try the current table, if the symbol is within its capacity
-		if (p_symbol_name < current_table->capacity_)
-		{
-			EidosValue_SP slot_value(current_table->slots_[p_symbol_name].symbol_value_SP_);
-			
-			if (slot_value)
-				return slot_value;
-		}
+		// try the current table
+		EidosSymbolTableSlot *slot = current_table->_SlotForSymbol(p_symbol_name);
+		
+		if (slot)
+			return slot->symbol_value_SP_;
 		
 		// We didn't get a hit, so try our chained table
 		current_table = current_table->chain_symbol_table_;
@@ -340,14 +364,11 @@ EidosValue *EidosSymbolTable::_GetValue_RAW(EidosGlobalStringID p_symbol_name, c
 	
 	do
 	{
-		// try the current table, if the symbol is within its capacity
-		if (p_symbol_name < current_table->capacity_)
-		{
-			EidosValue *slot_value = current_table->slots_[p_symbol_name].symbol_value_SP_.get();
-			
-			if (slot_value)
-				return slot_value;
-		}
+		// try the current table
+		EidosSymbolTableSlot *slot = current_table->_SlotForSymbol(p_symbol_name);
+		
+		if (slot)
+			return slot->symbol_value_SP_.get();
 		
 		// We didn't get a hit, so try our chained table
 		current_table = current_table->chain_symbol_table_;
@@ -364,16 +385,13 @@ EidosValue_SP EidosSymbolTable::_GetValue_IsConst(EidosGlobalStringID p_symbol_n
 	
 	do
 	{
-		// try the current table, if the symbol is within its capacity
-		if (p_symbol_name < current_table->capacity_)
+		// try the current table
+		EidosSymbolTableSlot *slot = current_table->_SlotForSymbol(p_symbol_name);
+		
+		if (slot)
 		{
-			EidosValue_SP slot_value(current_table->slots_[p_symbol_name].symbol_value_SP_);
-			
-			if (slot_value)
-			{
-				*p_is_const = current_table->table_type_is_constant_;
-				return slot_value;
-			}
+			*p_is_const = current_table->table_type_is_constant_;
+			return slot->symbol_value_SP_;
 		}
 		
 		// We didn't get a hit, so try our chained table
@@ -407,20 +425,93 @@ void EidosSymbolTable::_ResizeToFitSymbol(EidosGlobalStringID p_symbol_name)
 		EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_ResizeToFitSymbol): (internal error) unnecessary resize." << EidosTerminate();
 }
 
+void EidosSymbolTable::_ConvertCompactTable(void)
+{
+	// Get a lookup table from the pool and move our compact symbols into it, oldest first so the linked list ends up newest first
+	slots_ = GetZeroedTableFromPool(&capacity_);
+	
+	for (uint32_t index = 0; index < compact_count_; ++index)
+	{
+		EidosSymbolTableSlot *compact_slot = compact_slots_ + index;
+		EidosGlobalStringID symbol = compact_slot->next_;
+		
+		if (symbol >= capacity_)
+			_ResizeToFitSymbol(symbol);
+		
+		slots_[symbol].symbol_value_SP_ = std::move(compact_slot->symbol_value_SP_);
+		slots_[symbol].next_ = slots_[0].next_;
+		slots_[0].next_ = symbol;
+		
+		compact_slot->symbol_value_SP_.~EidosValue_SP();
+	}
+	
+	compact_count_ = 0;
+}
+
+EidosSymbolTableSlot *EidosSymbolTable::_AddSlotForSymbol(EidosGlobalStringID p_symbol_name)
+{
+	// Returns a new, empty slot for a symbol that is not defined in this table; the caller must set a value into it
+	if (!slots_)
+	{
+		if (compact_count_ < EIDOS_SYMBOL_TABLE_COMPACT_CAPACITY)
+		{
+			EidosSymbolTableSlot *slot = compact_slots_ + compact_count_++;
+			
+			new (&slot->symbol_value_SP_) EidosValue_SP();
+			slot->next_ = p_symbol_name;
+			return slot;
+		}
+		
+		_ConvertCompactTable();
+	}
+	
+	// Make sure we have capacity
+	if (p_symbol_name >= capacity_)
+		_ResizeToFitSymbol(p_symbol_name);
+	
+	// Add the slot to the front of the linked list
+	EidosSymbolTableSlot *slot = slots_ + p_symbol_name;
+	
+	slot->next_ = slots_[0].next_;
+	slots_[0].next_ = p_symbol_name;
+	return slot;
+}
+
+std::vector<std::pair<EidosGlobalStringID, EidosValue *>> EidosSymbolTable::_SymbolsAndValues(void) const
+{
+	// The symbols defined in this table (not the chain), newest first, for the slow paths that enumerate them
+	std::vector<std::pair<EidosGlobalStringID, EidosValue *>> symbols;
+	
+	if (slots_)
+	{
+		for (EidosGlobalStringID symbol = slots_->next_; symbol != 0; symbol = (slots_ + symbol)->next_)
+			symbols.emplace_back(symbol, (slots_ + symbol)->symbol_value_SP_.get());
+	}
+	else
+	{
+		for (uint32_t index = compact_count_; index-- > 0; )
+			symbols.emplace_back(compact_slots_[index].next_, compact_slots_[index].symbol_value_SP_.get());
+	}
+	
+	return symbols;
+}
+
 void EidosSymbolTable::SetValueForSymbol(EidosGlobalStringID p_symbol_name, EidosValue_SP p_value)
 {
 	// If we have the only reference to the value, we don't need to copy it; otherwise we copy, since we don't want to hold
 	// onto a reference that somebody else might modify under us (or that we might modify under them, with syntaxes like
 	// x[2]=...; and x=x+1;). If the value is invisible then we copy it, since the symbol table never stores invisible values.
-	if ((p_value->UseCount() != 1) || p_value->Invisible())
+	// A value marked copy-on-write is shared instead, since its owners all copy it before modifying it; and a value that we
+	// end up owning uniquely gets marked, so that later assignments from it (y=x;, or passing it to a function) can share it.
+	if ((!p_value->CopyOnWrite() && (p_value->UseCount() != 1)) || p_value->Invisible())
 		p_value = p_value->CopyValues();
+	if (p_value->UseCount() == 1)
+		p_value->SetCopyOnWrite();
 	
-	// Make sure we have capacity
-	if (p_symbol_name >= capacity_)
-		_ResizeToFitSymbol(p_symbol_name);
+	EidosSymbolTableSlot *slot = _SlotForSymbol(p_symbol_name);
 	
 	// Define the symbol if it is not already defined above us
-	if (!slots_[p_symbol_name].symbol_value_SP_)
+	if (!slot)
 	{
 		// The symbol is not already defined in this table.  Before we can define it, we need to check that it is not a constant in a chained table.
 		bool is_const;
@@ -429,16 +520,11 @@ void EidosSymbolTable::SetValueForSymbol(EidosGlobalStringID p_symbol_name, Eido
 			if (is_const)
 				EIDOS_TERMINATION << "ERROR (EidosSymbolTable::SetValueForSymbol): identifier '" << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "' cannot be redefined because it is a constant." << EidosTerminate(nullptr);
 		
-		// set the value into the unused slot and add it to the front of the linked list
-		slots_[p_symbol_name].symbol_value_SP_ = std::move(p_value);
-		slots_[p_symbol_name].next_ = slots_[0].next_;
-		slots_[0].next_ = p_symbol_name;
-	}
-	else
-	{
-		// set the value into the already used slot; no linked list maintenance needed
-		slots_[p_symbol_name].symbol_value_SP_ = std::move(p_value);
+		// make a new slot for the symbol, adding it to the front of the linked list (or the end of the compact slots)
+		slot = _AddSlotForSymbol(p_symbol_name);
 	}
+	
+	slot->symbol_value_SP_ = std::move(p_value);
 }
 
 void EidosSymbolTable::SetValueForSymbolNoCopy(EidosGlobalStringID p_symbol_name, EidosValue_SP p_value)
@@ -453,12 +539,10 @@ void EidosSymbolTable::SetValueForSymbolNoCopy(EidosGlobalStringID p_symbol_name
 	if (p_value->Invisible())
 		EIDOS_TERMINATION << "ERROR (EidosSymbolTable::SetValueForSymbolNoCopy): (internal) no copy requested with invisible value." << EidosTerminate(nullptr);
 	
-	// Make sure we have capacity
-	if (p_symbol_name >= capacity_)
-		_ResizeToFitSymbol(p_symbol_name);
+	EidosSymbolTableSlot *slot = _SlotForSymbol(p_symbol_name);
 	
 	// Define the symbol if it is not already defined above us
-	if (!slots_[p_symbol_name].symbol_value_SP_)
+	if (!slot)
 	{
 		// The symbol is not already defined in this table.  Before we can define it, we need to check that it is not defined in a chained table.
 		// At present, we assume that if it is defined in a chained table it is a constant, which is true for now.
@@ -468,16 +552,40 @@ void EidosSymbolTable::SetValueForSymbolNoCopy(EidosGlobalStringID p_symbol_name
 			if (is_const)
 				EIDOS_TERMINATION << "ERROR (EidosSymbolTable::SetValueForSymbolNoCopy): identifier '" << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "' cannot be redefined because it is a constant." << EidosTerminate(nullptr);
 		
-		// set the value into the unused slot and add it to the front of the linked list
-		slots_[p_symbol_name].symbol_value_SP_ = std::move(p_value);
-		slots_[p_symbol_name].next_ = slots_[0].next_;
-		slots_[0].next_ = p_symbol_name;
+		// make a new slot for the symbol, adding it to the front of the linked list (or the end of the compact slots)
+		slot = _AddSlotForSymbol(p_symbol_name);
 	}
-	else
+	
+	slot->symbol_value_SP_ = std::move(p_value);
+}
+
+void EidosSymbolTable::_UnshareValueForSymbol(EidosGlobalStringID p_symbol_name, EidosValue_SP &p_value)
+{
+	// The value is marked copy-on-write and somebody besides the table and the caller holds a reference to it, so the caller
+	// may not modify it in place.  We find the table that defines the symbol, following the same search as _GetValue(), and
+	// replace its value there with a private copy, so that the modification is seen by the symbol and nobody else.
+	EidosSymbolTable *current_table = this;
+	
+	do
 	{
-		// set the value into the already used slot; no linked list maintenance needed
-		slots_[p_symbol_name].symbol_value_SP_ = std::move(p_value);
+		EidosSymbolTableSlot *slot = current_table->_SlotForSymbol(p_symbol_name);
+		
+		if (slot)
+		{
+			if (slot->symbol_value_SP_ != p_value)
+				EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_UnshareValueForSymbol): (internal error) value does not match the symbol table." << EidosTerminate(nullptr);
+			
+			p_value = p_value->CopyValues();
+			p_value->SetCopyOnWrite();
+			slot->symbol_value_SP_ = p_value;
+			return;
+		}
+		
+		current_table = current_table->chain_symbol_table_;
 	}
+	while (current_table);
+	
+	EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_UnshareValueForSymbol): (internal error) undefined identifier " << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "." << EidosTerminate(nullptr);
 }
 
 void EidosSymbolTable::DefineConstantForSymbol(EidosGlobalStringID p_symbol_name, EidosValue_SP p_value)
@@ -532,8 +640,12 @@ void EidosSymbolTable::DefineConstantForSymbol(EidosGlobalStringID p_symbol_name
 	// If we have the only reference to the value, we don't need to copy it; otherwise we copy, since we don't want to hold
 	// onto a reference that somebody else might modify under us (or that we might modify under them, with syntaxes like
 	// x[2]=...; and x=x+1;). If the value is invisible then we copy it, since the symbol table never stores invisible values.
-	if ((p_value->UseCount() != 1) || p_value->Invisible())
+	// A value marked copy-on-write is shared instead, since its owners all copy it before modifying it; and a value that we
+	// end up owning uniquely gets marked, so that later assignments from it (y=x;, or passing it to a function) can share it.
+	if ((!p_value->CopyOnWrite() && (p_value->UseCount() != 1)) || p_value->Invisible())
 		p_value = p_value->CopyValues();
+	if (p_value->UseCount() == 1)
+		p_value->SetCopyOnWrite();
 	
 	// Then ask the defined constants table to add the constant
 	definedConstantsTable->InitializeConstantSymbolEntry(p_symbol_name, std::move(p_value));
@@ -553,15 +665,18 @@ void EidosSymbolTable::DefineGlobalForSymbol(EidosGlobalStringID p_symbol_name,
 	// If we have the only reference to the value, we don't need to copy it; otherwise we copy, since we don't want to hold
 	// onto a reference that somebody else might modify under us (or that we might modify under them, with syntaxes like
 	// x[2]=...; and x=x+1;). If the value is invisible then we copy it, since the symbol table never stores invisible values.
-	if ((p_value->UseCount() != 1) || p_value->Invisible())
+	// A value marked copy-on-write is shared instead, since its owners all copy it before modifying it; and a value that we
+	// end up owning uniquely gets marked, so that later assignments from it (y=x;, or passing it to a function) can share it.
+	if ((!p_value->CopyOnWrite() && (p_value->UseCount() != 1)) || p_value->Invisible())
 		p_value = p_value->CopyValues();
+	if (p_value->UseCount() == 1)
+		p_value->SetCopyOnWrite();
 	
-	// Make sure we have capacity; note this acts on global_variables_table, not this
-	if (p_symbol_name >= global_variables_table->capacity_)
-		global_variables_table->_ResizeToFitSymbol(p_symbol_name);
+	// Note this acts on global_variables_table, not this
+	EidosSymbolTableSlot *slot = global_variables_table->_SlotForSymbol(p_symbol_name);
 	
 	// Define the symbol if it is not already defined above us
-	if (!global_variables_table->slots_[p_symbol_name].symbol_value_SP_)
+	if (!slot)
 	{
 		// The symbol is not already defined in global_variables_table.  Before we can define it, we need to check that it is
 		// not a constant in a chained table (from this, not from global_variables_table, since constants tables might intervene).
@@ -571,58 +686,66 @@ void EidosSymbolTable::DefineGlobalForSymbol(EidosGlobalStringID p_symbol_name,
 			if (is_const)
 				EIDOS_TERMINATION << "ERROR (EidosSymbolTable::DefineGlobalForSymbol): identifier '" << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "' cannot be redefined because it is a constant." << EidosTerminate(nullptr);
 		
-		// set the value into the unused slot and add it to the front of the linked list; note this acts on global_variables_table, not this
-		global_variables_table->slots_[p_symbol_name].symbol_value_SP_ = std::move(p_value);
-		global_variables_table->slots_[p_symbol_name].next_ = global_variables_table->slots_[0].next_;
-		global_variables_table->slots_[0].next_ = p_symbol_name;
-	}
-	else
-	{
-		// set the value into the already used slot; no linked list maintenance needed
-		global_variables_table->slots_[p_symbol_name].symbol_value_SP_ = std::move(p_value);
+		// make a new slot for the symbol, adding it to the front of the linked list; note this acts on global_variables_table, not this
+		slot = global_variables_table->_AddSlotForSymbol(p_symbol_name);
 	}
+	
+	slot->symbol_value_SP_ = std::move(p_value);
 }
 
 void EidosSymbolTable::_RemoveSymbol(EidosGlobalStringID p_symbol_name, bool p_remove_constant)
 {
-	if (p_symbol_name < capacity_)
+	EidosSymbolTableSlot *slot = _SlotForSymbol(p_symbol_name);
+	
+	if (slot)
 	{
-		EidosSymbolTableSlot *slot = slots_ + p_symbol_name;
+		// We found the symbol in ourselves, so remove it unless we are a constant table
+		if (table_type_is_constant_)
+		{
+			if (table_type_ == EidosSymbolTableType::kEidosIntrinsicConstantsTable)
+				EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_RemoveSymbol): identifier '" << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "' is an intrinsic Eidos constant and thus cannot be removed." << EidosTerminate(nullptr);
+			if (!p_remove_constant)
+				EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_RemoveSymbol): identifier '" << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "' is a constant and thus cannot be removed." << EidosTerminate(nullptr);
+		}
 		
-		if (slot->symbol_value_SP_)
+		if (!slots_)
 		{
-			// We found the symbol in ourselves, so remove it unless we are a constant table
-			if (table_type_is_constant_)
+			// In a compact table we close up the gap, keeping the remaining symbols in order
+			EidosSymbolTableSlot *last_slot = compact_slots_ + compact_count_ - 1;
+			
+			for ( ; slot != last_slot; ++slot)
 			{
-				if (table_type_ == EidosSymbolTableType::kEidosIntrinsicConstantsTable)
-					EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_RemoveSymbol): identifier '" << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "' is an intrinsic Eidos constant and thus cannot be removed." << EidosTerminate(nullptr);
-				if (!p_remove_constant)
-					EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_RemoveSymbol): identifier '" << EidosStringRegistry::StringForGlobalStringID(p_symbol_name) << "' is a constant and thus cannot be removed." << EidosTerminate(nullptr);
+				slot->symbol_value_SP_ = std::move((slot + 1)->symbol_value_SP_);
+				slot->next_ = (slot + 1)->next_;
 			}
 			
-			slot->symbol_value_SP_.reset();
-			
-			// Now we need to fix the linked list, which is O(n): we have to find the previous entry that points to this entry
-			EidosGlobalStringID index = 0;
+			last_slot->symbol_value_SP_.~EidosValue_SP();
+			compact_count_--;
+			return;
+		}
+		
+		slot->symbol_value_SP_.reset();
+		
+		// Now we need to fix the linked list, which is O(n): we have to find the previous entry that points to this entry
+		EidosGlobalStringID index = 0;
+		
+		do
+		{
+			EidosSymbolTableSlot *search_slot = slots_ + index;
+			EidosGlobalStringID search_next = search_slot->next_;
 			
-			do
+			if (search_next == p_symbol_name)
 			{
-				EidosSymbolTableSlot *search_slot = slots_ + index;
-				EidosGlobalStringID search_next = search_slot->next_;
-				
-				if (search_next == p_symbol_name)
-				{
-					search_slot->next_ = slot->next_;
-					slot->next_ = 0;
-					break;
-				}
-				
-				index = search_next;
+				search_slot->next_ = slot->next_;
+				slot->next_ = 0;
+				break;
 			}
-			while (index != 0);
 			
-			return;
+			index = search_next;
 		}
+		while (index != 0);
+		
+		return;
 	}
 	
 	// If it wasn't defined in us, then it might be defined in the chain
@@ -639,14 +762,8 @@ void EidosSymbolTable::_InitializeConstantSymbolEntry(EidosGlobalStringID p_symb
 		EIDOS_TERMINATION << "ERROR (EidosSymbolTable::_InitializeConstantSymbolEntry): (internal error) this method should be called only on constant symbol tables." << EidosTerminate(nullptr);
 #endif
 	
-	// Make sure we have capacity
-	if (p_symbol_name >= capacity_)
-		_ResizeToFitSymbol(p_symbol_name);
-	
 	// We assume that this symbol is not yet defined, for maximal set-up speed
-	slots_[p_symbol_name].symbol_value_SP_ = std::move(p_value);
-	slots_[p_symbol_name].next_ = slots_[0].next_;
-	slots_[0].next_ = p_symbol_name;
+	_AddSlotForSymbol(p_symbol_name)->symbol_value_SP_ = std::move(p_value);
 }
 
 void EidosSymbolTable::PrintSymbolTable(std::ostream &p_outstream)
@@ -666,10 +783,10 @@ void EidosSymbolTable::PrintSymbolTable(std::ostream &p_outstream)
 	
 	p_outstream << std::endl;
 	
-	for (EidosGlobalStringID symbol = slots_->next_; symbol != 0; symbol = (slots_ + symbol)->next_)
+	for (const std::pair<EidosGlobalStringID, EidosValue *> &symbol_pair : _SymbolsAndValues())
 	{
-		const std::string &symbol_name = EidosStringRegistry::StringForGlobalStringID(symbol);
-		EidosValue *symbol_value = (slots_ + symbol)->symbol_value_SP_.get();
+		const std::string &symbol_name = EidosStringRegistry::StringForGlobalStringID(symbol_pair.first);
+		EidosValue *symbol_value = symbol_pair.second;
 		int symbol_count = symbol_value->Count();
 		
 		if (symbol_count <= 2)
@@ -690,17 +807,15 @@ void EidosSymbolTable::AddSymbolsToTypeTable(EidosTypeTable *p_type_table) const
 	if (chain_symbol_table_)
 		chain_symbol_table_->AddSymbolsToTypeTable(p_type_table);
 	
-	for (EidosGlobalStringID symbol = slots_->next_; symbol != 0; )
+	for (const std::pair<EidosGlobalStringID, EidosValue *> &symbol_pair : _SymbolsAndValues())
 	{
-		EidosSymbolTableSlot *slot = slots_ + symbol;
-		EidosValue *symbol_value = slot->symbol_value_SP_.get();
+		EidosValue *symbol_value = symbol_pair.second;
 		EidosValueType symbol_type = symbol_value->Type();
 		EidosValueMask symbol_type_mask = (1 << (int)symbol_type);
 		const EidosClass *symbol_class = ((symbol_type == EidosValueType::kValueObject) ? ((EidosValue_Object *)symbol_value)->Class() : nullptr);
 		EidosTypeSpecifier symbol_type_specifier = EidosTypeSpecifier{symbol_type_mask, symbol_class};
 		
-		p_type_table->SetTypeForSymbol(symbol, symbol_type_specifier);
-		symbol = slot->next_;
+		p_type_table->SetTypeForSymbol(symbol_pair.first, symbol_type_specifier);
 	}
 }
 
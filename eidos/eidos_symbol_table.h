@@ -77,10 +77,20 @@ typedef std::pair<EidosGlobalStringID, EidosValue_SP> EidosSymbolTableEntry;
 // value, which is O(n) because we don't have a prev_ pointer, but that is a rare operation.
 typedef struct {
 	EidosValue_SP symbol_value_SP_;			// our shared pointer to the EidosValue for the symbol
-	uint32_t next_;							// the index of the next symbol that has been defined
+	uint32_t next_;							// the index of the next symbol that has been defined (the symbol's own id, in a compact table)
 } EidosSymbolTableSlot;
 
 
+// Because string ids are global, a lookup table indexed by id has to be as large as the largest id in use,
+// which is typically a thousand or more in SLiM; that is a lot of memory for the variables table of a short-lived
+// function call or callback frame, and recursion multiplies it.  Local variables tables and context constants tables
+// therefore start out "compact": up to EIDOS_SYMBOL_TABLE_COMPACT_CAPACITY symbols are kept in a small dense array
+// inside the table object, searched linearly, with next_ holding each symbol's id.  If a compact table needs more
+// symbols than that, it converts itself to a pooled lookup table.  A compact table has slots_ == nullptr and
+// capacity_ == 0, so the lookup-table code paths never touch it; its symbols are ordered oldest to newest.
+#define EIDOS_SYMBOL_TABLE_COMPACT_CAPACITY		8
+
+
 // Symbol tables can come in various types.  This is mostly hidden from clients of this class.  The intrinsic
 // constants table holds Eidos constants like T, F, INF, and NAN.  The defined constants table, which should be
 // the direct child of the intrinsic table, holds constants defined by the user with DefineConstantForSymbol().
@@ -121,8 +131,12 @@ private:
 	EidosSymbolTableType table_type_;
 	bool table_type_is_constant_;		// based on table_type_
 	
-	EidosSymbolTableSlot *slots_;		// a lookup table indexed by EidosGlobalStringID (uint32_t); see EidosSymbolTableSlot
-	uint32_t capacity_;					// the capacity of the lookup table (max id value, not max number of variables)
+	EidosSymbolTableSlot *slots_;		// a lookup table indexed by EidosGlobalStringID (uint32_t); see EidosSymbolTableSlot; nullptr if compact
+	uint32_t capacity_;					// the capacity of the lookup table (max id value, not max number of variables); 0 if compact
+	uint32_t compact_count_ = 0;		// the number of symbols defined in compact_slots_, for a compact table
+	union {
+		EidosSymbolTableSlot compact_slots_[EIDOS_SYMBOL_TABLE_COMPACT_CAPACITY];	// symbol storage for a compact table; only the first compact_count_ are constructed
+	};
 	
 	// Symbol tables can be chained.  This is invisible to the user; there appears to be a single global symbol table for a given
 	// interpreter, which responds to all requests.  Behind the scenes, however, requests get passed up the symbol table chain
@@ -143,6 +157,27 @@ private:
 	void _RemoveSymbol(EidosGlobalStringID p_symbol_name, bool p_remove_constant);
 	void _InitializeConstantSymbolEntry(EidosGlobalStringID p_symbol_name, EidosValue_SP p_value);
 	void _ResizeToFitSymbol(EidosGlobalStringID p_symbol_name);
+	void _ConvertCompactTable(void);
+	EidosSymbolTableSlot *_AddSlotForSymbol(EidosGlobalStringID p_symbol_name);
+	std::vector<std::pair<EidosGlobalStringID, EidosValue *>> _SymbolsAndValues(void) const;
+	
+	// Find the slot defining a symbol in this table (not the chain), or nullptr; works for both lookup tables and compact tables
+	inline __attribute__((always_inline)) EidosSymbolTableSlot *_SlotForSymbol(EidosGlobalStringID p_symbol_name) const
+	{
+		if (p_symbol_name < capacity_)
+		{
+			EidosSymbolTableSlot *slot = slots_ + p_symbol_name;
+			
+			return (slot->symbol_value_SP_ ? slot : nullptr);
+		}
+		
+		for (uint32_t index = 0; index < compact_count_; ++index)
+			if (compact_slots_[index].next_ == p_symbol_name)
+				return const_cast<EidosSymbolTableSlot *>(compact_slots_ + index);
+		
+		return nullptr;
+	}
+	void _UnshareValueForSymbol(EidosGlobalStringID p_symbol_name, EidosValue_SP &p_value);
 	
 public:
 	
@@ -166,6 +201,10 @@ public:
 	void SetValueForSymbol(EidosGlobalStringID p_symbol_name, EidosValue_SP p_value);
 	void SetValueForSymbolNoCopy(EidosGlobalStringID p_symbol_name, EidosValue_SP p_value);
 	
+	// Prepare a value fetched from the table for modification in place; if the value is shared copy-on-write with another owner, it
+	// is replaced by a private copy, both in p_value and in the table that holds the symbol.  p_value must hold the fetched value.
+	inline __attribute__((always_inline)) void UnshareValueForSymbol(EidosGlobalStringID p_symbol_name, EidosValue_SP &p_value) { if (p_value->CopyOnWrite() && (p_value->UseCount() > 2)) _UnshareValueForSymbol(p_symbol_name, p_value); }
+	
 	// Set as a constant (raises if already defined as a variable or a constant); adds to the kEidosDefinedConstantsTable, creating it if necessary
 	void DefineConstantForSymbol(EidosGlobalStringID p_symbol_name, EidosValue_SP p_value);
 	
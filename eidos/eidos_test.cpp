@@ -30,6 +30,7 @@
 #include <vector>
 #include <stdexcept>
 #include <limits>
+#include <cmath>
 #include <random>
 #include <ctime>
 
@@ -303,6 +304,7 @@ int RunEidosTests(void)
 	_RunFunctionDispatchTests();
 	_RunRuntimeErrorTests();
 	_RunVectorsAndSingletonsTests();
+	_RunRNGStreamTests();
 	_RunOperatorPlusTests1();
 	_RunOperatorPlusTests2();
 	_RunOperatorMinusTests();
@@ -1274,6 +1276,141 @@ int RunEidosTests(void)
 	return (gEidosTestFailureCount > 0) ? 1 : 0;
 }
 
+#pragma mark RNG streams
+static void EidosAssertRNGStream(bool p_condition, const char *p_description)
+{
+	if (p_condition)
+	{
+		gEidosTestSuccessCount++;
+	}
+	else
+	{
+		gEidosTestFailureCount++;
+		std::cerr << p_description << " : " << EIDOS_OUTPUT_FAILURE_TAG << std::endl;
+	}
+}
+
+static bool EidosPhiloxMatches(Eidos_Philox4x32_ctr_t p_ctr, Eidos_Philox4x32_key_t p_key, uint32_t p_r0, uint32_t p_r1, uint32_t p_r2, uint32_t p_r3)
+{
+	Eidos_Philox4x32_ctr_t result = Eidos_Philox4x32_10(p_ctr, p_key);
+	
+	return ((result.v[0] == p_r0) && (result.v[1] == p_r1) && (result.v[2] == p_r2) && (result.v[3] == p_r3));
+}
+
+void _RunRNGStreamTests(void)
+{
+	// These tests are not Eidos scripts; they check the counter-based stream generator in eidos_rng.h directly.
+	// First, the Philox4x32-10 known-answer vectors from the Random123 distribution (kat_vectors).
+	EidosAssertRNGStream(EidosPhiloxMatches({{0x00000000, 0x00000000, 0x00000000, 0x00000000}}, {{0x00000000, 0x00000000}}, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8), "Eidos_Philox4x32_10() known-answer vector 1");
+	EidosAssertRNGStream(EidosPhiloxMatches({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, {{0xffffffff, 0xffffffff}}, 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd), "Eidos_Philox4x32_10() known-answer vector 2");
+	EidosAssertRNGStream(EidosPhiloxMatches({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}}, 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1), "Eidos_Philox4x32_10() known-answer vector 3");
+	
+	// Streams are reproducible: the same seed and stream id give the same draws, regardless of other streams in use
+	{
+		Eidos_RNG_Stream stream_a, stream_b, stream_other;
+		bool identical = true;
+		
+		Eidos_InitializeRNGStream(stream_a, 12345, 7);
+		Eidos_InitializeRNGStream(stream_other, 12345, 8);
+		Eidos_InitializeRNGStream(stream_b, 12345, 7);
+		
+		for (int i = 0; i < 1000; ++i)
+		{
+			Eidos_RNGStream_uint32(stream_other);
+			if (Eidos_RNGStream_uint32(stream_a) != Eidos_RNGStream_uint32(stream_b))
+				identical = false;
+		}
+		
+		EidosAssertRNGStream(identical, "Eidos_RNG_Stream reproducibility");
+	}
+	
+	// Streams for different individuals, subpopulations, generations, and seeds all differ
+	{
+		Eidos_RNG_Stream base, ind, subpop, gen, seed;
+		
+		Eidos_InitializeRNGStreamForIndividual(base, 1, 10, 1, 5);
+		Eidos_InitializeRNGStreamForIndividual(ind, 1, 10, 1, 6);
+		Eidos_InitializeRNGStreamForIndividual(subpop, 1, 10, 2, 5);
+		Eidos_InitializeRNGStreamForIndividual(gen, 1, 11, 1, 5);
+		Eidos_InitializeRNGStreamForIndividual(seed, 2, 10, 1, 5);
+		
+		uint64_t base_draw = Eidos_RNGStream_uint64(base);
+		
+		EidosAssertRNGStream(Eidos_RNGStream_uint64(ind) != base_draw, "Eidos_InitializeRNGStreamForIndividual() index independence");
+		EidosAssertRNGStream(Eidos_RNGStream_uint64(subpop) != base_draw, "Eidos_InitializeRNGStreamForIndividual() subpop independence");
+		EidosAssertRNGStream(Eidos_RNGStream_uint64(gen) != base_draw, "Eidos_InitializeRNGStreamForIndividual() generation independence");
+		EidosAssertRNGStream(Eidos_RNGStream_uint64(seed) != base_draw, "Eidos_InitializeRNGStreamForIndividual() seed independence");
+	}
+	
+	// Derived draws stay within their ranges and have roughly the right means
+	{
+		Eidos_RNG_Stream stream;
+		bool in_range = true;
+		double uniform_total = 0.0;
+		int64_t bool_total = 0, poisson_total = 0;
+		
+		Eidos_InitializeRNGStream(stream, 0, 0);
+		
+		for (int i = 0; i < 100000; ++i)
+		{
+			double u = Eidos_RNGStream_uniform(stream);
+			uint32_t k = Eidos_RNGStream_uniform_int(stream, 17);
+			
+			if ((u < 0.0) || (u >= 1.0) || (k >= 17))
+				in_range = false;
+			
+			uniform_total += u;
+			bool_total += Eidos_RNGStream_RandomBool(stream);
+#ifndef USE_GSL_POISSON
+			poisson_total += Eidos_RNGStream_FastRandomPoisson(stream, 2.0, exp(-2.0));
+#endif
+		}
+		
+		EidosAssertRNGStream(in_range, "Eidos_RNG_Stream draw ranges");
+		EidosAssertRNGStream(std::abs(uniform_total / 100000 - 0.5) < 0.01, "Eidos_RNGStream_uniform() mean");
+		EidosAssertRNGStream(std::abs(bool_total / 100000.0 - 0.5) < 0.01, "Eidos_RNGStream_RandomBool() mean");
+#ifndef USE_GSL_POISSON
+		EidosAssertRNGStream(std::abs(poisson_total / 100000.0 - 2.0) < 0.05, "Eidos_RNGStream_FastRandomPoisson() mean");
+#endif
+	}
+	
+#ifndef USE_GSL_POISSON
+	// Poisson draws above mu = 250 use a separate sampler; its mean, variance, and third central moment should all be mu, and
+	// the third moment distinguishes it from a (symmetric) normal approximation, for which that moment would be near zero
+	{
+		Eidos_RNG_Stream stream;
+		std::vector<double> draws(1000000);
+		double total = 0.0;
+		
+		Eidos_InitializeRNGStream(stream, 0, 1);
+		
+		for (double &draw : draws)
+		{
+			draw = Eidos_RNGStream_FastRandomPoisson(stream, 1000.0, 0.0);
+			total += draw;
+		}
+		
+		double mean = total / draws.size();
+		double m2 = 0.0, m3 = 0.0;
+		
+		for (double draw : draws)
+		{
+			double d = draw - mean;
+			
+			m2 += d * d;
+			m3 += d * d * d;
+		}
+		
+		m2 /= draws.size();
+		m3 /= draws.size();
+		
+		EidosAssertRNGStream(std::abs(mean - 1000.0) < 0.2, "Eidos_RNGStream_FastRandomPoisson() mean for large mu");
+		EidosAssertRNGStream(std::abs(m2 - 1000.0) < 10.0, "Eidos_RNGStream_FastRandomPoisson() variance for large mu");
+		EidosAssertRNGStream(std::abs(m3 - 1000.0) < 400.0, "Eidos_RNGStream_FastRandomPoisson() skew for large mu");
+	}
+#endif
+}
+
 #pragma mark literals & identifiers
 void _RunLiteralsIdentifiersAndTokenizationTests(void)
 {
@@ -1399,6 +1536,21 @@ void _RunSymbolsAndVariablesTests(void)
 	EidosAssertScriptSuccess_IV("x = 1:5; y = x; y[1] = 0; y;", {1, 0, 3, 4, 5});
 	EidosAssertScriptSuccess_IV("for (i in 1:3) { x = 1:5; x[1] = x[1] + 1; } x;", {1, 3, 3, 4, 5});
 	
+	// copy-on-write sharing of values between variables, function arguments, and Dictionary entries
+	EidosAssertScriptSuccess_IV("x = 1:5; y = x; z = y; z[0] = 9; c(x, y, z);", {1, 2, 3, 4, 5, 1, 2, 3, 4, 5, 9, 2, 3, 4, 5});
+	EidosAssertScriptSuccess_IV("x = 1:5; y = x; y = y * 2; c(x, y);", {1, 2, 3, 4, 5, 2, 4, 6, 8, 10});
+	EidosAssertScriptSuccess_FV("x = c(1.5, 2.5); y = x; x = x + 1; c(x, y);", {2.5, 3.5, 1.5, 2.5});
+	EidosAssertScriptSuccess_IV("x = 5; y = x; y = y + 1; c(x, y);", {5, 6});
+	EidosAssertScriptSuccess_IV("x = matrix(1:4, nrow=2); y = x; y[0, 1] = 0; c(x, dim(x), y);", {1, 2, 3, 4, 2, 2, 1, 2, 0, 4});
+	EidosAssertScriptSuccess_IV("function (void)f(i x) { x[0] = 10; x = x + 1; } x = 1:3; f(x); x;", {1, 2, 3});
+	EidosAssertScriptSuccess_IV("function (i)f(i x) { x[0] = 10; return x; } x = 1:3; y = f(x); c(x, y);", {1, 2, 3, 10, 2, 3});
+	EidosAssertScriptSuccess_IV("x = 1:3; y = x; function (void)f(void) { x[0] = 10; } f(); c(x, y);", {10, 2, 3, 1, 2, 3});
+	EidosAssertScriptSuccess_IV("x = 1:3; defineGlobal('G', x); G[0] = 5; x = x + 1; c(x, G);", {2, 3, 4, 5, 2, 3});
+	EidosAssertScriptSuccess_IV("x = 1:3; d = Dictionary('a', x); x[0] = 7; c(x, d.getValue('a'));", {7, 2, 3, 1, 2, 3});
+	EidosAssertScriptSuccess_IV("d = Dictionary('a', 1:3); x = d.getValue('a'); x[0] = 7; c(x, d.getValue('a'));", {7, 2, 3, 1, 2, 3});
+	EidosAssertScriptSuccess_IV("d = Dictionary('a', 1:3); e = Dictionary(); e.addKeysAndValuesFrom(d); x = e.getValue('a'); x = x + 1; c(x, d.getValue('a'), e.getValue('a'));", {2, 3, 4, 1, 2, 3, 1, 2, 3});
+	EidosAssertScriptSuccess_IV("z = integer(0); for (i in 1:3) { y = i; z = c(z, y); } c(z, y);", {1, 2, 3, 3});
+	
 	// some tests for Unicode in symbol names; both accented characters and emoji should be legal (and all other Unicode above 7-bit ASCII)
 	// note that "\u00E9" is &eacute; and "\u1F603" is a grinning face emoji
 	EidosAssertScriptSuccess_I("\u00E9 = 3; \u00E9;", 3);
@@ -1570,6 +1722,7 @@ void _RunVectorsAndSingletonsTests(void)
 	
 	EidosAssertScriptSuccess_I("_Test(2)._yolk;", 2);
 	EidosAssertScriptSuccess_IV("c(_Test(2),_Test(3))._yolk;", {2, 3});
+	EidosAssertScriptSuccess_IV("x = c(_Test(2),_Test(3)); x = c(x, _Test(4)); x[1] = _Test(5); x._yolk;", {2, 5, 4});
 	EidosAssertScriptSuccess_IV("_Test(2)[F]._yolk;", {});
 	
 	EidosAssertScriptSuccess_I("_Test(2)._cubicYolk();", 8);
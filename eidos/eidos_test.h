@@ -77,6 +77,7 @@ extern void _RunParsingTests(void);
 extern void _RunFunctionDispatchTests(void);
 extern void _RunRuntimeErrorTests(void);
 extern void _RunVectorsAndSingletonsTests(void);
+extern void _RunRNGStreamTests(void);
 extern void _RunOperatorPlusTests1(void);
 extern void _RunOperatorPlusTests2(void);
 extern void _RunOperatorMinusTests(void);
@@ -790,6 +790,12 @@ void _RunFunctionMathTests_setUnionIntersection(void)
 	EidosAssertScriptSuccess_FV("setIntersection(c(3.2, 3.2, 3.2, NAN, NAN, 3.2), c(3.2, NAN, 3.2, 3.2, 3.2));", {3.2, std::numeric_limits<double>::quiet_NaN()});
 	EidosAssertScriptSuccess_FV("setIntersection(c(3.2, 6.0, 7.9, NAN, NAN, 3.2), c(5.5, 6.0, 3.2, 3.2));", {3.2, 6.0});
 	EidosAssertScriptSuccess_FV("setIntersection(c(3.2, 6.0, 7.9, NAN, NAN, 3.2), c(5.5, NAN, 6.0, 3.2, 3.2));", {3.2, 6.0, std::numeric_limits<double>::quiet_NaN()});
+	
+	// check the hash-table-based versions of setUnion() and setIntersection(), which are used for larger vectors
+	EidosAssertScriptSuccess_L("x = c(0:199, 0:199); y = 100:299; identical(setUnion(x, y), 0:299) & identical(setIntersection(x, y), 100:199);", true);
+	EidosAssertScriptSuccess_L("x = c(asFloat(0:99), NAN, NAN, -0.0); y = c(asFloat(50:149), NAN, 0.0); r = setIntersection(x, y); identical(r[0:50], asFloat(c(0, 50:99))) & isNAN(r[51]) & (size(r) == 52);", true);
+	EidosAssertScriptSuccess_L("x = asString(c(0:199, 0:199)); y = asString(100:299); identical(setUnion(x, y), asString(0:299)) & identical(setIntersection(x, y), asString(100:199));", true);
+	EidosAssertScriptSuccess_L("o = sapply(0:299, '_Test(applyValue);'); x = c(o[0:199], o[0:199]); y = o[100:299]; identical(setUnion(x, y)._yolk, 0:299) & identical(setIntersection(x, y)._yolk, 100:199);", true);
 }
 
 void _RunFunctionMathTests_setDifferenceSymmetricDifference(void)
@@ -1049,6 +1055,12 @@ void _RunFunctionMathTests_setDifferenceSymmetricDifference(void)
 	EidosAssertScriptSuccess_FV("setSymmetricDifference(c(7.3, 10.5, NAN, NAN, 7.3, 10.5, 8.9), c(7.3, 9.7, 7.3, 9.7, 7.3));", {10.5, std::numeric_limits<double>::quiet_NaN(), 8.9, 9.7});
 	EidosAssertScriptSuccess_FV("setSymmetricDifference(c(7.3, 10.5, NAN, NAN, 7.3, 10.5, 8.9), c(7.3, NAN, 9.7, 7.3, 9.7, 7.3));", {10.5, 8.9, 9.7});
 	EidosAssertScriptSuccess_FV("setSymmetricDifference(c(7.3, 10.5, 7.3, 10.5, 8.9), c(7.3, NAN, NAN, 9.7, 7.3, 9.7, 7.3));", {10.5, 8.9, std::numeric_limits<double>::quiet_NaN(), 9.7});
+	
+	// check the hash-table-based versions of setDifference() and setSymmetricDifference(), which are used for larger vectors
+	EidosAssertScriptSuccess_L("x = c(0:199, 0:199); y = c(100:299, 100:299); identical(setDifference(x, y), 0:99) & identical(setSymmetricDifference(x, y), c(0:99, 200:299));", true);
+	EidosAssertScriptSuccess_L("x = c(asFloat(0:99), NAN, NAN, -0.0); y = c(asFloat(50:149), NAN, 0.0); identical(setDifference(x, y), asFloat(1:49)) & identical(setSymmetricDifference(x, y), asFloat(c(1:49, 100:149)));", true);
+	EidosAssertScriptSuccess_L("x = asString(c(0:199, 0:199)); y = asString(100:299); identical(setDifference(x, y), asString(0:99)) & identical(setSymmetricDifference(x, y), asString(c(0:99, 200:299)));", true);
+	EidosAssertScriptSuccess_L("o = sapply(0:299, '_Test(applyValue);'); x = c(o[0:199], o[0:199]); y = o[100:299]; identical(setDifference(x, y)._yolk, 0:99) & identical(setSymmetricDifference(x, y)._yolk, c(0:99, 200:299));", true);
 }
 
 void _RunFunctionMathTests_s_through_z(void)
@@ -1119,6 +1131,17 @@ void _RunFunctionMathTests_s_through_z(void)
 	EidosAssertScriptSuccess_I("sum(matrix(c(5, -5)));", 0);
 	EidosAssertScriptSuccess_I("sum(array(c(5, -5, 3), c(1,3,1)));", 3);
 	
+	// sum() of an elementwise expression is evaluated in blocks without temporaries, which must match normal evaluation exactly
+	EidosAssertScriptSuccess_L("x = runif(1000) - 0.5; m = 0.25; s = 2; t = exp(-(x - m)^2 / s); identical(sum(exp(-(x - m)^2 / s)), sum(t));", true);
+	EidosAssertScriptSuccess_L("x = rdunif(1000, -5, 5); y = runif(1000); t = x * y + sqrt(abs(y)) - log(y + 1) / 3 + log10(2^x); identical(sum(x * y + sqrt(abs(y)) - log(y + 1) / 3 + log10(2^x)), sum(t));", true);
+	EidosAssertScriptSuccess_I("x = 1:10; sum(x * 2);", 110);
+	EidosAssertScriptSuccess_F("x = 1:10; sum(x / 2);", 27.5);
+	EidosAssertScriptSuccess_F("sum(matrix(c(1.5, 2.5)) * 2);", 8);
+	EidosAssertScriptSuccess("x = c(5.0, 2.0, NAN, 2.0); sum(x * 2);", gStaticEidosValue_FloatNAN);
+	EidosAssertScriptSuccess("x = float(0); sum(x * 2);", gStaticEidosValue_Float0);
+	EidosAssertScriptRaise("x = 1:3; y = c(1.0, 2.0); sum(x * y);", 32, "operator requires that either");
+	EidosAssertScriptRaise("x = 1:3; sum(x * 'a');", 15, "is not supported by");
+	
 	// sumExact()
 	EidosAssertScriptSuccess_F("sumExact(5.5);", 5.5);
 	EidosAssertScriptSuccess_F("sumExact(-5.5);", -5.5);
@@ -47,6 +47,9 @@ void _RunFunctionMatrixArrayTests(void)
 	EidosAssertScriptSuccess_L("identical(cbind(matrix(1:6, nrow=2), matrix(7:12, nrow=2)), matrix(1:12, nrow=2));", true);
 	EidosAssertScriptSuccess_L("identical(cbind(matrix(1:6, ncol=2), matrix(7:12, ncol=2)), matrix(1:12, nrow=3));", true);
 	EidosAssertScriptSuccess_L("identical(cbind(matrix(1:6, nrow=1), matrix(7:12, nrow=1)), matrix(1:12, nrow=1));", true);
+	EidosAssertScriptSuccess_L("identical(cbind(5.5, 6.5), matrix(c(5.5, 6.5), nrow=1));", true);
+	EidosAssertScriptSuccess_L("identical(cbind(c(T,F), NULL, matrix(c(F,F,T,T), nrow=2)), matrix(c(T,F,F,F,T,T), nrow=2));", true);
+	EidosAssertScriptSuccess_L("identical(cbind(c('a','b'), matrix(c('c','d'))), matrix(c('a','b','c','d'), nrow=2));", true);
 	
 	// dim()
 	EidosAssertScriptSuccess_NULL("dim(NULL);");
@@ -151,6 +154,11 @@ void _RunFunctionMatrixArrayTests(void)
 	EidosAssertScriptSuccess_L("A = matrix(1.0:6.0, nrow=2); B = matrix(1.0:6.0, ncol=2); identical(matrixMult(A, B), matrix(c(22.0, 28.0, 49.0, 64.0), nrow=2));", true);
 	EidosAssertScriptSuccess_L("A = matrix(1.0:6.0, ncol=2); B = matrix(1.0:6.0, nrow=2); identical(matrixMult(A, B), matrix(c(9.0, 12.0, 15.0, 19.0, 26.0, 33.0, 29.0, 40.0, 51.0), nrow=3));", true);
 	
+	// check the blocked multiplication against a direct calculation, with dimensions that span several blocks and leave partial blocks
+	EidosAssertScriptSuccess_L("A = matrix(runif(300*263), nrow=300); B = matrix(runif(263*7), nrow=263); C = matrixMult(A, B); D = sapply(0:6, 'col = B[,applyValue]; sapply(0:299, \"sum(A[applyValue,] * t(col));\");'); all(abs(C - matrix(D, nrow=300)) < 1e-10);", true);
+	EidosAssertScriptSuccess_L("A = matrix(rdunif(300*263, -50, 50), nrow=300); B = matrix(rdunif(263*7, -50, 50), nrow=263); C = matrixMult(A, B); D = sapply(0:6, 'col = B[,applyValue]; sapply(0:299, \"sum(A[applyValue,] * t(col));\");'); identical(C, matrix(D, nrow=300));", true);
+	EidosAssertScriptRaise("A = matrix(c(5000000000, 1), nrow=1); B = matrix(c(5000000000, 1), ncol=1); matrixMult(A, B);", 76, "multiplication overflow");
+	
 	// ncol()
 	EidosAssertScriptSuccess_NULL("ncol(NULL);");
 	EidosAssertScriptSuccess_NULL("ncol(T);");
@@ -212,6 +220,9 @@ void _RunFunctionMatrixArrayTests(void)
 	EidosAssertScriptSuccess_L("identical(rbind(matrix(1:6, nrow=2), matrix(7:12, nrow=2)), matrix(c(1,2,7,8,3,4,9,10,5,6,11,12), nrow=4));", true);
 	EidosAssertScriptSuccess_L("identical(rbind(matrix(1:6, ncol=2), matrix(7:12, ncol=2)), matrix(c(1,2,3,7,8,9,4,5,6,10,11,12), ncol=2));", true);
 	EidosAssertScriptSuccess_L("identical(rbind(matrix(1:6, ncol=1), matrix(7:12, ncol=1)), matrix(1:12, ncol=1));", true);
+	EidosAssertScriptSuccess_L("identical(rbind(5.5, 6.5), matrix(c(5.5, 6.5), ncol=1));", true);
+	EidosAssertScriptSuccess_L("identical(rbind(c(T,F), NULL, matrix(c(F,F,T,T), nrow=2)), matrix(c(T,F,F,F,T,T), nrow=3));", true);
+	EidosAssertScriptSuccess_L("identical(rbind(c('a','b'), matrix(c('c','d'), nrow=1)), matrix(c('a','c','b','d'), nrow=2));", true);
 	
 	// t()
 	EidosAssertScriptRaise("t(NULL);", 0, "is not a matrix");
@@ -229,6 +240,9 @@ void _RunFunctionMatrixArrayTests(void)
 	EidosAssertScriptSuccess_L("identical(t(matrix(1.0:6, nrow=2, byrow=T)), matrix(1.0:6, ncol=2, byrow=F));", true);
 	EidosAssertScriptSuccess_L("identical(t(matrix(1.0:6, ncol=2)), matrix(1.0:6, nrow=2, byrow=T));", true);
 	EidosAssertScriptSuccess_L("identical(t(matrix(1.0:6, ncol=2, byrow=T)), matrix(1.0:6, nrow=2, byrow=F));", true);
+	EidosAssertScriptSuccess_L("identical(t(matrix(c(T,F,F,T,T,T), nrow=2)), matrix(c(T,F,F,T,T,T), ncol=2, byrow=T));", true);
+	EidosAssertScriptSuccess_L("identical(t(matrix(c('a','b','c','d','e','f'), nrow=2)), matrix(c('a','b','c','d','e','f'), ncol=2, byrow=T));", true);
+	EidosAssertScriptSuccess_L("x = matrix(1:(70*45), nrow=70); identical(t(t(x)), x) & identical(t(x), matrix(1:(70*45), ncol=70, byrow=T));", true);
 	EidosAssertScriptRaise("t(array(1:24, c(2,3,4)));", 0, "is not a matrix");
 	EidosAssertScriptRaise("t(array(1:48, c(2,3,4,2)));", 0, "is not a matrix");
 }
@@ -571,6 +585,27 @@ void _RunFunctionMiscTests_apply_sapply(void)
 	EidosAssertScriptRaise("x=2; y='syntax Error;'; sapply(x, y[T]);", 24, "unexpected token '@Error'");
 	EidosAssertScriptSuccess_I("x=2; y='x;'; sapply(x, y[T]);", 2);
 	
+	// sapply() reuses a single value for applyValue when the lambda does not assign to it; check that nothing sees it change
+	EidosAssertScriptSuccess_IV("sapply(1:5, 'applyValue;');", {1, 2, 3, 4, 5});
+	EidosAssertScriptSuccess_FV("sapply(c(1.5, 2.5, 3.5), 'applyValue;');", {1.5, 2.5, 3.5});
+	EidosAssertScriptSuccess_SV("sapply(c('a', 'b', 'c'), 'applyValue;');", {"a", "b", "c"});
+	EidosAssertScriptSuccess_IV("sapply(c(_Test(1), _Test(2), _Test(3)), 'applyValue;')._yolk;", {1, 2, 3});
+	EidosAssertScriptSuccess_IV("sapply(c(_Test(1), _Test(2), _Test(3)), 'applyValue._yolk;');", {1, 2, 3});
+	EidosAssertScriptSuccess_IV("x = integer(0); sapply(1:5, 'x = c(x, applyValue); NULL;'); x;", {1, 2, 3, 4, 5});
+	EidosAssertScriptSuccess_IV("d = Dictionary(); sapply(1:3, 'd.setValue(asString(applyValue), applyValue); NULL;'); c(d.getValue('1'), d.getValue('3'));", {1, 3});
+	EidosAssertScriptSuccess_IV("sapply(1:5, 'applyValue = applyValue * 2; applyValue;');", {2, 4, 6, 8, 10});
+	EidosAssertScriptSuccess_I("sapply(1:3, 'y = applyValue; NULL;'); y;", 3);
+	EidosAssertScriptSuccess_IV("sapply(1:5, \"defineGlobal('applyValue', 100); y = c(1,2,3,4,5,6,7,8); applyValue * 1;\");", {100, 100, 100, 100, 100});
+	EidosAssertScriptSuccess_IV("function (void)g(void) { rm('applyValue'); } sapply(1:5, 'g(); z = c(10,20,30,40,50,60); 1;');", {1, 1, 1, 1, 1});
+	
+	// sapply() accumulates integer and float singletons directly; check that other return values still concatenate as c() would
+	EidosAssertScriptSuccess_FV("sapply(1:4, 'if (applyValue < 3) applyValue; else applyValue + 0.5;');", {1, 2, 3.5, 4.5});
+	EidosAssertScriptSuccess_FV("sapply(1:4, 'if (applyValue < 3) applyValue + 0.5; else applyValue;');", {1.5, 2.5, 3, 4});
+	EidosAssertScriptSuccess_IV("sapply(1:3, 'if (applyValue == 2) c(applyValue, applyValue); else applyValue;');", {1, 2, 2, 3});
+	EidosAssertScriptSuccess_SV("sapply(1:3, \"if (applyValue == 3) 'x'; else applyValue;\");", {"1", "2", "x"});
+	EidosAssertScriptSuccess_IV("sapply(1:4, 'if (applyValue % 2) NULL; else applyValue;', simplify='matrix');", {2, 4});
+	EidosAssertScriptSuccess_NULL("sapply(1:3, 'NULL;');");
+	
 	EidosAssertScriptSuccess_L("identical(sapply(1:6, 'integer(0);'), integer(0));", true);
 	EidosAssertScriptSuccess_L("identical(sapply(1:6, 'integer(0);', simplify='vector'), integer(0));", true);
 	EidosAssertScriptSuccess_L("identical(sapply(1:6, 'integer(0);', simplify='matrix'), integer(0));", true);
@@ -1490,6 +1525,14 @@ void _RunUserDefinedFunctionTests(void)
 	EidosAssertScriptRaise("function(void)foo(void) { defineConstant('x', 10); } foo(); defineGlobal('x', 5);", 60, "is a constant");
 	EidosAssertScriptRaise("function(void)foo(void) { defineGlobal('x', 5); } foo(); defineConstant('x', 10); foo();", 57, "already defined");
 	
+	// Local variables tables start out compact and grow into lookup tables as needed; these exercise both, and the transition
+	EidosAssertScriptSuccess_I("function (i)f(i x) { a = x; b = a + 1; c = b + 1; d = c + 1; e = d + 1; f = e + 1; g = f + 1; h = g + 1; i = h + 1; j = i + 1; k = j + 1; return a + k; } f(1);", 12);
+	EidosAssertScriptSuccess_I("function (i)f(i x) { a = x; b = a + 1; c = b + 1; d = c + 1; e = d + 1; f = e + 1; g = f + 1; h = g + 1; i = h + 1; j = i + 1; k = j + 1; return sum(exists(c('a', 'e', 'f', 'k', 'x', 'y'))); } f(1);", 5);
+	EidosAssertScriptSuccess_IV("function (i)f(i x) { a = x; b = 2; c = 3; rm('b'); d = 4; b = 5; return c(a, b, c, d, asInteger(exists('b'))); } f(1);", {1, 5, 3, 4, 1});
+	EidosAssertScriptSuccess_I("function (i)f(i x) { a = x; b = 2; c = 3; rm(c('a', 'b')); return sum(exists(c('a', 'b', 'c', 'x'))); } f(1);", 2);
+	EidosAssertScriptRaise("function (i)f(i x) { a = x; rm('a'); return a; } f(1);", 49, "undefined identifier");
+	EidosAssertScriptSuccess_I("function (i)f(i x) { if (x <= 1) return 1; a = x; b = a - 1; c = b; d = c; e = d; f = e; g = f; h = g; i = h; return x * f(i); } f(10);", 3628800);
+	
 	// Mutual recursion with lambdas
 	
 	
@@ -95,6 +95,8 @@ void _RunFunctionStatisticsTests_a_through_p(void)
 	EidosAssertScriptSuccess_NULL("max(float(0));");
 	EidosAssertScriptSuccess_NULL("max(string(0));");
 	EidosAssertScriptSuccess("max(c(1.0, 5.0, NAN, 2.0));", gStaticEidosValue_FloatNAN);
+	EidosAssertScriptSuccess_L("x = rnorm(1000); t = x^2 - x; identical(max(x^2 - x), max(t));", true);
+	EidosAssertScriptSuccess("x = c(1.0, 5.0, NAN, 2.0); max(x * 2);", gStaticEidosValue_FloatNAN);
 	
 	EidosAssertScriptSuccess_L("max(F, T);", true);
 	EidosAssertScriptSuccess_L("max(T, F);", true);
@@ -129,6 +131,8 @@ void _RunFunctionStatisticsTests_a_through_p(void)
 	EidosAssertScriptSuccess_F("mean(rep(1e18, 9));", 1e18);	// stays in integer internally
 	EidosAssertScriptSuccess_F("mean(rep(1e18, 10));", 1e18);	// overflows to float internally
 	EidosAssertScriptSuccess("mean(c(1.0, 5.0, NAN, 2.0));", gStaticEidosValue_FloatNAN);
+	EidosAssertScriptSuccess_L("x = runif(1000); t = x * 3 - 1; identical(mean(x * 3 - 1), mean(t));", true);
+	EidosAssertScriptSuccess_NULL("x = float(0); mean(x * 3 - 1);");
 	
 	// min()
 	EidosAssertScriptSuccess_L("min(T);", true);
@@ -146,6 +150,8 @@ void _RunFunctionStatisticsTests_a_through_p(void)
 	EidosAssertScriptSuccess_NULL("min(float(0));");
 	EidosAssertScriptSuccess_NULL("min(string(0));");
 	EidosAssertScriptSuccess("min(c(1.0, 5.0, NAN, 2.0));", gStaticEidosValue_FloatNAN);
+	EidosAssertScriptSuccess_L("x = rnorm(1000); t = x^2 - x; identical(min(x^2 - x), min(t));", true);
+	EidosAssertScriptSuccess("x = c(1.0, 5.0, NAN, 2.0); min(-x);", gStaticEidosValue_FloatNAN);
 	
 	EidosAssertScriptSuccess_L("min(T, F);", false);
 	EidosAssertScriptSuccess_L("min(F, T);", false);
@@ -386,6 +386,9 @@ void _RunFunctionValueInspectionManipulationTests_a_through_f(void)
 	EidosAssertScriptSuccess_L("all(T,T,c(T,T,T,T),c(T,T,T,T));", true);
 	EidosAssertScriptSuccess_L("all(T,T,c(T,T,T,T),c(T,F,T,T));", false);
 	EidosAssertScriptSuccess_L("all(F,F,c(F,F,F,F),c(F,F,F,F));", false);
+	EidosAssertScriptSuccess_L("x = runif(1000); y = runif(1000); c = (x * 2 > y + 0.1); identical(all(x * 2 > y + 0.1), all(c));", true);
+	EidosAssertScriptSuccess_L("x = 1:1000; all(x >= 1);", true);
+	EidosAssertScriptSuccess_L("x = 1:1000; all(x != 500);", false);
 	
 	// any()
 	EidosAssertScriptRaise("any(NULL);", 0, "cannot be type");
@@ -414,6 +417,9 @@ void _RunFunctionValueInspectionManipulationTests_a_through_f(void)
 	EidosAssertScriptSuccess_L("any(T,T,c(T,T,T,T),c(T,F,T,T));", true);
 	EidosAssertScriptSuccess_L("any(F,F,c(F,F,F,F),c(F,T,F,F));", true);
 	EidosAssertScriptSuccess_L("any(F,F,c(F,F,F,F),c(F,F,F,F));", false);
+	EidosAssertScriptSuccess_L("x = runif(1000); y = runif(1000); c = (x * 2 > y + 1.5); identical(any(x * 2 > y + 1.5), any(c));", true);
+	EidosAssertScriptSuccess_L("x = 1:1000; any(x == 500);", true);
+	EidosAssertScriptSuccess_L("x = 1:1000; any(x / 2 < 0.5);", false);
 	
 	// cat() – can't test the actual output, but we can make sure it executes...
 	EidosAssertScriptRaise("cat();", 0, "missing required argument x");
@@ -857,6 +863,15 @@ void _RunFunctionValueInspectionManipulationTests_m_through_r(void)
 	EidosAssertScriptSuccess_L("x = c(5, 0, NAN, 17, NAN, -17); o = order(x, ascending=T); identical(o, c(5, 1, 0, 3, 2, 4)) | identical(o, c(5, 1, 0, 3, 4, 2));", true);
 	EidosAssertScriptSuccess_L("x = c(5, 0, NAN, 17, NAN, -17); o = order(x, ascending=F); identical(o, c(3, 0, 1, 5, 2, 4)) | identical(o, c(3, 0, 1, 5, 4, 2));", true);
 	
+	// check the radix-sort-based versions of order(), based on the fact that the crossover between algorithms is x_count >= 1000; these are stable
+	EidosAssertScriptSuccess_L("x = c(rdunif(3000, -1000000000, 1000000000), rdunif(3000, -10, 10)); s = x[order(x)]; all(s[0:5998] <= s[1:5999]) & identical(s, sort(x));", true);
+	EidosAssertScriptSuccess_L("x = c(rnorm(3000, 0, 1e10), runif(3000)); s = x[order(x, F)]; all(s[0:5998] >= s[1:5999]) & identical(s, sort(x, F));", true);
+	EidosAssertScriptSuccess_L("x = rep(c(3, 1, 2), 1000); identical(order(x), c(seqLen(1000) * 3 + 1, seqLen(1000) * 3 + 2, seqLen(1000) * 3));", true);
+	EidosAssertScriptSuccess_L("x = rep(c(3, 1, 2), 1000); identical(order(x, F), c(seqLen(1000) * 3, seqLen(1000) * 3 + 2, seqLen(1000) * 3 + 1));", true);
+	EidosAssertScriptSuccess_L("x = c(NAN, rep(c(1.5, -2.5), 600), NAN); identical(order(x), c(seq(2, 1200, by=2), seq(1, 1199, by=2), 0, 1201));", true);
+	EidosAssertScriptSuccess_L("x = c(NAN, rep(c(1.5, -2.5), 600), NAN); identical(order(x, F), c(seq(1, 1199, by=2), seq(2, 1200, by=2), 0, 1201));", true);
+	EidosAssertScriptSuccess_L("x = rep(c(0.0, -0.0), 600); identical(order(x), 0:1199) & identical(order(x, F), 0:1199);", true);
+	
 	// paste()
 	EidosAssertScriptSuccess("paste(NULL);", gStaticEidosValue_StringEmpty);
 	EidosAssertScriptSuccess_S("paste(T);", "T");
@@ -961,6 +976,11 @@ void _RunFunctionValueInspectionManipulationTests_s_through_z(void)
 	EidosAssertScriptSuccess_FV("x = c(5, 0, NAN, 17, NAN, -17); sort(x, ascending=T);", {-17, 0, 5, 17, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()});
 	EidosAssertScriptSuccess_FV("x = c(5, 0, NAN, 17, NAN, -17); sort(x, ascending=F);", {17, 5, 0, -17, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()});
 	
+	// check the radix-sort-based versions of sort(), based on the fact that the crossover between algorithms is x_count >= 1000
+	EidosAssertScriptSuccess_L("x = c(rdunif(3000, -1000000000, 1000000000), rdunif(3000, -10, 10)); s = sort(x); all(s[0:5998] <= s[1:5999]) & identical(sort(x, F), rev(s)) & identical(sort(s), s);", true);
+	EidosAssertScriptSuccess_L("x = c(NAN, rnorm(3000, 0, 1e10), runif(2000), NAN); s = sort(x); all(s[0:4998] <= s[1:4999]) & all(isNAN(s[5000:5001])) & identical(s[0:4999], rev(sort(x, F)[0:4999]));", true);
+	EidosAssertScriptSuccess_L("x = c(NAN, rnorm(5000), NAN); s = sort(x, F); all(s[0:4998] >= s[1:4999]) & all(isNAN(s[5000:5001]));", true);
+	
 	// sortBy()
 	EidosAssertScriptRaise("sortBy(NULL);", 0, "cannot be type");
 	EidosAssertScriptRaise("sortBy(T);", 0, "cannot be type");
@@ -1062,6 +1082,14 @@ void _RunFunctionValueInspectionManipulationTests_s_through_z(void)
 	EidosAssertScriptSuccess_L("x = asInteger(runif(10000, 0, 10000)); size(unique(x)) == size(unique(x, F));", true);
 	EidosAssertScriptSuccess_L("x = runif(10000, 0, 1); size(unique(x)) == size(unique(x, F));", true);
 	
+	// check the hash-table-based versions of unique(), based on the fact that the crossover between algorithms is x_count >= 50
+	EidosAssertScriptSuccess_IV("unique(rep(c(3,5,3,9,2,3,3,7,5), 10));", {3, 5, 9, 2, 7});
+	EidosAssertScriptSuccess_FV("unique(rep(c(3.5,1.2,NAN,-0.0,1.2,0.0,NAN,7.6), 10));", {3.5, 1.2, std::numeric_limits<double>::quiet_NaN(), 0.0, 7.6});
+	EidosAssertScriptSuccess_SV("unique(rep(c('foo', 'bar', 'foo', 'baz', 'baz', 'bar', 'foo'), 10));", {"foo", "bar", "baz"});
+	EidosAssertScriptSuccess_IV("x = _Test(7); y = _Test(2); unique(rep(c(x, y, x, x), 20))._yolk;", {7, 2});
+	EidosAssertScriptSuccess_L("x = rdunif(1000, 0, 300); u = unique(x); m = match(u, x); identical(sort(u), unique(x, F)) & identical(m, sort(m));", true);
+	EidosAssertScriptSuccess_L("x = asString(rdunif(1000, 0, 300)); u = unique(x); m = match(u, x); identical(sort(u), sort(unique(x, F))) & identical(m, sort(m));", true);
+	
 	// which()
 	EidosAssertScriptRaise("which(NULL);", 0, "cannot be type");
 	EidosAssertScriptRaise("which(5);", 0, "cannot be type");
@@ -1072,6 +1100,7 @@ void _RunFunctionValueInspectionManipulationTests_s_through_z(void)
 	EidosAssertScriptSuccess("which(F);", gStaticEidosValue_Integer_ZeroVec);
 	EidosAssertScriptSuccess("which(T);", gStaticEidosValue_Integer0);
 	EidosAssertScriptSuccess_IV("which(c(T,F,F,T,F,T,F,F,T));", {0, 3, 5, 8});
+	EidosAssertScriptSuccess_IV("which(c(T,T,T,T,T,F,T,T));", {0, 1, 2, 3, 4, 6, 7});
 	
 	// whichMax()
 	EidosAssertScriptSuccess("whichMax(T);", gStaticEidosValue_Integer0);
@@ -236,6 +236,13 @@ void _RunOperatorPlusTests1(void)
 	EidosAssertScriptRaise("identical(array(1:6,c(3,2,1)) + array(1:6,c(1,3,2)), array(2:7, c(1,3,2)));", 30, "non-conformable");
 	EidosAssertScriptRaise("identical(array(1:6,c(3,2,1)) + array(1:6,c(2,1,3)), array(2:7, c(2,1,3)));", 30, "non-conformable");
 	EidosAssertScriptRaise("identical(array(1:6,c(3,2,1)) + array(1:6,c(1,2,3)), array(2:7, c(1,2,3)));", 30, "non-conformable");
+	
+	// scalar temporaries are reused in place by arithmetic operators; variables, constants, and matrices must not be modified
+	EidosAssertScriptSuccess_L("a = 2.0; b = a * 3.0 + (a - 1.0) * 2.0 / 4.0 - a ^ 2 % 3.0; c = -(a * 2.0); identical(c(a, b, c), c(2.0, 5.5, -4.0));", true);
+	EidosAssertScriptSuccess_L("a = 2; b = a * 3 + (a - 1) * 2 - a; c = -(a * 2); identical(c(a, b, c), c(2, 6, -4));", true);
+	EidosAssertScriptSuccess_L("x = 0.0; for (i in 1:10) x = x + i * 0.5 + 1.0; y = x; z = (y + 1.0) * 2.0; identical(c(x, y, z), c(37.5, 37.5, 77.0));", true);
+	EidosAssertScriptSuccess_L("m = matrix(2.0); n = (m * 3.0) + 1.0; identical(m, matrix(2.0)) & identical(n, matrix(7.0));", true);
+	EidosAssertScriptSuccess_L("for (i in 1:3) { v = PI * 2.0 + 1.0; } identical(PI, 3.141592653589793) & (v == PI * 2.0 + 1.0);", true);
 }
 
 void _RunOperatorPlusTests2(void)
@@ -102,6 +102,17 @@ void _RunOperatorGtTests(void)
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, NAN) > c(5.0, 5.0, 5.0);", {false, true, false});
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, 8.0) > c(5.0, 5.0, NAN);", {false, true, false});
 	
+	// operator >: mixed int/float vector and broadcast operands go through the vectorized comparison kernels
+	EidosAssertScriptSuccess_LV("c(1, 5, 9) > c(0.5, 5.0, 9.5);", {true, false, false});
+	EidosAssertScriptSuccess_LV("c(0.5, 5.0, 9.5) > c(1, 5, 9);", {false, false, true});
+	EidosAssertScriptSuccess_LV("5 > c(4.5, 5.0, NAN);", {true, false, false});
+	EidosAssertScriptSuccess_LV("c(4.5, 5.0, NAN) > 5;", {false, false, false});
+	EidosAssertScriptSuccess_LV("c(4, 5, 6) > 5;", {false, false, true});
+	EidosAssertScriptSuccess_LV("5.0 > c(4.0, 5.0, 6.0);", {true, false, false});
+	EidosAssertScriptSuccess_L("x = runif(1000); y = asInteger(x * 10); identical(x > y, sapply(seqAlong(x), 'x[applyValue] > y[applyValue];'));", true);
+	EidosAssertScriptSuccess_L("identical(integer(0) > 5.0, logical(0));", true);
+	EidosAssertScriptSuccess_L("identical(5 > float(0), logical(0));", true);
+	
 	EidosAssertScriptRaise("c(5,6) > c(5,6,7);", 7, "operator requires that either");
 	
 	// operator >: test with mixed singletons, vectors, matrices, and arrays; the dimensionality code is shared across all operand types, so testing it with integer should suffice
@@ -203,6 +214,17 @@ void _RunOperatorLtTests(void)
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, NAN) < c(5.0, 5.0, 5.0);", {false, false, false});
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, 8.0) < c(5.0, 5.0, NAN);", {false, false, false});
 	
+	// operator <: mixed int/float vector and broadcast operands go through the vectorized comparison kernels
+	EidosAssertScriptSuccess_LV("c(1, 5, 9) < c(0.5, 5.0, 9.5);", {false, false, true});
+	EidosAssertScriptSuccess_LV("c(0.5, 5.0, 9.5) < c(1, 5, 9);", {true, false, false});
+	EidosAssertScriptSuccess_LV("5 < c(4.5, 5.0, NAN);", {false, false, false});
+	EidosAssertScriptSuccess_LV("c(4.5, 5.0, NAN) < 5;", {true, false, false});
+	EidosAssertScriptSuccess_LV("c(4, 5, 6) < 5;", {true, false, false});
+	EidosAssertScriptSuccess_LV("5.0 < c(4.0, 5.0, 6.0);", {false, false, true});
+	EidosAssertScriptSuccess_L("x = runif(1000); y = asInteger(x * 10); identical(x < y, sapply(seqAlong(x), 'x[applyValue] < y[applyValue];'));", true);
+	EidosAssertScriptSuccess_L("identical(integer(0) < 5.0, logical(0));", true);
+	EidosAssertScriptSuccess_L("identical(5 < float(0), logical(0));", true);
+	
 	EidosAssertScriptRaise("c(5,6) < c(5,6,7);", 7, "operator requires that either");
 	
 	// operator <: test with mixed singletons, vectors, matrices, and arrays; the dimensionality code is shared across all operand types, so testing it with integer should suffice
@@ -304,6 +326,17 @@ void _RunOperatorGtEqTests(void)
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, NAN) >= c(5.0, 5.0, 5.0);", {true, true, false});
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, 8.0) >= c(5.0, 5.0, NAN);", {true, true, false});
 	
+	// operator >=: mixed int/float vector and broadcast operands go through the vectorized comparison kernels
+	EidosAssertScriptSuccess_LV("c(1, 5, 9) >= c(0.5, 5.0, 9.5);", {true, true, false});
+	EidosAssertScriptSuccess_LV("c(0.5, 5.0, 9.5) >= c(1, 5, 9);", {false, true, true});
+	EidosAssertScriptSuccess_LV("5 >= c(4.5, 5.0, NAN);", {true, true, false});
+	EidosAssertScriptSuccess_LV("c(4.5, 5.0, NAN) >= 5;", {false, true, false});
+	EidosAssertScriptSuccess_LV("c(4, 5, 6) >= 5;", {false, true, true});
+	EidosAssertScriptSuccess_LV("5.0 >= c(4.0, 5.0, 6.0);", {true, true, false});
+	EidosAssertScriptSuccess_L("x = runif(1000); y = asInteger(x * 10); identical(x >= y, sapply(seqAlong(x), 'x[applyValue] >= y[applyValue];'));", true);
+	EidosAssertScriptSuccess_L("identical(integer(0) >= 5.0, logical(0));", true);
+	EidosAssertScriptSuccess_L("identical(5 >= float(0), logical(0));", true);
+	
 	EidosAssertScriptRaise("c(5,6) >= c(5,6,7);", 7, "operator requires that either");
 	
 	// operator >=: test with mixed singletons, vectors, matrices, and arrays; the dimensionality code is shared across all operand types, so testing it with integer should suffice
@@ -405,6 +438,17 @@ void _RunOperatorLtEqTests(void)
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, NAN) <= c(5.0, 5.0, 5.0);", {true, false, false});
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, 8.0) <= c(5.0, 5.0, NAN);", {true, false, false});
 	
+	// operator <=: mixed int/float vector and broadcast operands go through the vectorized comparison kernels
+	EidosAssertScriptSuccess_LV("c(1, 5, 9) <= c(0.5, 5.0, 9.5);", {false, true, true});
+	EidosAssertScriptSuccess_LV("c(0.5, 5.0, 9.5) <= c(1, 5, 9);", {true, true, false});
+	EidosAssertScriptSuccess_LV("5 <= c(4.5, 5.0, NAN);", {false, true, false});
+	EidosAssertScriptSuccess_LV("c(4.5, 5.0, NAN) <= 5;", {true, true, false});
+	EidosAssertScriptSuccess_LV("c(4, 5, 6) <= 5;", {true, true, false});
+	EidosAssertScriptSuccess_LV("5.0 <= c(4.0, 5.0, 6.0);", {false, true, true});
+	EidosAssertScriptSuccess_L("x = runif(1000); y = asInteger(x * 10); identical(x <= y, sapply(seqAlong(x), 'x[applyValue] <= y[applyValue];'));", true);
+	EidosAssertScriptSuccess_L("identical(integer(0) <= 5.0, logical(0));", true);
+	EidosAssertScriptSuccess_L("identical(5 <= float(0), logical(0));", true);
+	
 	EidosAssertScriptRaise("c(5,6) <= c(5,6,7);", 7, "operator requires that either");
 	
 	// operator <=: test with mixed singletons, vectors, matrices, and arrays; the dimensionality code is shared across all operand types, so testing it with integer should suffice
@@ -509,6 +553,17 @@ void _RunOperatorEqTests(void)
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, NAN) == c(5.0, 5.0, 5.0);", {true, false, false});
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, 8.0) == c(5.0, 5.0, NAN);", {true, false, false});
 	
+	// operator ==: mixed int/float vector and broadcast operands go through the vectorized comparison kernels
+	EidosAssertScriptSuccess_LV("c(1, 5, 9) == c(0.5, 5.0, 9.5);", {false, true, false});
+	EidosAssertScriptSuccess_LV("c(0.5, 5.0, 9.5) == c(1, 5, 9);", {false, true, false});
+	EidosAssertScriptSuccess_LV("5 == c(4.5, 5.0, NAN);", {false, true, false});
+	EidosAssertScriptSuccess_LV("c(4.5, 5.0, NAN) == 5;", {false, true, false});
+	EidosAssertScriptSuccess_LV("c(4, 5, 6) == 5;", {false, true, false});
+	EidosAssertScriptSuccess_LV("5.0 == c(4.0, 5.0, 6.0);", {false, true, false});
+	EidosAssertScriptSuccess_L("x = runif(1000); y = asInteger(x * 10); identical(x == y, sapply(seqAlong(x), 'x[applyValue] == y[applyValue];'));", true);
+	EidosAssertScriptSuccess_L("identical(integer(0) == 5.0, logical(0));", true);
+	EidosAssertScriptSuccess_L("identical(5 == float(0), logical(0));", true);
+	
 	EidosAssertScriptRaise("c(5,6) == c(5,6,7);", 7, "operator requires that either");
 	
 	// operator ==: test with mixed singletons, vectors, matrices, and arrays; the dimensionality code is shared across all operand types, so testing it with integer should suffice
@@ -609,6 +664,17 @@ void _RunOperatorNotEqTests(void)
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, NAN) != c(5.0, 5.0, 5.0);", {false, true, true});
 	EidosAssertScriptSuccess_LV("c(5.0, 6.0, 8.0) != c(5.0, 5.0, NAN);", {false, true, true});
 	
+	// operator !=: mixed int/float vector and broadcast operands go through the vectorized comparison kernels
+	EidosAssertScriptSuccess_LV("c(1, 5, 9) != c(0.5, 5.0, 9.5);", {true, false, true});
+	EidosAssertScriptSuccess_LV("c(0.5, 5.0, 9.5) != c(1, 5, 9);", {true, false, true});
+	EidosAssertScriptSuccess_LV("5 != c(4.5, 5.0, NAN);", {true, false, true});
+	EidosAssertScriptSuccess_LV("c(4.5, 5.0, NAN) != 5;", {true, false, true});
+	EidosAssertScriptSuccess_LV("c(4, 5, 6) != 5;", {true, false, true});
+	EidosAssertScriptSuccess_LV("5.0 != c(4.0, 5.0, 6.0);", {true, false, true});
+	EidosAssertScriptSuccess_L("x = runif(1000); y = asInteger(x * 10); identical(x != y, sapply(seqAlong(x), 'x[applyValue] != y[applyValue];'));", true);
+	EidosAssertScriptSuccess_L("identical(integer(0) != 5.0, logical(0));", true);
+	EidosAssertScriptSuccess_L("identical(5 != float(0), logical(0));", true);
+	
 	EidosAssertScriptRaise("c(5,6) != c(5,6,7);", 7, "operator requires that either");
 	
 	// operator !=: test with mixed singletons, vectors, matrices, and arrays; the dimensionality code is shared across all operand types, so testing it with integer should suffice
@@ -319,7 +319,7 @@ int EidosValue::valueTrackingCount;
 std::vector<EidosValue *> EidosValue::valueTrackingVector;
 #endif
 
-EidosValue::EidosValue(EidosValueType p_value_type, bool p_singleton) : intrusive_ref_count_(0), cached_type_(p_value_type), invisible_(false), is_singleton_(p_singleton), dim_(nullptr)
+EidosValue::EidosValue(EidosValueType p_value_type, bool p_singleton) : intrusive_ref_count_(0), cached_type_(p_value_type), invisible_(false), copy_on_write_(false), is_singleton_(p_singleton), dim_(nullptr)
 {
 #ifdef EIDOS_TRACK_VALUE_ALLOCATION
 	valueTrackingCount++;
@@ -1662,7 +1662,9 @@ void EidosValue_Int_vector::PushValueFromIndexOfEidosValue(int p_idx, const Eido
 
 void EidosValue_Int_vector::Sort(bool p_ascending)
 {
-	if (p_ascending)
+	if (count_ >= EIDOS_RADIX_SORT_THRESHOLD)
+		Eidos_RadixSort(values_, count_, p_ascending);
+	else if (p_ascending)
 		std::sort(values_, values_ + count_);
 	else
 		std::sort(values_, values_ + count_, std::greater<int64_t>());
@@ -1672,7 +1674,16 @@ EidosValue_Int_vector *EidosValue_Int_vector::reserve(size_t p_reserved_size)
 {
 	if (p_reserved_size > capacity_)
 	{
-		values_ = (int64_t *)realloc(values_, p_reserved_size * sizeof(int64_t));
+		if (values_ == inline_values_)
+		{
+			// moving out of the inline buffer, so we malloc a buffer and bring along the values we already have
+			values_ = (int64_t *)malloc(p_reserved_size * sizeof(int64_t));
+			if (values_)
+				memcpy(values_, inline_values_, count_ * sizeof(int64_t));
+		}
+		else
+			values_ = (int64_t *)realloc(values_, p_reserved_size * sizeof(int64_t));
+		
 		if (!values_)
 			EIDOS_TERMINATION << "ERROR (EidosValue_Int_vector::reserve): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
 		
@@ -1692,8 +1703,8 @@ EidosValue_Int_vector *EidosValue_Int_vector::resize_no_initialize(size_t p_new_
 
 void EidosValue_Int_vector::expand(void)
 {
-	if (capacity_ == 0)
-		reserve(16);		// if no reserve() call was made, start out with a bit of room
+	if (values_ == inline_values_)
+		reserve(16);		// if we are outgrowing the inline buffer, start out with a bit of room
 	else
 		reserve(capacity_ << 1);
 }
@@ -1956,7 +1967,9 @@ void EidosValue_Float_vector::PushValueFromIndexOfEidosValue(int p_idx, const Ei
 
 void EidosValue_Float_vector::Sort(bool p_ascending)
 {
-	if (p_ascending)
+	if (count_ >= EIDOS_RADIX_SORT_THRESHOLD)
+		Eidos_RadixSort(values_, count_, p_ascending);
+	else if (p_ascending)
 		std::sort(values_, values_ + count_, [](const double& a, const double& b) { return std::isnan(b) || (a < b); });
 	else
 		std::sort(values_, values_ + count_, [](const double& a, const double& b) { return std::isnan(b) || (a > b); });
@@ -1966,7 +1979,16 @@ EidosValue_Float_vector *EidosValue_Float_vector::reserve(size_t p_reserved_size
 {
 	if (p_reserved_size > capacity_)
 	{
-		values_ = (double *)realloc(values_, p_reserved_size * sizeof(double));
+		if (values_ == inline_values_)
+		{
+			// moving out of the inline buffer, so we malloc a buffer and bring along the values we already have
+			values_ = (double *)malloc(p_reserved_size * sizeof(double));
+			if (values_)
+				memcpy(values_, inline_values_, count_ * sizeof(double));
+		}
+		else
+			values_ = (double *)realloc(values_, p_reserved_size * sizeof(double));
+		
 		if (!values_)
 			EIDOS_TERMINATION << "ERROR (EidosValue_Float_vector::reserve): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
 		
@@ -1986,8 +2008,8 @@ EidosValue_Float_vector *EidosValue_Float_vector::resize_no_initialize(size_t p_
 
 void EidosValue_Float_vector::expand(void)
 {
-	if (capacity_ == 0)
-		reserve(16);		// if no reserve() call was made, start out with a bit of room
+	if (values_ == inline_values_)
+		reserve(16);		// if we are outgrowing the inline buffer, start out with a bit of room
 	else
 		reserve(capacity_ << 1);
 }
@@ -2334,7 +2356,8 @@ EidosValue_Object_vector::~EidosValue_Object_vector(void)
 		}
 	}
 	
-	free(values_);
+	if (values_ != inline_values_)
+		free(values_);
 }
 
 int EidosValue_Object_vector::Count_Virtual(void) const
@@ -3159,7 +3182,16 @@ EidosValue_Object_vector *EidosValue_Object_vector::reserve(size_t p_reserved_si
 {
 	if (p_reserved_size > capacity_)
 	{
-		values_ = (EidosObject **)realloc(values_, p_reserved_size * sizeof(EidosObject *));
+		if (values_ == inline_values_)
+		{
+			// moving out of the inline buffer, so we malloc a buffer and bring along the values we already have
+			values_ = (EidosObject **)malloc(p_reserved_size * sizeof(EidosObject *));
+			if (values_)
+				memcpy(values_, inline_values_, count_ * sizeof(EidosObject *));
+		}
+		else
+			values_ = (EidosObject **)realloc(values_, p_reserved_size * sizeof(EidosObject *));
+		
 		if (!values_)
 			EIDOS_TERMINATION << "ERROR (EidosValue_Object_vector::reserve): allocation failed; you may need to raise the memory limit for SLiM." << EidosTerminate(nullptr);
 		
@@ -3211,8 +3243,8 @@ EidosValue_Object_vector *EidosValue_Object_vector::resize_no_initialize_RR(size
 
 void EidosValue_Object_vector::expand(void)
 {
-	if (capacity_ == 0)
-		reserve(16);		// if no reserve() call was made, start out with a bit of room
+	if (values_ == inline_values_)
+		reserve(16);		// if we are outgrowing the inline buffer, start out with a bit of room
 	else
 		reserve(capacity_ << 1);
 }
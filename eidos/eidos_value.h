@@ -148,6 +148,14 @@ bool CompareEidosValues(const EidosValue &p_value1, int p_index1, const EidosVal
 //		C++ compilers *are* super-smart, but only when their optimization level is set high.  In practice,
 //		this means that we see a significant speedup compared to std::vector when running an unoptimized
 //		debugging build, which is a nice benefit for me, albeit with no impact for end users.
+//
+// The integer, float, and object vector classes also keep a few elements in a small inline buffer inside the
+// EidosValue itself, and only malloc a buffer when they outgrow it.  Short vectors (coordinates, parent pairs,
+// small index sets) are very common in callbacks, and this way they live entirely inside the gEidosValuePool
+// chunk for the value, with no malloc/free pair.  The inline capacities are chosen to keep the pool chunk small.
+
+#define EIDOS_VALUE_INLINE_CAPACITY			4		// int64_t / double elements kept inline by EidosValue_Int_vector and EidosValue_Float_vector
+#define EIDOS_VALUE_INLINE_OBJECT_CAPACITY	2		// EidosObject * elements kept inline by EidosValue_Object_vector
 
 class EidosValue
 {
@@ -156,7 +164,8 @@ protected:
 	
 	mutable uint32_t intrusive_ref_count_;					// used by Eidos_intrusive_ptr
 	const EidosValueType cached_type_;						// allows Type() to be an inline function; cached at construction
-	uint8_t invisible_;										// as in R; if true, the value will not normally be printed to the console
+	uint8_t invisible_ : 1;									// as in R; if true, the value will not normally be printed to the console
+	uint8_t copy_on_write_ : 1;								// if true, the value is owned by a symbol table or Dictionary and may be shared between owners; see CopyOnWrite()
 	uint8_t is_singleton_;									// allows Count() and IsSingleton() to be inline; cached at construction
 	uint8_t registered_for_patching_;						// used by EidosValue_Object, otherwise UNINITIALIZED; declared here for reasons of memory packing
 	
@@ -191,6 +200,12 @@ public:
 	inline __attribute__((always_inline)) bool Invisible(void) const							{ return invisible_; }
 	inline __attribute__((always_inline)) void SetInvisible(bool p_invisible)					{ invisible_ = p_invisible; }
 	
+	// copy-on-write sharing; a value stored into a symbol table or Dictionary while uniquely owned gets marked, and from then on it
+	// may be shared by other variables and Dictionary entries without a copy.  Code that modifies a marked value in place must check
+	// for sharing first; see EidosSymbolTable::UnshareValueForSymbol().  Unmarked values follow the old copy rules.
+	inline __attribute__((always_inline)) bool CopyOnWrite(void) const							{ return copy_on_write_; }
+	inline __attribute__((always_inline)) void SetCopyOnWrite(void)								{ copy_on_write_ = true; }
+	
 	// basic subscript access; abstract here since we want to force subclasses to define this
 	virtual EidosValue_SP GetValueAtIndex(const int p_idx, const EidosToken *p_blame_token) const = 0;
 	virtual void SetValueAtIndex(const int p_idx, const EidosValue &p_value, const EidosToken *p_blame_token) = 0;
@@ -707,8 +722,9 @@ private:
 	typedef EidosValue_Int super;
 
 protected:
-	int64_t *values_ = nullptr;
-	size_t count_ = 0, capacity_ = 0;
+	int64_t *values_ = inline_values_;		// points to inline_values_ until the vector outgrows it
+	size_t count_ = 0, capacity_ = EIDOS_VALUE_INLINE_CAPACITY;
+	int64_t inline_values_[EIDOS_VALUE_INLINE_CAPACITY];
 	
 	virtual int Count_Virtual(void) const override;
 	
@@ -723,7 +739,7 @@ public:
 	//explicit EidosValue_Int_vector(int64_t p_int1);		// disabled to encourage use of EidosValue_Int_singleton for this case
 	explicit EidosValue_Int_vector(std::initializer_list<int64_t> p_init_list);
 	explicit EidosValue_Int_vector(const int64_t *p_values, size_t p_count);
-	inline virtual ~EidosValue_Int_vector(void) override { free(values_); }
+	inline virtual ~EidosValue_Int_vector(void) override { if (values_ != inline_values_) free(values_); }
 	
 	virtual const EidosValue_Int_vector *IntVector(void) const override { return this; }
 	virtual EidosValue_Int_vector *IntVector_Mutable(void) override { return this; }
@@ -790,7 +806,7 @@ public:
 	
 	inline __attribute__((always_inline)) int64_t IntValue(void) const { return value_; }
 	inline __attribute__((always_inline)) int64_t &IntValue_Mutable(void) { return value_; }	// very dangerous; used only in Evaluate_Assign()
-	inline __attribute__((always_inline)) void SetValue(int64_t p_int) { value_ = p_int; }		// very dangerous; used only in Evaluate_For()
+	inline __attribute__((always_inline)) void SetValue(int64_t p_int) { value_ = p_int; }		// very dangerous; used only in Evaluate_For() and for scalar temporaries
 	
 	virtual eidos_logical_t LogicalAtIndex(int p_idx, const EidosToken *p_blame_token) const override;
 	virtual std::string StringAtIndex(int p_idx, const EidosToken *p_blame_token) const override;
@@ -856,8 +872,9 @@ private:
 	typedef EidosValue_Float super;
 
 protected:
-	double *values_ = nullptr;
-	size_t count_ = 0, capacity_ = 0;
+	double *values_ = inline_values_;		// points to inline_values_ until the vector outgrows it
+	size_t count_ = 0, capacity_ = EIDOS_VALUE_INLINE_CAPACITY;
+	double inline_values_[EIDOS_VALUE_INLINE_CAPACITY];
 	
 	virtual int Count_Virtual(void) const override;
 	
@@ -870,7 +887,7 @@ public:
 	//explicit EidosValue_Float_vector(double p_float1);		// disabled to encourage use of EidosValue_Float_singleton for this case
 	explicit EidosValue_Float_vector(std::initializer_list<double> p_init_list);
 	explicit EidosValue_Float_vector(const double *p_values, size_t p_count);
-	inline virtual ~EidosValue_Float_vector(void) override { free(values_); }
+	inline virtual ~EidosValue_Float_vector(void) override { if (values_ != inline_values_) free(values_); }
 	
 	virtual const EidosValue_Float_vector *FloatVector(void) const override { return this; }
 	virtual EidosValue_Float_vector *FloatVector_Mutable(void) override { return this; }
@@ -937,7 +954,7 @@ public:
 	
 	inline __attribute__((always_inline)) double FloatValue(void) const { return value_; }
 	inline __attribute__((always_inline)) double &FloatValue_Mutable(void) { return value_; }	// very dangerous; used only in Evaluate_Assign()
-	inline __attribute__((always_inline)) void SetValue(double p_float) { value_ = p_float; }	// very dangerous; used only in Evaluate_For()
+	inline __attribute__((always_inline)) void SetValue(double p_float) { value_ = p_float; }	// very dangerous; used only in Evaluate_For() and for scalar temporaries
 	
 	virtual eidos_logical_t LogicalAtIndex(int p_idx, const EidosToken *p_blame_token) const override;
 	virtual std::string StringAtIndex(int p_idx, const EidosToken *p_blame_token) const override;
@@ -1047,8 +1064,9 @@ private:
 	typedef EidosValue_Object super;
 
 protected:
-	EidosObject **values_ = nullptr;		// these may use a retain/release system of ownership; see below
-	size_t count_ = 0, capacity_ = 0;
+	EidosObject **values_ = inline_values_;		// these may use a retain/release system of ownership; see below
+	size_t count_ = 0, capacity_ = EIDOS_VALUE_INLINE_OBJECT_CAPACITY;
+	EidosObject *inline_values_[EIDOS_VALUE_INLINE_OBJECT_CAPACITY];
 	
 	virtual int Count_Virtual(void) const override;
 	